@@ -18,12 +18,15 @@ namespace CesiumForUnity
         private SerializedProperty _ionAccessToken;
 
         private SerializedProperty _maximumScreenSpaceError;
+        private SerializedProperty _adaptScreenSpaceError;
+        private SerializedProperty _maximumAdaptiveScreenSpaceError;
 
         private SerializedProperty _preloadAncestors;
         private SerializedProperty _preloadSiblings;
         private SerializedProperty _forbidHoles;
         private SerializedProperty _maximumSimultaneousTileLoads;
         private SerializedProperty _maximumCachedBytes;
+        private SerializedProperty _releaseGltfData;
         private SerializedProperty _loadingDescendantLimit;
 
         private SerializedProperty _enableFrustumCulling;
@@ -44,6 +47,10 @@ namespace CesiumForUnity
         private SerializedProperty _logSelectionStats;
 
         private SerializedProperty _createPhysicsMeshes;
+        private SerializedProperty _limitPhysicsMeshesToInterestPoints;
+        private SerializedProperty _simplifyPhysicsMeshes;
+        private SerializedProperty _physicsMeshTriangleRatio;
+        private SerializedProperty _physicsMeshMaximumError;
 
         private void OnEnable()
         {
@@ -59,6 +66,10 @@ namespace CesiumForUnity
 
             this._maximumScreenSpaceError =
                 this.serializedObject.FindProperty("_maximumScreenSpaceError");
+            this._adaptScreenSpaceError =
+                this.serializedObject.FindProperty("_adaptScreenSpaceError");
+            this._maximumAdaptiveScreenSpaceError =
+                this.serializedObject.FindProperty("_maximumAdaptiveScreenSpaceError");
 
             this._preloadAncestors = this.serializedObject.FindProperty("_preloadAncestors");
             this._preloadSiblings = this.serializedObject.FindProperty("_preloadSiblings");
@@ -66,6 +77,7 @@ namespace CesiumForUnity
             this._maximumSimultaneousTileLoads =
                 this.serializedObject.FindProperty("_maximumSimultaneousTileLoads");
             this._maximumCachedBytes = this.serializedObject.FindProperty("_maximumCachedBytes");
+            this._releaseGltfData = this.serializedObject.FindProperty("_releaseGltfData");
             this._loadingDescendantLimit =
                 this.serializedObject.FindProperty("_loadingDescendantLimit");
 
@@ -94,6 +106,14 @@ namespace CesiumForUnity
 
             this._createPhysicsMeshes =
                 this.serializedObject.FindProperty("_createPhysicsMeshes");
+            this._limitPhysicsMeshesToInterestPoints =
+                this.serializedObject.FindProperty("_limitPhysicsMeshesToInterestPoints");
+            this._simplifyPhysicsMeshes =
+                this.serializedObject.FindProperty("_simplifyPhysicsMeshes");
+            this._physicsMeshTriangleRatio =
+                this.serializedObject.FindProperty("_physicsMeshTriangleRatio");
+            this._physicsMeshMaximumError =
+                this.serializedObject.FindProperty("_physicsMeshMaximumError");
         }
 
         public override void OnInspectorGUI()
@@ -233,6 +253,27 @@ namespace CesiumForUnity
                 "terrain of 2.0.");
             EditorGUILayout.PropertyField(
                 this._maximumScreenSpaceError, maximumScreenSpaceErrorContent);
+
+            GUIContent adaptScreenSpaceErrorContent = new GUIContent(
+                "Adapt Screen Space Error",
+                "Whether to raise the screen space error above the maximum while the frame " +
+                "rate is below its target or the tiles use more memory than the maximum " +
+                "cached bytes, and lower it back when there is time and memory to spare." +
+                "\n\n" +
+                "The target frame rate is Application.targetFrameRate, or the platform's " +
+                "default if it isn't set. This only applies in play mode.");
+            EditorGUILayout.PropertyField(
+                this._adaptScreenSpaceError,
+                adaptScreenSpaceErrorContent);
+
+            EditorGUI.BeginDisabledGroup(!this._adaptScreenSpaceError.boolValue);
+            GUIContent maximumAdaptiveScreenSpaceErrorContent = new GUIContent(
+                "Maximum Adaptive Screen Space Error",
+                "The highest screen space error that the error may be raised to.");
+            EditorGUILayout.PropertyField(
+                this._maximumAdaptiveScreenSpaceError,
+                maximumAdaptiveScreenSpaceErrorContent);
+            EditorGUI.EndDisabledGroup();
         }
 
         private void DrawTileLoadingProperties()
@@ -289,9 +330,23 @@ namespace CesiumForUnity
                 "for rendering to be unloaded. However, if the total number of loaded " +
                 "bytes is greater than this value, tiles will be unloaded until the " +
                 "total is under this number or until only required tiles remain, whichever " +
-                "comes first.");
+                "comes first." +
+                "\n\n" +
+                "The loaded bytes include the Unity meshes, textures, materials, and baked " +
+                "physics meshes that are created for the tiles.");
             EditorGUILayout.PropertyField(this._maximumCachedBytes, maximumCachedBytesContent);
 
+            GUIContent releaseGltfDataContent = new GUIContent(
+                "Release glTF Data",
+                "Whether to release the glTF data that each tile is loaded from once the " +
+                "tile's meshes and textures have been created. Only the data needed to look " +
+                "up feature metadata is kept." +
+                "\n\n" +
+                "The data of tiles loaded while the tileset has raster overlays is never " +
+                "released. Leave this off on tilesets that raster overlays will be added to " +
+                "after tiles are loaded.");
+            EditorGUILayout.PropertyField(this._releaseGltfData, releaseGltfDataContent);
+
             GUIContent loadingDescendantLimitContent = new GUIContent(
                 "Loading Descendant Limit",
                 "The number of loading descendents a tile should allow before " +
@@ -535,6 +590,54 @@ namespace CesiumForUnity
                 "\n\n" +
                 "Physics meshes cannot be generated for primitives containing points.");
             EditorGUILayout.PropertyField(this._createPhysicsMeshes, createPhysicsMeshesContent);
+
+            EditorGUI.BeginDisabledGroup(!this._createPhysicsMeshes.boolValue);
+            GUIContent limitPhysicsMeshesToInterestPointsContent = new GUIContent(
+                "Limit To Interest Points",
+                "Whether to only create physics meshes for tiles near a Cesium Physics " +
+                "Interest Point." +
+                "\n\n" +
+                "When enabled, physics meshes are baked lazily, closest tiles first, for " +
+                "rendered tiles within the radius of an enabled interest point, and their " +
+                "colliders are removed again when the tiles leave that radius. Without any " +
+                "interest points, no colliders are created at all.");
+            EditorGUILayout.PropertyField(
+                this._limitPhysicsMeshesToInterestPoints,
+                limitPhysicsMeshesToInterestPointsContent);
+
+            GUIContent simplifyPhysicsMeshesContent = new GUIContent(
+                "Simplify Physics Meshes",
+                "Whether to create simplified copies of tile meshes for physics." +
+                "\n\n" +
+                "When enabled, a coarser mesh is generated for physics in a worker thread, " +
+                "which reduces baking time, physics memory, and the cost of raycasts. The " +
+                "rendered mesh is not affected.");
+            EditorGUILayout.PropertyField(
+                this._simplifyPhysicsMeshes,
+                simplifyPhysicsMeshesContent);
+
+            EditorGUI.BeginDisabledGroup(!this._simplifyPhysicsMeshes.boolValue);
+            GUIContent physicsMeshTriangleRatioContent = new GUIContent(
+                "Triangle Ratio",
+                "The fraction of a tile mesh's triangles to keep when simplifying it for " +
+                "physics." +
+                "\n\n" +
+                "Simplification stops once the mesh has this fraction of its original " +
+                "triangles, or earlier if removing more triangles would exceed the maximum " +
+                "error.");
+            EditorGUILayout.PropertyField(
+                this._physicsMeshTriangleRatio,
+                physicsMeshTriangleRatioContent);
+
+            GUIContent physicsMeshMaximumErrorContent = new GUIContent(
+                "Maximum Error",
+                "The maximum distance, in meters, that a simplified physics mesh may " +
+                "deviate from the rendered mesh.");
+            EditorGUILayout.PropertyField(
+                this._physicsMeshMaximumError,
+                physicsMeshMaximumErrorContent);
+            EditorGUI.EndDisabledGroup();
+            EditorGUI.EndDisabledGroup();
         }
     }
 }
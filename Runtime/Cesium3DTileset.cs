@@ -302,11 +302,18 @@ namespace CesiumForUnity
         /// The maximum number of bytes that may be cached for this tileset.
         /// </summary>
         /// <remarks>
+        /// <para>
         /// Note that this value, even if 0, will never cause tiles that are needed
         /// for rendering to be unloaded. However, if the total number of loaded
         /// bytes is greater than this value, tiles will be unloaded until the
         /// total is under this number or until only required tiles remain, whichever
         /// comes first.
+        /// </para>
+        /// <para>
+        /// The loaded bytes include the Unity meshes, textures, materials, and baked
+        /// physics meshes that are created for the tiles, as well as the glTFs and
+        /// images they are loaded from.
+        /// </para>
         /// </remarks>
         public long maximumCachedBytes
         {
@@ -318,6 +325,36 @@ namespace CesiumForUnity
             }
         }
 
+        [SerializeField]
+        private bool _releaseGltfData = false;
+
+        /// <summary>
+        /// Whether to release the glTF data that each tile is loaded from once the tile's
+        /// meshes and textures have been created.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Otherwise, the vertices, indices, and images of a tile stay in memory for as
+        /// long as the tile is loaded, alongside the meshes and textures created from them.
+        /// Only the data that <see cref="CesiumMetadata"/> needs to look up the features of
+        /// a triangle is kept.
+        /// </para>
+        /// <para>
+        /// Raster overlays are draped over a tileset by upsampling its tiles, so the data of
+        /// tiles loaded while the tileset has raster overlays is never released. Leave this
+        /// false on tilesets that raster overlays will be added to after tiles are loaded.
+        /// </para>
+        /// </remarks>
+        public bool releaseGltfData
+        {
+            get => this._releaseGltfData;
+            set
+            {
+                this._releaseGltfData = value;
+                this.RecreateTileset();
+            }
+        }
+
         [SerializeField]
         private uint _loadingDescendantLimit = 20;
 
@@ -623,6 +660,12 @@ namespace CesiumForUnity
         /// <summary>
         /// Whether to log details about the tile selection process.
         /// </summary>
+        /// <remarks>
+        /// The tileset's own statistics are logged whenever its selection changes. The
+        /// statistics that are shared by all tilesets, such as those of requests, tasks, and
+        /// budgets, are logged separately, at most once every five seconds while any tileset
+        /// has this enabled.
+        /// </remarks>
         public bool logSelectionStats
         {
             get => this._logSelectionStats;
@@ -650,6 +693,161 @@ namespace CesiumForUnity
             }
         }
 
+        [SerializeField]
+        private bool _limitPhysicsMeshesToInterestPoints = false;
+
+        /// <summary>
+        /// Whether to only create physics meshes for tiles near a <see cref="CesiumPhysicsInterestPoint"/>.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// By default, a physics mesh is baked for every loaded tile, including distant, low-detail
+        /// tiles that nothing will ever collide with. When this is true, physics meshes are instead
+        /// baked lazily, closest tiles first, for rendered tiles within the radius of an enabled
+        /// <see cref="CesiumPhysicsInterestPoint"/>, and their colliders are removed again when the
+        /// tiles leave that radius. Without any interest points, no colliders are created at all.
+        /// </para>
+        /// <para>
+        /// This has no effect if <see cref="createPhysicsMeshes"/> is false.
+        /// </para>
+        /// </remarks>
+        public bool limitPhysicsMeshesToInterestPoints
+        {
+            get => this._limitPhysicsMeshesToInterestPoints;
+            set
+            {
+                this._limitPhysicsMeshesToInterestPoints = value;
+                this.RecreateTileset();
+            }
+        }
+
+        [SerializeField]
+        private bool _simplifyPhysicsMeshes = false;
+
+        /// <summary>
+        /// Whether to create simplified copies of tile meshes for physics.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// By default, the physics mesh of a tile is the same mesh that is rendered, so every
+        /// triangle of dense geometry such as photogrammetry must be baked and queried by the
+        /// physics engine. When this is true, a coarser mesh is generated for physics in a worker
+        /// thread, which reduces baking time, physics memory, and the cost of raycasts. The
+        /// rendered mesh is not affected.
+        /// </para>
+        /// <para>
+        /// Vertices on the edges of a tile are never moved, so that there are no gaps between
+        /// the physics meshes of neighboring tiles.
+        /// </para>
+        /// <para>
+        /// This has no effect if <see cref="createPhysicsMeshes"/> is false.
+        /// </para>
+        /// </remarks>
+        public bool simplifyPhysicsMeshes
+        {
+            get => this._simplifyPhysicsMeshes;
+            set
+            {
+                this._simplifyPhysicsMeshes = value;
+                this.RecreateTileset();
+            }
+        }
+
+        [SerializeField]
+        [Range(0.01f, 1.0f)]
+        private float _physicsMeshTriangleRatio = 0.25f;
+
+        /// <summary>
+        /// The fraction of a tile mesh's triangles to keep when simplifying it for physics.
+        /// </summary>
+        /// <remarks>
+        /// Simplification stops once the mesh has this fraction of its original triangles, or
+        /// earlier if removing more triangles would exceed <see cref="physicsMeshMaximumError"/>.
+        /// This has no effect if <see cref="simplifyPhysicsMeshes"/> is false.
+        /// </remarks>
+        public float physicsMeshTriangleRatio
+        {
+            get => this._physicsMeshTriangleRatio;
+            set
+            {
+                this._physicsMeshTriangleRatio = Mathf.Clamp(value, 0.01f, 1.0f);
+                this.RecreateTileset();
+            }
+        }
+
+        [SerializeField]
+        [Min(0.0f)]
+        private float _physicsMeshMaximumError = 0.5f;
+
+        /// <summary>
+        /// The maximum distance, in meters, that a simplified physics mesh may deviate from
+        /// the rendered mesh.
+        /// </summary>
+        /// <remarks>
+        /// This has no effect if <see cref="simplifyPhysicsMeshes"/> is false.
+        /// </remarks>
+        public float physicsMeshMaximumError
+        {
+            get => this._physicsMeshMaximumError;
+            set
+            {
+                this._physicsMeshMaximumError = Mathf.Max(value, 0.0f);
+                this.RecreateTileset();
+            }
+        }
+
+        [SerializeField]
+        private bool _adaptScreenSpaceError = false;
+
+        /// <summary>
+        /// Whether to raise the screen-space error above <see cref="maximumScreenSpaceError"/>
+        /// while the frame rate is below its target or the tiles use more memory than
+        /// <see cref="maximumCachedBytes"/>, and lower it back when there is time and memory to
+        /// spare.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// The target frame rate is <see cref="Application.targetFrameRate"/>, or the platform's
+        /// default if it isn't set. The frame time is smoothed over many frames, and the error is
+        /// only changed again once the previous change has had time to take effect, so that
+        /// brief spikes don't change the level of detail. The error never goes below
+        /// <see cref="maximumScreenSpaceError"/> or above
+        /// <see cref="maximumAdaptiveScreenSpaceError"/>.
+        /// </para>
+        /// <para>
+        /// This only applies in play mode, and can be changed without recreating the tileset.
+        /// </para>
+        /// </remarks>
+        public bool adaptScreenSpaceError
+        {
+            get => this._adaptScreenSpaceError;
+            set
+            {
+                this._adaptScreenSpaceError = value;
+            }
+        }
+
+        [SerializeField]
+        [Min(0.0f)]
+        private float _maximumAdaptiveScreenSpaceError = 64.0f;
+
+        /// <summary>
+        /// The highest screen-space error that <see cref="adaptScreenSpaceError"/> may raise the
+        /// error to.
+        /// </summary>
+        /// <remarks>
+        /// This has no effect if <see cref="adaptScreenSpaceError"/> is false, or if it is lower
+        /// than <see cref="maximumScreenSpaceError"/>.
+        /// </remarks>
+        public float maximumAdaptiveScreenSpaceError
+        {
+            get => this._maximumAdaptiveScreenSpaceError;
+            set
+            {
+                this._maximumAdaptiveScreenSpaceError = Mathf.Max(value, 0.0f);
+            }
+        }
+
         private partial void SetShowCreditsOnScreen(bool value);
 
         private partial void Start();
@@ -0,0 +1,291 @@
+using Reinterop;
+using System;
+using System.Collections.Generic;
+using Unity.Mathematics;
+using UnityEngine;
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// Downloads the tiles of a tileset that would be needed to view a region, or a list of
+    /// positions, into the request cache, so that they can later be loaded without the network,
+    /// such as with <see cref="CesiumCacheMode.CacheOnly"/>.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The tileset is walked by the same tile selection as a <see cref="Cesium3DTileset"/>, from
+    /// cameras looking straight down, but no tiles are rendered. Where a region is given, the
+    /// cameras are spaced so that their views cover it.
+    /// </para>
+    /// <para>
+    /// Which views have been completed is saved as they are, so that seeding the same region
+    /// again after it was stopped, or Unity was closed, continues where it left off.
+    /// </para>
+    /// </remarks>
+    [ReinteropNativeImplementation("CesiumForUnityNative::CesiumCacheSeederImpl", "CesiumCacheSeederImpl.h")]
+    [AddComponentMenu("Cesium/Cesium Cache Seeder")]
+    [IconAttribute("Packages/com.cesium.unity/Editor/Resources/Cesium-24x24.png")]
+    public partial class CesiumCacheSeeder : MonoBehaviour
+    {
+        [SerializeField]
+        private CesiumDataSource _tilesetSource = CesiumDataSource.FromCesiumIon;
+
+        /// <summary>
+        /// The source of the tileset to seed: Cesium ion or a regular URL.
+        /// </summary>
+        public CesiumDataSource tilesetSource
+        {
+            get => this._tilesetSource;
+            set => this._tilesetSource = value;
+        }
+
+        [SerializeField]
+        private string _url = "";
+
+        /// <summary>
+        /// The URL of the tileset. This property is used only if <see cref="tilesetSource"/> is
+        /// set to "FromUrl".
+        /// </summary>
+        public string url
+        {
+            get => this._url;
+            set => this._url = value;
+        }
+
+        [SerializeField]
+        private long _ionAssetID = 0;
+
+        /// <summary>
+        /// The ID of the Cesium ion asset. This property is used only if
+        /// <see cref="tilesetSource"/> is set to "FromCesiumIon".
+        /// </summary>
+        public long ionAssetID
+        {
+            get => this._ionAssetID;
+            set => this._ionAssetID = value;
+        }
+
+        [SerializeField]
+        private string _ionAccessToken = "";
+
+        /// <summary>
+        /// The access token to use for Cesium ion assets. If empty, the default token is used.
+        /// </summary>
+        public string ionAccessToken
+        {
+            get => this._ionAccessToken;
+            set => this._ionAccessToken = value;
+        }
+
+        [SerializeField]
+        private long _rasterOverlayIonAssetID = 0;
+
+        /// <summary>
+        /// The ID of a Cesium ion imagery asset to seed along with the tileset, or 0 to seed the
+        /// tileset alone.
+        /// </summary>
+        public long rasterOverlayIonAssetID
+        {
+            get => this._rasterOverlayIonAssetID;
+            set => this._rasterOverlayIonAssetID = value;
+        }
+
+        [SerializeField]
+        private double _west = 0.0;
+
+        /// <summary>
+        /// The westernmost longitude of the region to seed, in degrees.
+        /// </summary>
+        public double west
+        {
+            get => this._west;
+            set => this._west = value;
+        }
+
+        [SerializeField]
+        private double _south = 0.0;
+
+        /// <summary>
+        /// The southernmost latitude of the region to seed, in degrees.
+        /// </summary>
+        public double south
+        {
+            get => this._south;
+            set => this._south = value;
+        }
+
+        [SerializeField]
+        private double _east = 0.0;
+
+        /// <summary>
+        /// The easternmost longitude of the region to seed, in degrees.
+        /// </summary>
+        public double east
+        {
+            get => this._east;
+            set => this._east = value;
+        }
+
+        [SerializeField]
+        private double _north = 0.0;
+
+        /// <summary>
+        /// The northernmost latitude of the region to seed, in degrees.
+        /// </summary>
+        public double north
+        {
+            get => this._north;
+            set => this._north = value;
+        }
+
+        [SerializeField]
+        [Min(1.0f)]
+        private double _viewHeight = 1000.0;
+
+        /// <summary>
+        /// The height above the WGS84 ellipsoid, in meters, of the cameras that view the
+        /// region. Lower cameras need more detailed tiles, and more of them to cover the region.
+        /// </summary>
+        public double viewHeight
+        {
+            get => this._viewHeight;
+            set => this._viewHeight = Math.Max(value, 1.0);
+        }
+
+        [SerializeField]
+        private List<double3> _viewPositions = new List<double3>();
+
+        /// <summary>
+        /// The positions of cameras to seed the tiles for, as longitude and latitude in degrees
+        /// and height above the WGS84 ellipsoid in meters. When this isn't empty, it is used
+        /// instead of the region.
+        /// </summary>
+        public List<double3> viewPositions
+        {
+            get => this._viewPositions;
+            set => this._viewPositions = value;
+        }
+
+        [SerializeField]
+        [Min(0.0f)]
+        private float _maximumScreenSpaceError = 16.0f;
+
+        /// <summary>
+        /// The maximum screen-space error to seed the tiles for. This should be no more than the
+        /// <see cref="Cesium3DTileset.maximumScreenSpaceError"/> of the tileset that will use
+        /// the cache.
+        /// </summary>
+        public float maximumScreenSpaceError
+        {
+            get => this._maximumScreenSpaceError;
+            set => this._maximumScreenSpaceError = Mathf.Max(value, 0.0f);
+        }
+
+        [SerializeField]
+        [Min(1)]
+        private int _viewportWidth = 1920;
+
+        /// <summary>
+        /// The width, in pixels, of the viewport that the tiles are seeded for.
+        /// </summary>
+        public int viewportWidth
+        {
+            get => this._viewportWidth;
+            set => this._viewportWidth = Math.Max(value, 1);
+        }
+
+        [SerializeField]
+        [Min(1)]
+        private int _viewportHeight = 1080;
+
+        /// <summary>
+        /// The height, in pixels, of the viewport that the tiles are seeded for.
+        /// </summary>
+        public int viewportHeight
+        {
+            get => this._viewportHeight;
+            set => this._viewportHeight = Math.Max(value, 1);
+        }
+
+        [SerializeField]
+        [Range(1.0f, 179.0f)]
+        private float _fieldOfView = 60.0f;
+
+        /// <summary>
+        /// The vertical field of view, in degrees, of the cameras that the tiles are seeded for.
+        /// </summary>
+        public float fieldOfView
+        {
+            get => this._fieldOfView;
+            set => this._fieldOfView = Mathf.Clamp(value, 1.0f, 179.0f);
+        }
+
+        /// <summary>
+        /// Whether tiles are currently being seeded.
+        /// </summary>
+        public bool isSeeding
+        {
+            get => this.IsSeeding();
+        }
+
+        /// <summary>
+        /// How much of the seeding has been completed, from 0 to 100.
+        /// </summary>
+        public float progress
+        {
+            get => this.GetProgress();
+        }
+
+        /// <summary>
+        /// An event that is raised when seeding finishes or is stopped.
+        /// </summary>
+        public event Action<CesiumCacheSeeder> OnSeedingComplete;
+
+        private bool _wasSeeding = false;
+
+        private void Update()
+        {
+            if (!this._wasSeeding)
+            {
+                return;
+            }
+
+            this.UpdateSeeding();
+
+            if (!this.IsSeeding())
+            {
+                this._wasSeeding = false;
+                if (this.OnSeedingComplete != null)
+                {
+                    this.OnSeedingComplete(this);
+                }
+            }
+        }
+
+        private void OnDisable()
+        {
+            this.StopSeeding();
+        }
+
+        /// <summary>
+        /// Starts seeding the cache, continuing from where an earlier run with the same
+        /// settings left off. Any seeding that is already in progress is stopped first.
+        /// </summary>
+        public void StartSeeding()
+        {
+            this.BeginSeeding();
+            this._wasSeeding = this.IsSeeding();
+        }
+
+        /// <summary>
+        /// Stops seeding the cache. Seeding can later be continued by calling
+        /// <see cref="StartSeeding"/>.
+        /// </summary>
+        public partial void StopSeeding();
+
+        private partial void BeginSeeding();
+        private partial void UpdateSeeding();
+        private partial bool IsSeeding();
+        private partial float GetProgress();
+    }
+}
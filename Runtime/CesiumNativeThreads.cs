@@ -0,0 +1,44 @@
+using Reinterop;
+using UnityEngine;
+
+#if UNITY_EDITOR
+using UnityEditor;
+#endif
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// Stops the native threads that are shared by all tilesets before the code that they call
+    /// into goes away.
+    /// </summary>
+    /// <remarks>
+    /// The native HTTP client, the native task processor, and the disk cache each run threads of
+    /// their own, which outlive a domain reload in the Editor because the native library stays
+    /// loaded. They are stopped before each assembly reload and when the application quits,
+    /// after finishing the work that they already have. They are started again the next time a
+    /// tileset needs them.
+    /// </remarks>
+    [ReinteropNativeImplementation("CesiumForUnityNative::CesiumNativeThreadsImpl", "CesiumNativeThreadsImpl.h", staticOnly: true)]
+    internal static partial class CesiumNativeThreads
+    {
+#if UNITY_EDITOR
+        [InitializeOnLoadMethod]
+        private static void RegisterShutdown()
+        {
+            AssemblyReloadEvents.beforeAssemblyReload -= Shutdown;
+            AssemblyReloadEvents.beforeAssemblyReload += Shutdown;
+            EditorApplication.quitting -= Shutdown;
+            EditorApplication.quitting += Shutdown;
+        }
+#else
+        [RuntimeInitializeOnLoadMethod(RuntimeInitializeLoadType.SubsystemRegistration)]
+        private static void RegisterShutdown()
+        {
+            Application.quitting -= Shutdown;
+            Application.quitting += Shutdown;
+        }
+#endif
+
+        private static partial void Shutdown();
+    }
+}
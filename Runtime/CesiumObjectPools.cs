@@ -8,9 +8,23 @@ namespace CesiumForUnity
 {
     internal class CesiumObjectPools
     {
-        public static CesiumObjectPool<Mesh> MeshPool => _meshPool;
+        /// <summary>
+        /// The pool of tile meshes. Meshes are pooled by a size class that is
+        /// chosen by the native code that fills them, and keep their vertex
+        /// and index buffers while pooled, so that a mesh gotten for a tile of
+        /// the same size class already has buffers of the right size. Meshes
+        /// with size class 0 aren't sized, and are cleared when released.
+        /// The pooled meshes are kept within <see cref="MeshPoolMaximumBytes"/>,
+        /// which counts against the tile memory budget.
+        /// </summary>
+        public static CesiumSizeClassPool<Mesh> MeshPool => _meshPool;
 
-        private static CesiumObjectPool<Mesh> _meshPool;
+        /// <summary>
+        /// The most memory that the meshes in the mesh pool may keep, in bytes.
+        /// </summary>
+        public const long MeshPoolMaximumBytes = 64 * 1024 * 1024;
+
+        private static CesiumSizeClassPool<Mesh> _meshPool;
 
         public static void Dispose()
         {
@@ -19,10 +33,15 @@ namespace CesiumForUnity
 
         static CesiumObjectPools()
         {
-            _meshPool = new CesiumObjectPool<Mesh>(
+            _meshPool = new CesiumSizeClassPool<Mesh>(
                 () => new Mesh(),
-                (mesh) => mesh.Clear(),
-                (mesh) => UnityLifetime.Destroy(mesh));
+                (mesh, sizeClass) =>
+                {
+                    if (sizeClass == 0)
+                        mesh.Clear();
+                },
+                (mesh) => UnityLifetime.Destroy(mesh),
+                MeshPoolMaximumBytes);
 
 #if UNITY_EDITOR
             EditorApplication.playModeStateChanged += OnPlayModeStateChanged;
@@ -0,0 +1,58 @@
+using System.Collections.Generic;
+using UnityEngine;
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// Marks a game object, such as a player or a vehicle, around which tilesets should
+    /// create physics colliders.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// This component only has an effect on tilesets with
+    /// <see cref="Cesium3DTileset.limitPhysicsMeshesToInterestPoints"/> enabled. Those tilesets
+    /// only bake physics meshes and attach colliders for rendered tiles that are within
+    /// <see cref="radius"/> of at least one enabled interest point, and remove the colliders
+    /// again when the tiles leave that radius.
+    /// </para>
+    /// </remarks>
+    [ExecuteInEditMode]
+    [AddComponentMenu("Cesium/Cesium Physics Interest Point")]
+    [IconAttribute("Packages/com.cesium.unity/Editor/Resources/Cesium-24x24.png")]
+    public class CesiumPhysicsInterestPoint : MonoBehaviour
+    {
+        private static List<CesiumPhysicsInterestPoint> _interestPoints =
+            new List<CesiumPhysicsInterestPoint>();
+
+        /// <summary>
+        /// All currently enabled interest points.
+        /// </summary>
+        internal static List<CesiumPhysicsInterestPoint> interestPoints
+        {
+            get => _interestPoints;
+        }
+
+        [SerializeField]
+        [Min(0.0f)]
+        private float _radius = 1000.0f;
+
+        /// <summary>
+        /// The distance in meters from this object within which tiles get physics colliders.
+        /// </summary>
+        public float radius
+        {
+            get => this._radius;
+            set => this._radius = Mathf.Max(value, 0.0f);
+        }
+
+        void OnEnable()
+        {
+            _interestPoints.Add(this);
+        }
+
+        void OnDisable()
+        {
+            _interestPoints.Remove(this);
+        }
+    }
+}
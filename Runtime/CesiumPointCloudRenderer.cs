@@ -43,6 +43,18 @@ namespace CesiumForUnity
         }
 
         void OnEnable()
+        {
+            // Tiles are shown and hidden by activating and deactivating their
+            // GameObjects, so this is called every time the tile reappears. The
+            // GPU resources are kept across enable / disable cycles and only
+            // created the first time, so that re-showing a tile is cheap.
+            if (this._pointMaterial == null)
+            {
+                this.CreateResources();
+            }
+        }
+
+        private void CreateResources()
         {
             this._tileset = this.gameObject.GetComponentInParent<Cesium3DTileset>();
 
@@ -103,6 +115,12 @@ namespace CesiumForUnity
             {
                 this._pointMaterial.EnableKeyword("INSTANCING_ON");
             }
+
+#if UNITY_EDITOR
+            // A domain reload forgets the resources without destroying this
+            // component, even while its tile is hidden, so release them first.
+            AssemblyReloadEvents.beforeAssemblyReload += this.DestroyResources;
+#endif
         }
 
         private float GetGeometricError(CesiumPointCloudShading pointCloudShading)
@@ -172,6 +190,10 @@ namespace CesiumForUnity
 
         private void DestroyResources()
         {
+#if UNITY_EDITOR
+            AssemblyReloadEvents.beforeAssemblyReload -= this.DestroyResources;
+#endif
+
             if (this._meshVertexBuffer != null)
             {
                 this._meshVertexBuffer.Release();
@@ -180,13 +202,15 @@ namespace CesiumForUnity
 
             if (this._pointMaterial != null)
             {
+                Material pointMaterial = this._pointMaterial;
+                this._pointMaterial = null;
 #if UNITY_EDITOR
             if (!EditorApplication.isPlaying) {
-                DestroyImmediate(this._pointMaterial);
+                DestroyImmediate(pointMaterial);
                 return;
             }
 #endif
-                Destroy(this._pointMaterial);
+                Destroy(pointMaterial);
             }
         }
 
@@ -239,6 +263,17 @@ namespace CesiumForUnity
         }
 
         void OnDisable()
+        {
+            // Hiding a tile deactivates the tile's GameObject, which is this
+            // one's parent. Otherwise, this component itself is being disabled,
+            // so it won't be shown again without being enabled first.
+            if (this.gameObject.activeInHierarchy)
+            {
+                this.DestroyResources();
+            }
+        }
+
+        void OnDestroy()
         {
             this.DestroyResources();
         }
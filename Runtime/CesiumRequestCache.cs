@@ -0,0 +1,53 @@
+using Reinterop;
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// How tile requests use the disk cache and the network.
+    /// </summary>
+    public enum CesiumCacheMode
+    {
+        /// <summary>
+        /// Requests go to the network whenever the cached response is missing or stale. If the
+        /// network request fails, a stale cached response is used instead, if there is one.
+        /// </summary>
+        NetworkFirst,
+
+        /// <summary>
+        /// Cached responses are used immediately, even when stale, so cached tiles load at disk
+        /// speed. Stale responses are refreshed from the network in the background for the next
+        /// time they are needed. Responses that are not cached are requested from the network.
+        /// </summary>
+        StaleWhileRevalidate,
+
+        /// <summary>
+        /// Requests never go to the network. Responses that are not cached fail with HTTP
+        /// status 504.
+        /// </summary>
+        CacheOnly
+    }
+
+    /// <summary>
+    /// Controls the cache of responses to the requests made by all tilesets and raster overlays.
+    /// </summary>
+    [ReinteropNativeImplementation("CesiumForUnityNative::CesiumRequestCacheImpl", "CesiumRequestCacheImpl.h", staticOnly: true)]
+    public static partial class CesiumRequestCache
+    {
+        /// <summary>
+        /// Gets or sets how requests use the disk cache and the network.
+        /// </summary>
+        /// <remarks>
+        /// This starts out as <see cref="CesiumRuntimeSettings.cacheMode"/>, and can be changed
+        /// at any time, for example when connectivity is lost or regained. Requests that are
+        /// already in progress are not affected.
+        /// </remarks>
+        public static CesiumCacheMode mode
+        {
+            get => GetMode();
+            set => SetMode(value);
+        }
+
+        private static partial CesiumCacheMode GetMode();
+        private static partial void SetMode(CesiumCacheMode mode);
+    }
+}
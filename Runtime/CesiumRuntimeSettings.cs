@@ -6,6 +6,47 @@ using UnityEditor;
 
 namespace CesiumForUnity
 {
+    /// <summary>
+    /// The database used to cache downloaded tiles on disk.
+    /// </summary>
+    public enum CesiumCacheBackend
+    {
+        /// <summary>
+        /// A single SQLite database, pruned to a maximum number of items.
+        /// </summary>
+        Sqlite,
+
+        /// <summary>
+        /// A directory with one file per cached response, pruned to a maximum number of bytes.
+        /// Reads are memory-mapped and writes happen on a background thread, so it is cheaper
+        /// than SQLite when many tiles are streamed.
+        /// </summary>
+        Files
+    }
+
+    /// <summary>
+    /// Whether tile requests are recorded to, or replayed from, a request archive.
+    /// </summary>
+    public enum CesiumRequestArchiveMode
+    {
+        /// <summary>
+        /// Requests are neither recorded nor replayed.
+        /// </summary>
+        Off,
+
+        /// <summary>
+        /// Every response received by a tileset or raster overlay is recorded to the archive,
+        /// replacing anything that was recorded before.
+        /// </summary>
+        Record,
+
+        /// <summary>
+        /// Requests are answered from the archive instead of the network, with an empty disk cache
+        /// of their own, so that tile streaming can be benchmarked reproducibly without a network.
+        /// </summary>
+        Replay
+    }
+
     /// <summary>
     /// Holds Cesium settings used at runtime.
     /// </summary>
@@ -180,5 +221,312 @@ namespace CesiumForUnity
         {
             get => instance._maxItems;
         }
+
+        [SerializeField]
+        [Tooltip("The database used to cache downloaded tiles on disk. Must restart Unity to apply changes.")]
+        private CesiumCacheBackend _cacheBackend = CesiumCacheBackend.Sqlite;
+
+        /// <summary>
+        /// The database used to cache downloaded tiles on disk.
+        /// </summary>
+        public static CesiumCacheBackend cacheBackend
+        {
+            get => instance._cacheBackend;
+        }
+
+        [SerializeField]
+        [Tooltip("The maximum number of bytes the file cache may use on disk before the least recently used items are evicted. Must restart Unity to apply changes.")]
+        [Min(0)]
+        private long _fileCacheMaximumBytes = 1024L * 1024L * 1024L;
+
+        /// <summary>
+        /// The maximum number of bytes the file cache may use on disk before the least recently
+        /// used items are evicted.
+        /// </summary>
+        /// <remarks>
+        /// This has no effect unless <see cref="cacheBackend"/> is <see cref="CesiumCacheBackend.Files"/>.
+        /// </remarks>
+        public static long fileCacheMaximumBytes
+        {
+            get => instance._fileCacheMaximumBytes;
+        }
+
+        [SerializeField]
+        [Tooltip("How tile requests use the disk cache and the network when the application starts. This can be changed while running with CesiumRequestCache.mode.")]
+        private CesiumCacheMode _cacheMode = CesiumCacheMode.NetworkFirst;
+
+        /// <summary>
+        /// How tile requests use the disk cache and the network when the application starts.
+        /// </summary>
+        /// <remarks>
+        /// Use <see cref="CesiumRequestCache.mode"/> to change the mode while running.
+        /// </remarks>
+        public static CesiumCacheMode cacheMode
+        {
+            get => instance._cacheMode;
+        }
+
+        [SerializeField]
+        [Tooltip("The maximum number of bytes of recently downloaded responses to keep in memory, in front of the disk cache. Set this to 0 to turn the memory cache off. Must restart Unity to apply changes.")]
+        [Min(0)]
+        private long _memoryCacheMaximumBytes = 64L * 1024L * 1024L;
+
+        /// <summary>
+        /// The maximum number of bytes of recently downloaded responses to keep in memory, in
+        /// front of the disk cache.
+        /// </summary>
+        /// <remarks>
+        /// Tiles that are unloaded and then needed again, as often happens when orbiting, can
+        /// be reloaded from memory without reading them from the disk cache. Set this to 0 to
+        /// turn the memory cache off.
+        /// </remarks>
+        public static long memoryCacheMaximumBytes
+        {
+            get => instance._memoryCacheMaximumBytes;
+        }
+
+        [SerializeField]
+        [Tooltip("Whether to compress responses before storing them in the disk cache. Responses that are already compressed, such as images, are stored as they are. Must restart Unity to apply changes.")]
+        private bool _compressCacheEntries = true;
+
+        /// <summary>
+        /// Whether to compress responses before storing them in the disk cache.
+        /// </summary>
+        /// <remarks>
+        /// Tiles that were not compressed by the server, such as most glTF and JSON tiles, take
+        /// several times less space on disk when compressed, at the cost of inflating them again
+        /// when they are read. Responses that are already compressed, such as images, are stored
+        /// as they are.
+        /// </remarks>
+        public static bool compressCacheEntries
+        {
+            get => instance._compressCacheEntries;
+        }
+
+        [SerializeField]
+        [Tooltip("Whether tile requests are recorded to, or replayed from, a request archive, for reproducible benchmarks without a network. Must restart Unity to apply changes.")]
+        private CesiumRequestArchiveMode _requestArchiveMode = CesiumRequestArchiveMode.Off;
+
+        /// <summary>
+        /// Whether tile requests are recorded to, or replayed from, a request archive.
+        /// </summary>
+        /// <remarks>
+        /// Record a session once with <see cref="CesiumRequestArchiveMode.Record"/>, and then
+        /// replay it any number of times with <see cref="CesiumRequestArchiveMode.Replay"/>,
+        /// without a network and with the same responses every time.
+        /// </remarks>
+        public static CesiumRequestArchiveMode requestArchiveMode
+        {
+            get => instance._requestArchiveMode;
+        }
+
+        [SerializeField]
+        [Tooltip("The path of the request archive to record to or replay from. If empty, a file in the application's temporary cache directory is used. Must restart Unity to apply changes.")]
+        private string _requestArchivePath = "";
+
+        /// <summary>
+        /// The path of the request archive to record to or replay from. If empty, a file in
+        /// <see cref="Application.temporaryCachePath"/> is used.
+        /// </summary>
+        public static string requestArchivePath
+        {
+            get => instance._requestArchivePath;
+        }
+
+        [SerializeField]
+        [Tooltip("When replaying a request archive, how long to wait before each response starts to arrive, in milliseconds. Must restart Unity to apply changes.")]
+        [Min(0)]
+        private int _replayLatencyMilliseconds = 0;
+
+        /// <summary>
+        /// When replaying a request archive, how long to wait before each response starts to
+        /// arrive, in milliseconds.
+        /// </summary>
+        public static int replayLatencyMilliseconds
+        {
+            get => instance._replayLatencyMilliseconds;
+        }
+
+        [SerializeField]
+        [Tooltip("When replaying a request archive, the bandwidth shared by all responses, in bytes per second. Set this to 0 for no limit. Must restart Unity to apply changes.")]
+        [Min(0)]
+        private long _replayBytesPerSecond = 0;
+
+        /// <summary>
+        /// When replaying a request archive, the bandwidth shared by all responses, in bytes per
+        /// second. Set this to 0 for no limit.
+        /// </summary>
+        public static long replayBytesPerSecond
+        {
+            get => instance._replayBytesPerSecond;
+        }
+
+        [SerializeField]
+        [Tooltip("Whether to download tiles with a native HTTP client running on background threads, instead of with UnityWebRequest. HTTPS requests still use UnityWebRequest unless the native client was built with TLS support. Must restart Unity to apply changes.")]
+        private bool _useNativeHttpClient = false;
+
+        /// <summary>
+        /// Whether to download tiles with a native HTTP client running on background threads,
+        /// instead of with UnityWebRequest.
+        /// </summary>
+        /// <remarks>
+        /// UnityWebRequest must be started from the main thread, and its completion is reported
+        /// on the main thread, so each request costs main thread time and at least a frame of
+        /// latency. The native client avoids the main thread entirely and keeps connections
+        /// alive between requests. HTTPS requests still use UnityWebRequest unless the native
+        /// client was built with TLS support.
+        /// </remarks>
+        public static bool useNativeHttpClient
+        {
+            get => instance._useNativeHttpClient;
+        }
+
+        [SerializeField]
+        [Tooltip("The maximum number of simultaneous connections the native HTTP client makes to each host. Must restart Unity to apply changes.")]
+        [Min(1)]
+        private int _maximumConnectionsPerHost = 6;
+
+        /// <summary>
+        /// The maximum number of simultaneous connections the native HTTP client makes to each
+        /// host.
+        /// </summary>
+        /// <remarks>
+        /// This has no effect unless <see cref="useNativeHttpClient"/> is true.
+        /// </remarks>
+        public static int maximumConnectionsPerHost
+        {
+            get => instance._maximumConnectionsPerHost;
+        }
+
+        [SerializeField]
+        [Tooltip("Experimental. Whether to run background work, such as parsing tiles and creating their meshes, on a native thread pool instead of the .NET thread pool. It has not yet been shown to load tiles faster than the .NET thread pool, so compare the two in your own scenes before relying on it. Must restart Unity to apply changes.")]
+        private bool _useNativeTaskProcessor = false;
+
+        /// <summary>
+        /// Whether to run background work, such as parsing tiles and creating their meshes, on
+        /// a native work-stealing thread pool instead of the .NET thread pool.
+        /// </summary>
+        /// <remarks>
+        /// Starting a task on the .NET thread pool allocates a managed delegate for it, and the
+        /// task competes with the application's own tasks for the pool's threads. The native
+        /// pool has threads of its own, and runs the tasks that a task starts on the same
+        /// thread where possible.
+        ///
+        /// This is experimental, and is off by default. It has not yet been measured against the
+        /// .NET thread pool, so it may be slower in some scenes. To compare the two, load the same
+        /// scene with each, and compare frame times and the worker task statistics that
+        /// <see cref="Cesium3DTileset.logSelectionStats"/> reports.
+        /// </remarks>
+        public static bool useNativeTaskProcessor
+        {
+            get => instance._useNativeTaskProcessor;
+        }
+
+        [SerializeField]
+        [Tooltip("The number of threads in the native thread pool, or 0 to use one fewer than the number of hardware threads. Must restart Unity to apply changes.")]
+        [Min(0)]
+        private int _workerThreadCount = 0;
+
+        /// <summary>
+        /// The number of threads in the native thread pool. If 0, one fewer than the number of
+        /// hardware threads is used, leaving one for the main thread.
+        /// </summary>
+        /// <remarks>
+        /// This has no effect unless <see cref="useNativeTaskProcessor"/> is true.
+        /// </remarks>
+        public static int workerThreadCount
+        {
+            get => instance._workerThreadCount;
+        }
+
+        [SerializeField]
+        [Tooltip("Whether to pin each thread of the native thread pool to its own core. Only supported on Windows, Linux and Android. Must restart Unity to apply changes.")]
+        private bool _pinWorkerThreads = false;
+
+        /// <summary>
+        /// Whether to pin each thread of the native thread pool to its own core, which keeps the
+        /// operating system from moving it between cores. This is only supported on Windows,
+        /// Linux and Android.
+        /// </summary>
+        /// <remarks>
+        /// This has no effect unless <see cref="useNativeTaskProcessor"/> is true.
+        /// </remarks>
+        public static bool pinWorkerThreads
+        {
+            get => instance._pinWorkerThreads;
+        }
+
+        [SerializeField]
+        [Tooltip("The maximum time, in milliseconds, that all tilesets together spend each frame on the main thread part of loading tiles, such as creating their meshes. At least one task is done in each frame regardless. If 0, there is no limit. This is ignored when the main thread budget is adaptive, which sets the limit instead.")]
+        [Min(0)]
+        private float _mainThreadTaskTimeLimit = 5.0f;
+
+        /// <summary>
+        /// The maximum time, in milliseconds, that all tilesets together spend each frame on the
+        /// main thread part of loading tiles, such as creating their meshes. If 0, there is no
+        /// limit.
+        /// </summary>
+        /// <remarks>
+        /// This work is queued across tilesets, and the work of tilesets that are in view is done
+        /// before the work of those that are not. At least one task is done in each frame, so the
+        /// queue always makes progress. When <see cref="useAdaptiveMainThreadBudget"/> is
+        /// enabled, this is ignored, and the work comes out of each tileset's share of the
+        /// adaptive budget instead.
+        /// </remarks>
+        public static float mainThreadTaskTimeLimit
+        {
+            get => instance._mainThreadTaskTimeLimit;
+        }
+
+        [SerializeField]
+        [Tooltip("Whether the time that tilesets spend each frame loading and unloading tiles on the main thread is shared by all tilesets and adapted to keep the frame rate on target, rather than fixed at 5 milliseconds per tileset.")]
+        private bool _useAdaptiveMainThreadBudget = true;
+
+        /// <summary>
+        /// Whether the time that tilesets spend each frame loading and unloading tiles on the
+        /// main thread is shared by all tilesets and adapted to keep the frame rate on target,
+        /// rather than fixed at 5 milliseconds per tileset.
+        /// </summary>
+        /// <remarks>
+        /// The target frame rate is <see cref="Application.targetFrameRate"/>, or the platform's
+        /// default if it isn't set. The shared budget grows while frames are on time and tiles
+        /// are waiting for the main thread, and shrinks when frames are late. Each tileset's
+        /// share is in proportion to the number of tiles it is loading. This only applies in
+        /// play mode.
+        /// </remarks>
+        public static bool useAdaptiveMainThreadBudget
+        {
+            get => instance._useAdaptiveMainThreadBudget;
+        }
+
+        [SerializeField]
+        [Tooltip("The most memory, in bytes, that the tiles and raster overlay tiles of all tilesets together may use, or 0 for no limit. Each tileset still uses no more than its own Maximum Cached Bytes.")]
+        [Min(0)]
+        private long _tileMemoryBudgetBytes = 0;
+
+        /// <summary>
+        /// The most memory, in bytes, that the tiles and raster overlay tiles of all tilesets
+        /// together may use. If 0, each tileset is only limited by its own
+        /// <see cref="Cesium3DTileset.maximumCachedBytes"/>.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Each tileset's share of the budget is in proportion to its priority, up to its own
+        /// maximum. While the tilesets are under budget, they may grow beyond their shares into
+        /// what the others aren't using. Once they are over, every tileset is cut back to its
+        /// share, so cached tiles are unloaded from the lowest priority tilesets first. A
+        /// tileset's priority grows with the number of tiles it renders, and shrinks with the
+        /// time since it last rendered any. The caches of raster overlays shrink along with their
+        /// tilesets'.
+        /// </para>
+        /// <para>
+        /// Tiles that are being rendered are never unloaded, so the budget can be exceeded when
+        /// the tiles in view alone need more. This only applies in play mode.
+        /// </para>
+        /// </remarks>
+        public static long tileMemoryBudgetBytes
+        {
+            get => instance._tileMemoryBudgetBytes;
+        }
     }
 }
@@ -0,0 +1,151 @@
+using System;
+using System.Collections.Generic;
+
+namespace CesiumForUnity
+{
+    /// <summary>
+    /// A pool of objects that are sorted into size classes, so that an object
+    /// is only reused for another of the same size class.
+    /// </summary>
+    /// <remarks>
+    /// The size class of an object is chosen by the code that uses the pool,
+    /// which must release an object with the size class that it was gotten
+    /// with, along with the memory that the object keeps while it's pooled.
+    /// When the pooled objects would take more than the pool's maximum bytes,
+    /// the objects that were released longest ago are destroyed to make room,
+    /// whatever their size class.
+    /// </remarks>
+    internal class CesiumSizeClassPool<T> : IDisposable where T : class
+    {
+        private struct Entry
+        {
+            public T element;
+            public int sizeClass;
+            public long bytes;
+        }
+
+        private Dictionary<int, List<LinkedListNode<Entry>>> _pool;
+        private LinkedList<Entry> _releaseOrder;
+        private long _maximumBytes;
+        private Func<T> _createCallback;
+        private Action<T, int> _releaseCallback;
+        private Action<T> _destroyCallback;
+
+        public CesiumSizeClassPool(Func<T> createCallback, Action<T, int> releaseCallback, Action<T> destroyCallback, long maximumBytes)
+        {
+            this._pool = new Dictionary<int, List<LinkedListNode<Entry>>>();
+            this._releaseOrder = new LinkedList<Entry>();
+            this._maximumBytes = maximumBytes;
+            this._createCallback = createCallback;
+            this._releaseCallback = releaseCallback;
+            this._destroyCallback = destroyCallback;
+        }
+
+        public void Dispose()
+        {
+            this.Clear();
+
+            // A null pool indicates released objects should be freed,
+            // rather than added back into the pool.
+            this._pool = null;
+        }
+
+        public int CountInactive => this._releaseOrder.Count;
+
+        /// <summary>
+        /// The memory kept by the objects that are in the pool, in bytes.
+        /// </summary>
+        public long InactiveBytes { get; private set; }
+
+        /// <summary>
+        /// The number of objects that have been gotten from the pool.
+        /// </summary>
+        public long CountGotten { get; private set; }
+
+        /// <summary>
+        /// The number of objects gotten from the pool that reused a released
+        /// object of the same size class, rather than creating a new one.
+        /// </summary>
+        public long CountHits { get; private set; }
+
+        /// <summary>
+        /// The number of objects that have been released into the pool.
+        /// </summary>
+        public long CountReleased { get; private set; }
+
+        /// <summary>
+        /// The number of released objects that were destroyed to keep the
+        /// pool within its maximum bytes.
+        /// </summary>
+        public long CountEvicted { get; private set; }
+
+        public void Clear()
+        {
+            if (this._pool == null)
+                return;
+
+            foreach (Entry entry in this._releaseOrder)
+            {
+                this._destroyCallback(entry.element);
+            }
+
+            this._releaseOrder.Clear();
+            this._pool.Clear();
+            this.InactiveBytes = 0;
+        }
+
+        public T Get(int sizeClass)
+        {
+            ++this.CountGotten;
+
+            List<LinkedListNode<Entry>> sizeClassPool;
+            if (this._pool != null && this._pool.TryGetValue(sizeClass, out sizeClassPool) && sizeClassPool.Count > 0)
+            {
+                int pos = sizeClassPool.Count - 1;
+                LinkedListNode<Entry> node = sizeClassPool[pos];
+                sizeClassPool.RemoveAt(pos);
+                this._releaseOrder.Remove(node);
+                this.InactiveBytes -= node.Value.bytes;
+                ++this.CountHits;
+                return node.Value.element;
+            }
+            else
+            {
+                return this._createCallback();
+            }
+        }
+
+        public void Release(T element, int sizeClass, long bytes)
+        {
+            ++this.CountReleased;
+
+            this._releaseCallback(element, sizeClass);
+
+            if (this._pool == null || bytes > this._maximumBytes)
+            {
+                this._destroyCallback(element);
+                return;
+            }
+
+            while (this.InactiveBytes + bytes > this._maximumBytes)
+            {
+                LinkedListNode<Entry> oldest = this._releaseOrder.First;
+                this._releaseOrder.RemoveFirst();
+                this._pool[oldest.Value.sizeClass].Remove(oldest);
+                this.InactiveBytes -= oldest.Value.bytes;
+                this._destroyCallback(oldest.Value.element);
+                ++this.CountEvicted;
+            }
+
+            List<LinkedListNode<Entry>> sizeClassPool;
+            if (!this._pool.TryGetValue(sizeClass, out sizeClassPool))
+            {
+                sizeClassPool = new List<LinkedListNode<Entry>>();
+                this._pool.Add(sizeClass, sizeClassPool);
+            }
+
+            sizeClassPool.Add(this._releaseOrder.AddLast(new Entry { element = element, sizeClass = sizeClass, bytes = bytes }));
+            this.InactiveBytes += bytes;
+        }
+    }
+}
@@ -144,6 +144,14 @@ namespace CesiumForUnity
             MeshCollider meshCollider = go.AddComponent<MeshCollider>();
             meshCollider.sharedMesh = mesh;
 
+            List<CesiumPhysicsInterestPoint> interestPoints = CesiumPhysicsInterestPoint.interestPoints;
+            for (int i = 0; i < interestPoints.Count; ++i)
+            {
+                CesiumPhysicsInterestPoint interestPoint = interestPoints[i];
+                float interestRadius = interestPoint.radius;
+                Vector3 interestPosition = interestPoint.transform.position;
+            }
+
             Debug.Log("Logging");
 
             MeshRenderer meshRenderer = new MeshRenderer();
@@ -158,12 +166,6 @@ namespace CesiumForUnity
             meshRenderer.material.DisableKeyword("keywordName");
             meshRenderer.material.EnableKeyword("keywordName");
             meshRenderer.material.GetTexture(id);
-            var ids = new List<int>();
-            meshRenderer.material.GetTexturePropertyNameIDs(ids);
-            for (int i = 0; i < ids.Count; ++i)
-            {
-                meshRenderer.material.GetTexture(ids[i]);
-            }
             meshRenderer.material.shaderKeywords = meshRenderer.material.shaderKeywords;
             meshRenderer.sharedMaterial = meshRenderer.sharedMaterial;
             meshRenderer.material.shader = meshRenderer.material.shader;
@@ -207,6 +209,9 @@ namespace CesiumForUnity
             string osVersion = System.Environment.OSVersion.VersionString;
 
             int frames = Time.frameCount;
+            float unscaledDeltaTime = Time.unscaledDeltaTime;
+            int targetFrameRate = Application.targetFrameRate;
+            bool isMobilePlatform = Application.isMobilePlatform;
 
             Marshal.FreeCoTaskMem(Marshal.StringToCoTaskMemUTF8("hi"));
 
@@ -238,6 +243,8 @@ namespace CesiumForUnity
             }
             request.downloadHandler.Dispose();
             long responseCode = request.responseCode;
+            ulong downloadedBytes = request.downloadedBytes;
+            request.Abort();
             UnityWebRequestAsyncOperation op = request.SendWebRequest();
             //Action<AsyncOperation> foo = (ao) => { };
             //var asdfx = foo + foo;
@@ -261,6 +268,7 @@ namespace CesiumForUnity
             tileset.forbidHoles = tileset.forbidHoles;
             tileset.maximumSimultaneousTileLoads = tileset.maximumSimultaneousTileLoads;
             tileset.maximumCachedBytes = tileset.maximumCachedBytes;
+            tileset.releaseGltfData = tileset.releaseGltfData;
             tileset.loadingDescendantLimit = tileset.loadingDescendantLimit;
             tileset.enableFrustumCulling = tileset.enableFrustumCulling;
             tileset.enableFogCulling = tileset.enableFogCulling;
@@ -270,6 +278,12 @@ namespace CesiumForUnity
             //tileset.lodTransitionLength = tileset.lodTransitionLength;
             tileset.generateSmoothNormals = tileset.generateSmoothNormals;
             tileset.createPhysicsMeshes = tileset.createPhysicsMeshes;
+            tileset.limitPhysicsMeshesToInterestPoints = tileset.limitPhysicsMeshesToInterestPoints;
+            tileset.simplifyPhysicsMeshes = tileset.simplifyPhysicsMeshes;
+            tileset.physicsMeshTriangleRatio = tileset.physicsMeshTriangleRatio;
+            tileset.physicsMeshMaximumError = tileset.physicsMeshMaximumError;
+            tileset.adaptScreenSpaceError = tileset.adaptScreenSpaceError;
+            tileset.maximumAdaptiveScreenSpaceError = tileset.maximumAdaptiveScreenSpaceError;
             tileset.suspendUpdate = tileset.suspendUpdate;
             tileset.previousSuspendUpdate = tileset.previousSuspendUpdate;
             tileset.showTilesInHierarchy = tileset.showTilesInHierarchy;
@@ -449,6 +463,44 @@ namespace CesiumForUnity
             string token = CesiumRuntimeSettings.defaultIonAccessToken;
             int requestsPerCachePrune = CesiumRuntimeSettings.requestsPerCachePrune;
             ulong maxItems = CesiumRuntimeSettings.maxItems;
+            if (CesiumRuntimeSettings.cacheBackend == CesiumCacheBackend.Files) { }
+            long fileCacheMaximumBytes = CesiumRuntimeSettings.fileCacheMaximumBytes;
+            if (CesiumRuntimeSettings.cacheMode == CesiumCacheMode.CacheOnly) { }
+            long memoryCacheMaximumBytes = CesiumRuntimeSettings.memoryCacheMaximumBytes;
+            bool compressCacheEntries = CesiumRuntimeSettings.compressCacheEntries;
+            if (CesiumRuntimeSettings.requestArchiveMode == CesiumRequestArchiveMode.Record) { }
+            string requestArchivePath = CesiumRuntimeSettings.requestArchivePath;
+            int replayLatencyMilliseconds = CesiumRuntimeSettings.replayLatencyMilliseconds;
+            long replayBytesPerSecond = CesiumRuntimeSettings.replayBytesPerSecond;
+            bool useNativeHttpClient = CesiumRuntimeSettings.useNativeHttpClient;
+            int maximumConnectionsPerHost = CesiumRuntimeSettings.maximumConnectionsPerHost;
+            bool useNativeTaskProcessor = CesiumRuntimeSettings.useNativeTaskProcessor;
+            int workerThreadCount = CesiumRuntimeSettings.workerThreadCount;
+            bool pinWorkerThreads = CesiumRuntimeSettings.pinWorkerThreads;
+            float mainThreadTaskTimeLimit = CesiumRuntimeSettings.mainThreadTaskTimeLimit;
+            bool useAdaptiveMainThreadBudget = CesiumRuntimeSettings.useAdaptiveMainThreadBudget;
+            long tileMemoryBudgetBytes = CesiumRuntimeSettings.tileMemoryBudgetBytes;
+
+            CesiumCacheSeeder seeder = go.GetComponent<CesiumCacheSeeder>();
+            if (seeder.tilesetSource == CesiumDataSource.FromCesiumIon) { }
+            string seederUrl = seeder.url;
+            long seederIonAssetID = seeder.ionAssetID;
+            string seederIonAccessToken = seeder.ionAccessToken;
+            long seederOverlayAssetID = seeder.rasterOverlayIonAssetID;
+            double seederWest = seeder.west;
+            double seederSouth = seeder.south;
+            double seederEast = seeder.east;
+            double seederNorth = seeder.north;
+            double seederViewHeight = seeder.viewHeight;
+            List<double3> viewPositions = seeder.viewPositions;
+            for (int i = 0; i < viewPositions.Count; ++i)
+            {
+                double3 viewPosition = viewPositions[i];
+            }
+            float seederScreenSpaceError = seeder.maximumScreenSpaceError;
+            int seederViewportWidth = seeder.viewportWidth;
+            int seederViewportHeight = seeder.viewportHeight;
+            float seederFieldOfView = seeder.fieldOfView;
 
             Cesium3DTilesetLoadFailureDetails tilesetDetails
                 = new Cesium3DTilesetLoadFailureDetails(tileset, Cesium3DTilesetLoadType.Unknown, 0, "");
@@ -509,9 +561,13 @@ namespace CesiumForUnity
             CesiumPointCloudRenderer renderer = go.AddComponent<CesiumPointCloudRenderer>();
             renderer.tileInfo = info;
 
-            CesiumObjectPool<Mesh> meshPool = CesiumObjectPools.MeshPool;
-            Mesh pooledMesh = meshPool.Get();
-            meshPool.Release(pooledMesh);
+            CesiumSizeClassPool<Mesh> meshPool = CesiumObjectPools.MeshPool;
+            Mesh pooledMesh = meshPool.Get(0);
+            meshPool.Release(pooledMesh, 0, 0);
+            long meshPoolGets = meshPool.CountGotten;
+            meshPoolGets = meshPool.CountHits;
+            int inactiveMeshes = meshPool.CountInactive;
+            long pooledMeshBytes = meshPool.InactiveBytes;
 
 #if UNITY_EDITOR
             SceneView sv = SceneView.lastActiveSceneView;
@@ -13,6 +13,11 @@ namespace CesiumForUnity
             CreateImplementation();
         }
 
+        protected override void ReceiveContentLengthHeader(ulong contentLength)
+        {
+            this.ReceiveContentLengthHeaderNative(contentLength);
+        }
+
         protected override bool ReceiveData(byte[] data, int dataLength) {
             unsafe
             {
@@ -25,5 +30,6 @@ namespace CesiumForUnity
         }
 
         private partial bool ReceiveDataNative(IntPtr data, int dataLength);
+        private partial void ReceiveContentLengthHeaderNative(ulong contentLength);
     }
 }
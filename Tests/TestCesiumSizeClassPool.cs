@@ -0,0 +1,103 @@
+using NUnit.Framework;
+using CesiumForUnity;
+
+public class TestCesiumSizeClassPool
+{
+    private class TestObject
+    {
+        public bool isDestroyed = false;
+        public int releasedSizeClass = -1;
+    }
+
+    private static CesiumSizeClassPool<TestObject> CreatePool(long maximumBytes = 1000)
+    {
+        return new CesiumSizeClassPool<TestObject>(
+            () => new TestObject(),
+            (to, sizeClass) => to.releasedSizeClass = sizeClass,
+            (to) => to.isDestroyed = true,
+            maximumBytes);
+    }
+
+    [Test]
+    public void ObjectIsOnlyReusedForTheSameSizeClass()
+    {
+        var pool = CreatePool();
+
+        TestObject obj = pool.Get(1);
+        pool.Release(obj, 1, 10);
+        Assert.AreEqual(1, obj.releasedSizeClass);
+        Assert.AreEqual(10, pool.InactiveBytes);
+
+        TestObject otherSizeClass = pool.Get(2);
+        Assert.AreNotSame(obj, otherSizeClass);
+
+        TestObject sameSizeClass = pool.Get(1);
+        Assert.AreSame(obj, sameSizeClass);
+
+        Assert.AreEqual(3, pool.CountGotten);
+        Assert.AreEqual(1, pool.CountHits);
+        Assert.AreEqual(1, pool.CountReleased);
+        Assert.AreEqual(0, pool.CountInactive);
+        Assert.AreEqual(0, pool.InactiveBytes);
+    }
+
+    [Test]
+    public void IfPoolIsFullOldestObjectsAreDestroyed()
+    {
+        var pool = CreatePool(100);
+
+        TestObject first = pool.Get(1);
+        TestObject second = pool.Get(2);
+        TestObject third = pool.Get(3);
+        TestObject fourth = pool.Get(1);
+
+        pool.Release(first, 1, 30);
+        pool.Release(second, 2, 30);
+        pool.Release(third, 3, 30);
+        pool.Release(fourth, 1, 60);
+
+        Assert.IsTrue(first.isDestroyed);
+        Assert.IsTrue(second.isDestroyed);
+        Assert.IsFalse(third.isDestroyed);
+        Assert.IsFalse(fourth.isDestroyed);
+        Assert.AreEqual(2, pool.CountInactive);
+        Assert.AreEqual(90, pool.InactiveBytes);
+        Assert.AreEqual(2, pool.CountEvicted);
+
+        Assert.AreSame(fourth, pool.Get(1));
+        Assert.AreSame(third, pool.Get(3));
+    }
+
+    [Test]
+    public void ObjectLargerThanPoolIsDestroyed()
+    {
+        var pool = CreatePool(100);
+
+        TestObject pooled = pool.Get(1);
+        TestObject large = pool.Get(2);
+        pool.Release(pooled, 1, 50);
+        pool.Release(large, 2, 101);
+
+        Assert.IsTrue(large.isDestroyed);
+        Assert.IsFalse(pooled.isDestroyed);
+        Assert.AreEqual(50, pool.InactiveBytes);
+        Assert.AreEqual(0, pool.CountEvicted);
+    }
+
+    [Test]
+    public void AfterPoolIsDisposedReleasedObjectsAreDestroyed()
+    {
+        var pool = CreatePool();
+
+        TestObject pooled = pool.Get(1);
+        TestObject to = pool.Get(1);
+        pool.Release(pooled, 1, 10);
+        pool.Dispose();
+        Assert.IsTrue(pooled.isDestroyed);
+        Assert.AreEqual(0, pool.InactiveBytes);
+
+        pool.Release(to, 1, 10);
+        Assert.AreEqual(1, to.releasedSizeClass);
+        Assert.IsTrue(to.isDestroyed);
+    }
+}
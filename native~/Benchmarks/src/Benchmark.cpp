@@ -0,0 +1,147 @@
+#include "Benchmark.h"
+
+#include "RequestArchive.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The synthetic payloads, when there's no archive to read.
+const size_t syntheticPayloadCount = 200;
+const size_t minimumSyntheticVertices = 500;
+const size_t maximumSyntheticVertices = 20000;
+
+template <typename T> void append(std::vector<std::byte>& data, T value) {
+  const size_t offset = data.size();
+  data.resize(offset + sizeof(T));
+  std::memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+/**
+ * @brief Generates a payload laid out like a glTF mesh: a JSON header, then
+ * positions on a bumpy grid, normals, texture coordinates, and indices.
+ */
+BenchmarkPayload generatePayload(std::mt19937& random, size_t index) {
+  BenchmarkPayload payload;
+  payload.url =
+      "https://example.com/synthetic/" + std::to_string(index) + ".glb";
+  payload.headers.emplace("Content-Type", "model/gltf-binary");
+
+  std::uniform_int_distribution<size_t> vertexCount(
+      minimumSyntheticVertices,
+      maximumSyntheticVertices);
+  std::normal_distribution<float> noise(0.0f, 0.5f);
+
+  const size_t side = size_t(std::sqrt(double(vertexCount(random))));
+  const std::string json =
+      "{\"asset\":{\"version\":\"2.0\"},\"meshes\":[{\"primitives\":[{"
+      "\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},"
+      "\"indices\":3}]}],\"accessors\":[{\"count\":" +
+      std::to_string(side * side) + "}]}";
+  for (char c : json) {
+    payload.data.push_back(std::byte(c));
+  }
+
+  for (size_t y = 0; y < side; ++y) {
+    for (size_t x = 0; x < side; ++x) {
+      append(payload.data, float(x));
+      append(payload.data, float(y));
+      append(payload.data, 10.0f + noise(random));
+    }
+  }
+  for (size_t i = 0; i < side * side; ++i) {
+    append(payload.data, noise(random) * 0.1f);
+    append(payload.data, noise(random) * 0.1f);
+    append(payload.data, 1.0f);
+  }
+  for (size_t y = 0; y < side; ++y) {
+    for (size_t x = 0; x < side; ++x) {
+      append(payload.data, float(x) / float(side));
+      append(payload.data, float(y) / float(side));
+    }
+  }
+  for (size_t y = 0; y + 1 < side; ++y) {
+    for (size_t x = 0; x + 1 < side; ++x) {
+      const uint32_t corner = uint32_t(y * side + x);
+      for (uint32_t vertex :
+           {corner,
+            corner + 1,
+            corner + uint32_t(side),
+            corner + 1,
+            corner + uint32_t(side) + 1,
+            corner + uint32_t(side)}) {
+        append(payload.data, vertex);
+      }
+    }
+  }
+
+  return payload;
+}
+
+} // namespace
+
+std::vector<BenchmarkPayload> loadBenchmarkPayloads(int argc, char** argv) {
+  std::vector<BenchmarkPayload> payloads;
+
+  if (argc < 2) {
+    std::printf(
+        "No request archive was given, so synthetic payloads are used. For "
+        "results that reflect real tiles, record a request archive and pass "
+        "its path.\n");
+    std::mt19937 random(1);
+    for (size_t i = 0; i < syntheticPayloadCount; ++i) {
+      payloads.emplace_back(generatePayload(random, i));
+    }
+  } else {
+    RequestArchive archive =
+        readRequestArchive(spdlog::default_logger(), argv[1]);
+    for (const auto& [key, pResponse] : archive) {
+      if (pResponse->statusCode < 200 || pResponse->statusCode >= 300 ||
+          pResponse->data.empty()) {
+        continue;
+      }
+      payloads.emplace_back(BenchmarkPayload{
+          pResponse->url,
+          pResponse->headers,
+          pResponse->data});
+    }
+
+    if (payloads.empty()) {
+      std::printf("%s has no successful responses.\n", argv[1]);
+      return payloads;
+    }
+  }
+
+  std::printf(
+      "Benchmarking with %zu payloads, %.1f MB in total.\n",
+      payloads.size(),
+      double(getTotalBytes(payloads)) / (1024.0 * 1024.0));
+  return payloads;
+}
+
+uint64_t getTotalBytes(const std::vector<BenchmarkPayload>& payloads) {
+  uint64_t result = 0;
+  for (const BenchmarkPayload& payload : payloads) {
+    result += payload.data.size();
+  }
+  return result;
+}
+
+void printBenchmarkThroughput(
+    const std::string& name,
+    uint64_t bytes,
+    double seconds) {
+  std::printf(
+      "  %-40s %10.1f MB/s\n",
+      name.c_str(),
+      double(bytes) / (1024.0 * 1024.0) / seconds);
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <CesiumAsync/HttpHeaders.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A response body that a benchmark is run on.
+ */
+struct BenchmarkPayload {
+  std::string url;
+  CesiumAsync::HttpHeaders headers;
+  std::vector<std::byte> data;
+};
+
+/**
+ * @brief Loads the payloads that a benchmark is run on.
+ *
+ * If a request archive, as recorded with the `Record` request archive mode,
+ * is named on the command line, its successful responses are used, so that
+ * the benchmark runs on real tiles. Otherwise, synthetic payloads that look
+ * roughly like tile meshes are generated, and a warning says that the results
+ * are only indicative.
+ *
+ * @return The payloads, or an empty vector if the archive couldn't be read.
+ */
+std::vector<BenchmarkPayload> loadBenchmarkPayloads(int argc, char** argv);
+
+/**
+ * @brief Adds up the sizes of the payloads' bodies.
+ */
+uint64_t getTotalBytes(const std::vector<BenchmarkPayload>& payloads);
+
+/**
+ * @brief Runs a benchmark pass repeatedly and returns the shortest time that
+ * it took, in seconds.
+ *
+ * @param passes The number of times to run the pass.
+ * @param pass The pass. If it returns a value, that value is the time to
+ * report for it, in seconds, which lets a pass leave its setup out.
+ */
+template <typename Pass> double measureBenchmark(int passes, Pass&& pass) {
+  double best = 0.0;
+  for (int i = 0; i < passes; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    double seconds;
+    if constexpr (std::is_void_v<decltype(pass())>) {
+      pass();
+      seconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    } else {
+      seconds = pass();
+    }
+
+    if (i == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Prints a throughput, in megabytes of payload per second.
+ */
+void printBenchmarkThroughput(
+    const std::string& name,
+    uint64_t bytes,
+    double seconds);
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,189 @@
+#include "Benchmark.h"
+#include "CompressingCacheDatabase.h"
+#include "FileCacheDatabase.h"
+
+#include <CesiumAsync/SqliteCache.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <random>
+
+using namespace CesiumAsync;
+using namespace CesiumForUnityNative;
+
+namespace {
+
+const int passes = 3;
+const uint64_t fileCacheMaximumBytes = uint64_t(1) << 40;
+
+/**
+ * @brief A cache database that is being benchmarked.
+ */
+struct BenchmarkDatabase {
+  std::shared_ptr<ICacheDatabase> pDatabase;
+
+  /**
+   * @brief Finishes the writes that the database has queued, so that they
+   * count towards the time taken to store the entries.
+   */
+  std::function<void()> flush;
+};
+
+/**
+ * @brief Opens a cache database in an empty directory.
+ */
+using DatabaseFactory =
+    std::function<BenchmarkDatabase(const std::filesystem::path& directory)>;
+
+uint64_t getDirectoryBytes(const std::filesystem::path& directory) {
+  uint64_t result = 0;
+  for (const auto& entry :
+       std::filesystem::recursive_directory_iterator(directory)) {
+    if (entry.is_regular_file()) {
+      result += entry.file_size();
+    }
+  }
+  return result;
+}
+
+void benchmarkDatabase(
+    const std::string& name,
+    const std::vector<BenchmarkPayload>& payloads,
+    const DatabaseFactory& create) {
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() /
+      "cesium-benchmark-cache-database";
+  const uint64_t totalBytes = getTotalBytes(payloads);
+
+  // Entries are read in a different order than they were written, as tiles
+  // are.
+  std::vector<size_t> readOrder(payloads.size());
+  for (size_t i = 0; i < readOrder.size(); ++i) {
+    readOrder[i] = i;
+  }
+  std::shuffle(readOrder.begin(), readOrder.end(), std::mt19937(1));
+
+  BenchmarkDatabase database;
+  double storeSeconds = measureBenchmark(passes, [&]() {
+    database = BenchmarkDatabase();
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    database = create(directory);
+
+    auto start = std::chrono::steady_clock::now();
+    for (const BenchmarkPayload& payload : payloads) {
+      database.pDatabase->storeEntry(
+          payload.url,
+          std::time(nullptr) + 3600,
+          payload.url,
+          "GET",
+          HttpHeaders(),
+          200,
+          payload.headers,
+          payload.data);
+    }
+    database.flush();
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  });
+
+  const uint64_t diskBytes = getDirectoryBytes(directory);
+
+  size_t misses = 0;
+  double getSeconds = measureBenchmark(passes, [&]() {
+    misses = 0;
+    for (size_t i : readOrder) {
+      std::optional<CacheItem> item =
+          database.pDatabase->getEntry(payloads[i].url);
+      if (!item || item->cacheResponse.data != payloads[i].data) {
+        ++misses;
+      }
+    }
+  });
+
+  std::printf("%s\n", name.c_str());
+  printBenchmarkThroughput(
+      "storeEntry, until written",
+      totalBytes,
+      storeSeconds);
+  printBenchmarkThroughput("getEntry", totalBytes, getSeconds);
+  std::printf(
+      "  %-40s %10.1f MB (%.1f%% of the payloads)\n",
+      "on disk",
+      double(diskBytes) / (1024.0 * 1024.0),
+      100.0 * double(diskBytes) / double(totalBytes));
+  if (misses > 0) {
+    std::printf("  %zu entries were not read back correctly!\n", misses);
+  }
+
+  database = BenchmarkDatabase();
+  std::filesystem::remove_all(directory);
+}
+
+BenchmarkDatabase
+createSqliteCache(const std::filesystem::path& directory, size_t maxItems) {
+  return BenchmarkDatabase{
+      std::make_shared<SqliteCache>(
+          spdlog::default_logger(),
+          (directory / "cache.sqlite").string(),
+          maxItems),
+      []() {}};
+}
+
+BenchmarkDatabase createFileCacheDatabase(
+    const std::filesystem::path& directory) {
+  auto pDatabase = std::make_shared<FileCacheDatabase>(
+      spdlog::default_logger(),
+      directory.string(),
+      fileCacheMaximumBytes);
+  return BenchmarkDatabase{pDatabase, [pDatabase]() { pDatabase->shutdown(); }};
+}
+
+BenchmarkDatabase compress(BenchmarkDatabase&& database) {
+  return BenchmarkDatabase{
+      std::make_shared<CompressingCacheDatabase>(database.pDatabase),
+      std::move(database.flush)};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::vector<BenchmarkPayload> payloads = loadBenchmarkPayloads(argc, argv);
+  if (payloads.empty()) {
+    return 1;
+  }
+
+  const size_t maxItems = payloads.size() * 2;
+
+  benchmarkDatabase(
+      "SqliteCache",
+      payloads,
+      [maxItems](const std::filesystem::path& directory) {
+        return createSqliteCache(directory, maxItems);
+      });
+
+  benchmarkDatabase(
+      "SqliteCache, compressed",
+      payloads,
+      [maxItems](const std::filesystem::path& directory) {
+        return compress(createSqliteCache(directory, maxItems));
+      });
+
+  benchmarkDatabase("FileCacheDatabase", payloads, createFileCacheDatabase);
+
+  benchmarkDatabase(
+      "FileCacheDatabase, compressed",
+      payloads,
+      [](const std::filesystem::path& directory) {
+        return compress(createFileCacheDatabase(directory));
+      });
+
+  return 0;
+}
@@ -0,0 +1,127 @@
+#include "Benchmark.h"
+#include "DownloadBufferPool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace CesiumForUnityNative;
+
+namespace {
+
+const int passes = 3;
+
+// The size of the chunks that UnityWebRequest hands to NativeDownloadHandler.
+const size_t chunkBytes = 16 * 1024;
+
+// Each response size is downloaded until about this many bytes have been
+// received, so that the pool reaches a steady state.
+const size_t bytesPerPass = size_t(256) * 1024 * 1024;
+
+const size_t megabyte = 1024 * 1024;
+
+// Keeps the compiler from optimizing away the reads of the responses.
+volatile size_t checksumSink = 0;
+
+struct Strategy {
+  const char* name;
+  bool useContentLength;
+  bool usePool;
+};
+
+// The first is how responses were received before the buffers were sized and
+// pooled, and the last is what NativeDownloadHandlerImpl does now.
+const Strategy strategies[] = {
+    {"grow a new buffer", false, false},
+    {"reserve Content-Length", true, false},
+    {"pooled buffer", false, true},
+    {"pooled buffer, reserve Content-Length", true, true}};
+
+/**
+ * @brief Receives a response the way NativeDownloadHandlerImpl does, reads
+ * it, and then destroys it or returns its buffer to the pool.
+ */
+size_t receive(const std::vector<std::byte>& body, const Strategy& strategy) {
+  std::vector<std::byte> data;
+  if (strategy.useContentLength) {
+    if (strategy.usePool) {
+      data = DownloadBufferPool::acquire(body.size());
+    } else {
+      data.reserve(body.size());
+    }
+  }
+
+  for (size_t offset = 0; offset < body.size(); offset += chunkBytes) {
+    const size_t length = std::min(chunkBytes, body.size() - offset);
+    if (data.capacity() == 0 && strategy.usePool) {
+      data = DownloadBufferPool::acquire(length);
+    }
+
+    const std::byte* p = body.data() + offset;
+    data.insert(data.end(), p, p + length);
+  }
+
+  // Read the response, as loading the tile would.
+  size_t checksum = 0;
+  for (size_t i = 0; i < data.size(); i += 4096) {
+    checksum += size_t(data[i]);
+  }
+
+  if (strategy.usePool) {
+    DownloadBufferPool::release(std::move(data));
+  }
+
+  return checksum;
+}
+
+void benchmarkBodies(
+    const std::string& name,
+    const std::vector<const std::vector<std::byte>*>& bodies) {
+  uint64_t totalBytes = 0;
+  for (const std::vector<std::byte>* pBody : bodies) {
+    totalBytes += pBody->size();
+  }
+
+  std::printf("%s\n", name.c_str());
+  for (const Strategy& strategy : strategies) {
+    size_t checksum = 0;
+    double seconds = measureBenchmark(passes, [&]() {
+      for (const std::vector<std::byte>* pBody : bodies) {
+        checksum += receive(*pBody, strategy);
+      }
+    });
+    checksumSink = checksum;
+    printBenchmarkThroughput(strategy.name, totalBytes, seconds);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::vector<BenchmarkPayload> payloads = loadBenchmarkPayloads(argc, argv);
+  if (payloads.empty()) {
+    return 1;
+  }
+
+  for (size_t megabytes : {1, 2, 5, 10, 20, 50}) {
+    std::vector<std::byte> body(megabytes * megabyte, std::byte(1));
+    std::vector<const std::vector<std::byte>*> bodies(
+        std::max(bytesPerPass / body.size(), size_t(4)),
+        &body);
+    benchmarkBodies(std::to_string(megabytes) + " MB responses", bodies);
+  }
+
+  // The payloads are repeated so that the pass is long enough to time.
+  std::vector<const std::vector<std::byte>*> bodies;
+  const uint64_t payloadBytes = std::max(getTotalBytes(payloads), uint64_t(1));
+  for (uint64_t i = 0; i < std::max(bytesPerPass / payloadBytes, uint64_t(1));
+       ++i) {
+    for (const BenchmarkPayload& payload : payloads) {
+      bodies.emplace_back(&payload.data);
+    }
+  }
+  benchmarkBodies("Responses the size of the payloads", bodies);
+
+  return 0;
+}
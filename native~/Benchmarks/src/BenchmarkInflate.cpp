@@ -0,0 +1,260 @@
+#include "Benchmark.h"
+#include "InflatingAssetAccessor.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/GunzipAssetAccessor.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/ITaskProcessor.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumForUnityNative;
+
+namespace {
+
+const int passes = 5;
+
+/**
+ * @brief Runs tasks straight away, so that only the inflating is measured.
+ */
+class InlineTaskProcessor : public ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) override { f(); }
+};
+
+class BenchmarkAssetResponse : public IAssetResponse {
+public:
+  BenchmarkAssetResponse(
+      const HttpHeaders& headers,
+      std::vector<std::byte>&& data)
+      : _headers(headers), _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const override { return 200; }
+
+  virtual std::string contentType() const override {
+    auto it = this->_headers.find("Content-Type");
+    return it == this->_headers.end() ? std::string() : it->second;
+  }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return this->_data;
+  }
+
+private:
+  HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class BenchmarkAssetRequest : public IAssetRequest {
+public:
+  BenchmarkAssetRequest(
+      const std::string& url,
+      const HttpHeaders& headers,
+      std::vector<std::byte>&& data)
+      : _method("GET"),
+        _url(url),
+        _headers(),
+        _response(headers, std::move(data)) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  BenchmarkAssetResponse _response;
+};
+
+/**
+ * @brief An asset accessor that answers every request with a gzipped payload
+ * that it already has in memory.
+ */
+class BenchmarkAssetAccessor : public IAssetAccessor {
+public:
+  void add(std::shared_ptr<IAssetRequest>&& pRequest) {
+    std::string url = pRequest->url();
+    this->_requests.emplace(std::move(url), std::move(pRequest));
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& /*headers*/) override {
+    return asyncSystem.createResolvedFuture(this->_requests.at(url));
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& /*verb*/,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& /*contentPayload*/) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+private:
+  std::unordered_map<std::string, std::shared_ptr<IAssetRequest>> _requests;
+};
+
+bool isGzip(const std::vector<std::byte>& data) {
+  return data.size() >= 18 && data[0] == std::byte{0x1f} &&
+         data[1] == std::byte{0x8b};
+}
+
+/**
+ * @brief Gzips data, as a server with compression enabled would.
+ */
+std::vector<std::byte> gzip(const std::vector<std::byte>& data) {
+  z_stream stream = z_stream();
+  // Adding 16 to the window bits makes zlib write a gzip header.
+  deflateInit2(
+      &stream,
+      Z_DEFAULT_COMPRESSION,
+      Z_DEFLATED,
+      16 + MAX_WBITS,
+      8,
+      Z_DEFAULT_STRATEGY);
+
+  std::vector<std::byte> result(deflateBound(&stream, uLong(data.size())));
+  stream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<std::byte*>(data.data()));
+  stream.avail_in = uInt(data.size());
+  stream.next_out = reinterpret_cast<Bytef*>(result.data());
+  stream.avail_out = uInt(result.size());
+  deflate(&stream, Z_FINISH);
+  result.resize(stream.total_out);
+  deflateEnd(&stream);
+  return result;
+}
+
+/**
+ * @brief Reads an inflated response, as loading the tile would.
+ */
+size_t readResponse(const IAssetResponse& response) {
+  gsl::span<const std::byte> data = response.data();
+  size_t checksum = data.size();
+  for (size_t i = 0; i < data.size(); i += 4096) {
+    checksum += size_t(data[i]);
+  }
+  return checksum;
+}
+
+// Keeps the compiler from optimizing away the reads of the responses.
+volatile size_t checksumSink = 0;
+
+void benchmarkAccessor(
+    const std::string& name,
+    IAssetAccessor& accessor,
+    const AsyncSystem& asyncSystem,
+    const std::vector<BenchmarkPayload>& payloads,
+    uint64_t inflatedBytes) {
+  size_t checksum = 0;
+  double seconds = measureBenchmark(passes, [&]() {
+    for (const BenchmarkPayload& payload : payloads) {
+      std::shared_ptr<IAssetRequest> pRequest =
+          accessor.get(asyncSystem, payload.url, {}).wait();
+      checksum += readResponse(*pRequest->response());
+    }
+  });
+  checksumSink = checksum;
+
+  printBenchmarkThroughput(name, inflatedBytes, seconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::vector<BenchmarkPayload> payloads = loadBenchmarkPayloads(argc, argv);
+  if (payloads.empty()) {
+    return 1;
+  }
+
+  // Responses recorded from a server that gzips them are used as they are,
+  // and the rest are gzipped here.
+  auto pSource = std::make_shared<BenchmarkAssetAccessor>();
+  uint64_t compressedBytes = 0;
+  for (const BenchmarkPayload& payload : payloads) {
+    std::vector<std::byte> compressed =
+        isGzip(payload.data) ? payload.data : gzip(payload.data);
+    compressedBytes += compressed.size();
+    pSource->add(std::make_shared<BenchmarkAssetRequest>(
+        payload.url,
+        payload.headers,
+        std::move(compressed)));
+  }
+
+  AsyncSystem asyncSystem(std::make_shared<InlineTaskProcessor>());
+  GunzipAssetAccessor baseline(pSource);
+  InflatingAssetAccessor inflating(pSource);
+
+  // Check that both accessors inflate every response to the same data.
+  uint64_t inflatedBytes = 0;
+  size_t mismatches = 0;
+  for (const BenchmarkPayload& payload : payloads) {
+    std::shared_ptr<IAssetRequest> pExpected =
+        baseline.get(asyncSystem, payload.url, {}).wait();
+    std::shared_ptr<IAssetRequest> pActual =
+        inflating.get(asyncSystem, payload.url, {}).wait();
+    gsl::span<const std::byte> expected = pExpected->response()->data();
+    gsl::span<const std::byte> actual = pActual->response()->data();
+    inflatedBytes += expected.size();
+    if (!std::equal(
+            expected.begin(),
+            expected.end(),
+            actual.begin(),
+            actual.end())) {
+      ++mismatches;
+    }
+  }
+
+  std::printf(
+      "Inflating %.1f MB of gzipped responses to %.1f MB.\n",
+      double(compressedBytes) / (1024.0 * 1024.0),
+      double(inflatedBytes) / (1024.0 * 1024.0));
+  if (mismatches > 0) {
+    std::printf(
+        "%zu responses were inflated differently by the two accessors!\n",
+        mismatches);
+  }
+
+  benchmarkAccessor(
+      "GunzipAssetAccessor",
+      baseline,
+      asyncSystem,
+      payloads,
+      inflatedBytes);
+  benchmarkAccessor(
+      "InflatingAssetAccessor",
+      inflating,
+      asyncSystem,
+      payloads,
+      inflatedBytes);
+
+  return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,405 @@
+#include "AssetRequestCancellation.h"
+#include "HttpAssetAccessor.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/ITaskProcessor.h>
+
+#include <httplib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumForUnityNative;
+
+namespace {
+
+const char* const serverHost = "127.0.0.1";
+
+// Large enough to arrive in many reads, so that the body is assembled from
+// chunks rather than received all at once.
+const size_t largeBodyBytes = 3 * 1024 * 1024;
+
+// How long the server keeps sending the slow response if it isn't aborted,
+// which is far longer than cancelling it should take.
+const std::chrono::seconds slowResponseDuration(10);
+const std::chrono::seconds maximumCancellationDelay(2);
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+  if (!condition) {
+    std::printf("FAILED: %s\n", what.c_str());
+    ++failures;
+  }
+}
+
+/**
+ * @brief Runs tasks straight away. The accessor resolves its requests on its
+ * own threads, so there's nothing else for a task processor to do here.
+ */
+class InlineTaskProcessor : public ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) override { f(); }
+};
+
+/**
+ * @brief Rejects every request, so that a request that should have been
+ * handled natively doesn't quietly succeed some other way.
+ */
+class RejectingAssetAccessor : public IAssetAccessor {
+public:
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    return this->request(asyncSystem, "GET", url, headers, {});
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& /*verb*/,
+      const std::string& url,
+      const std::vector<THeader>& /*headers*/,
+      const gsl::span<const std::byte>& /*contentPayload*/) override {
+    Promise<std::shared_ptr<IAssetRequest>> promise =
+        asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+    promise.reject(std::runtime_error("Fallback was used for " + url));
+    return promise.getFuture();
+  }
+
+  virtual void tick() noexcept override {}
+};
+
+std::string createBody(size_t size) {
+  std::string body(size, '\0');
+  for (size_t i = 0; i < size; ++i) {
+    body[i] = char(i * 7 + i / 1024);
+  }
+  return body;
+}
+
+bool hasBody(const IAssetResponse& response, const std::string& body) {
+  gsl::span<const std::byte> data = response.data();
+  return data.size() == body.size() &&
+         std::equal(
+             data.begin(),
+             data.end(),
+             reinterpret_cast<const std::byte*>(body.data()));
+}
+
+/**
+ * @brief Waits for a request and returns its response, or nullptr if it
+ * failed.
+ */
+std::shared_ptr<IAssetRequest>
+waitForRequest(Future<std::shared_ptr<IAssetRequest>>&& future) {
+  try {
+    return std::move(future).wait();
+  } catch (const std::exception&) {
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Serves the responses that the checks request, on a port of its own,
+ * for as long as it exists.
+ */
+class CheckServer {
+public:
+  CheckServer() : _server(), _port(0), _thread() {
+    // Enough requests for the keep-alive check to reuse one connection.
+    this->_server.set_keep_alive_max_count(100);
+
+    this->_server.Get(
+        "/small",
+        [](const httplib::Request& request, httplib::Response& response) {
+          response.set_header(
+              "X-Echo",
+              request.get_header_value("X-Request-Header") + "," +
+                  request.get_header_value("X-Accessor-Header"));
+          response.set_content(createBody(100), "application/octet-stream");
+        });
+
+    this->_server.Get(
+        "/connection",
+        [](const httplib::Request& request, httplib::Response& response) {
+          response.set_content(
+              std::to_string(request.remote_port),
+              "text/plain");
+        });
+
+    this->_server.Get(
+        "/large",
+        [](const httplib::Request& /*request*/, httplib::Response& response) {
+          response.set_content(
+              createBody(largeBodyBytes),
+              "application/octet-stream");
+        });
+
+    // Without a Content-Length, the body is only complete when the last chunk
+    // arrives.
+    this->_server.Get(
+        "/chunked",
+        [](const httplib::Request& /*request*/, httplib::Response& response) {
+          response.set_chunked_content_provider(
+              "application/octet-stream",
+              [](size_t /*offset*/, httplib::DataSink& sink) {
+                std::string body = createBody(largeBodyBytes);
+                for (size_t i = 0; i < body.size(); i += 64 * 1024) {
+                  size_t length =
+                      std::min(body.size() - i, size_t(64 * 1024));
+                  if (!sink.write(body.data() + i, length)) {
+                    return false;
+                  }
+                }
+                sink.done();
+                return true;
+              });
+        });
+
+    this->_server.Get(
+        "/missing",
+        [](const httplib::Request& /*request*/, httplib::Response& response) {
+          response.status = 404;
+          response.set_content("Not here", "text/plain");
+        });
+
+    // Trickles out a response until the client goes away.
+    this->_server.Get(
+        "/slow",
+        [this](
+            const httplib::Request& /*request*/,
+            httplib::Response& response) {
+          ++this->slowResponsesStarted;
+          auto start = std::chrono::steady_clock::now();
+          response.set_chunked_content_provider(
+              "application/octet-stream",
+              [start](size_t /*offset*/, httplib::DataSink& sink) {
+                while (std::chrono::steady_clock::now() - start <
+                       slowResponseDuration) {
+                  if (!sink.is_writable() || !sink.write("x", 1)) {
+                    return false;
+                  }
+                  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+                sink.done();
+                return true;
+              });
+        });
+
+    this->_port = this->_server.bind_to_any_port(serverHost);
+    if (this->_port <= 0) {
+      throw std::runtime_error("Could not start the server.");
+    }
+
+    this->_thread =
+        std::thread([this]() { this->_server.listen_after_bind(); });
+    while (!this->_server.is_running()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  ~CheckServer() {
+    this->_server.stop();
+    this->_thread.join();
+  }
+
+  std::string url(const std::string& path) const {
+    return "http://" + std::string(serverHost) + ":" +
+           std::to_string(this->_port) + path;
+  }
+
+  std::atomic<int32_t> slowResponsesStarted{0};
+
+private:
+  httplib::Server _server;
+  int _port;
+  std::thread _thread;
+};
+
+void checkGet(
+    const AsyncSystem& asyncSystem,
+    IAssetAccessor& accessor,
+    const CheckServer& server) {
+  std::shared_ptr<IAssetRequest> pRequest = waitForRequest(accessor.get(
+      asyncSystem,
+      server.url("/small"),
+      {{"X-Request-Header", "request"}}));
+  const IAssetResponse* pResponse = pRequest ? pRequest->response() : nullptr;
+  check(pResponse != nullptr, "GET succeeds");
+  if (!pResponse) {
+    return;
+  }
+
+  check(pResponse->statusCode() == 200, "GET responds with 200");
+  check(
+      pResponse->contentType() == "application/octet-stream",
+      "GET reports the content type");
+  check(hasBody(*pResponse, createBody(100)), "GET receives the body");
+
+  auto echo = pResponse->headers().find("X-Echo");
+  check(
+      echo != pResponse->headers().end() &&
+          echo->second == "request,accessor",
+      "GET sends the request's and the accessor's headers");
+}
+
+void checkKeepAlive(
+    const AsyncSystem& asyncSystem,
+    IAssetAccessor& accessor,
+    const CheckServer& server) {
+  // One connection per host, so every request must go over the same one if
+  // connections are kept alive.
+  std::vector<std::string> ports;
+  for (int i = 0; i < 3; ++i) {
+    std::shared_ptr<IAssetRequest> pRequest =
+        waitForRequest(accessor.get(asyncSystem, server.url("/connection")));
+    const IAssetResponse* pResponse =
+        pRequest ? pRequest->response() : nullptr;
+    check(
+        pResponse != nullptr,
+        "Requests over a kept-alive connection succeed");
+    if (!pResponse) {
+      return;
+    }
+
+    gsl::span<const std::byte> data = pResponse->data();
+    ports.emplace_back(reinterpret_cast<const char*>(data.data()), data.size());
+  }
+
+  check(
+      ports[0] == ports[1] && ports[1] == ports[2],
+      "Later requests to the same host reuse the connection");
+}
+
+void checkContentLength(
+    const AsyncSystem& asyncSystem,
+    IAssetAccessor& accessor,
+    const CheckServer& server) {
+  const std::string body = createBody(largeBodyBytes);
+
+  std::shared_ptr<IAssetRequest> pRequest =
+      waitForRequest(accessor.get(asyncSystem, server.url("/large")));
+  const IAssetResponse* pResponse = pRequest ? pRequest->response() : nullptr;
+  check(
+      pResponse != nullptr && hasBody(*pResponse, body),
+      "A body with a Content-Length is received whole");
+
+  pRequest = waitForRequest(accessor.get(asyncSystem, server.url("/chunked")));
+  pResponse = pRequest ? pRequest->response() : nullptr;
+  check(
+      pResponse != nullptr && hasBody(*pResponse, body),
+      "A chunked body without a Content-Length is received whole");
+}
+
+void checkErrors(
+    const AsyncSystem& asyncSystem,
+    IAssetAccessor& accessor,
+    const CheckServer& server) {
+  std::shared_ptr<IAssetRequest> pRequest =
+      waitForRequest(accessor.get(asyncSystem, server.url("/missing")));
+  const IAssetResponse* pResponse = pRequest ? pRequest->response() : nullptr;
+  check(
+      pResponse != nullptr && pResponse->statusCode() == 404 &&
+          hasBody(*pResponse, "Not here"),
+      "An error status is a response, not a failed request");
+
+  // Nothing listens on port 1.
+  pRequest = waitForRequest(
+      accessor.get(asyncSystem, "http://" + std::string(serverHost) + ":1/"));
+  check(pRequest == nullptr, "A request that can't connect fails");
+}
+
+void checkCancelGroup(
+    const AsyncSystem& asyncSystem,
+    IAssetAccessor& accessor,
+    CheckServer& server) {
+  const AssetRequestCancellation::Statistics before =
+      AssetRequestCancellation::getStatistics();
+
+  uint64_t group = AssetRequestCancellation::createGroup();
+  std::vector<IAssetAccessor::THeader> headers{
+      {AssetRequestCancellation::groupHeader, std::to_string(group)}};
+
+  // With one connection per host, the second request waits in the queue
+  // behind the first, and the request outside the group waits behind both.
+  Future<std::shared_ptr<IAssetRequest>> inProgress =
+      accessor.get(asyncSystem, server.url("/slow"), headers);
+  while (server.slowResponsesStarted == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  Future<std::shared_ptr<IAssetRequest>> queued =
+      accessor.get(asyncSystem, server.url("/slow"), headers);
+  Future<std::shared_ptr<IAssetRequest>> otherGroup =
+      accessor.get(asyncSystem, server.url("/small"));
+
+  auto start = std::chrono::steady_clock::now();
+  AssetRequestCancellation::cancelGroup(group);
+
+  check(
+      waitForRequest(std::move(inProgress)) == nullptr,
+      "Cancelling a group aborts its request in progress");
+  check(
+      std::chrono::steady_clock::now() - start < maximumCancellationDelay,
+      "A cancelled request in progress stops promptly");
+  check(
+      waitForRequest(std::move(queued)) == nullptr,
+      "Cancelling a group drops its queued requests");
+  check(server.slowResponsesStarted == 1, "A dropped request is never sent");
+
+  std::shared_ptr<IAssetRequest> pRequest =
+      waitForRequest(std::move(otherGroup));
+  check(
+      pRequest != nullptr && pRequest->response() != nullptr &&
+          pRequest->response()->statusCode() == 200,
+      "Cancelling a group leaves other requests alone");
+
+  check(
+      AssetRequestCancellation::getStatistics().cancelledRequests ==
+          before.cancelledRequests + 2,
+      "Cancelled requests are counted");
+
+  Future<std::shared_ptr<IAssetRequest>> afterCancel =
+      accessor.get(asyncSystem, server.url("/small"), headers);
+  check(
+      waitForRequest(std::move(afterCancel)) == nullptr,
+      "Requests made for a cancelled group fail");
+}
+
+} // namespace
+
+int main() {
+  CheckServer server;
+  AsyncSystem asyncSystem(std::make_shared<InlineTaskProcessor>());
+  HttpAssetAccessor accessor(
+      std::make_shared<RejectingAssetAccessor>(),
+      {{"X-Accessor-Header", "accessor"}},
+      1);
+
+  checkGet(asyncSystem, accessor, server);
+  checkKeepAlive(asyncSystem, accessor, server);
+  checkContentLength(asyncSystem, accessor, server);
+  checkErrors(asyncSystem, accessor, server);
+  checkCancelGroup(asyncSystem, accessor, server);
+
+  accessor.shutdown();
+
+  if (failures > 0) {
+    std::printf("%d checks failed.\n", failures);
+    return 1;
+  }
+
+  std::printf("All checks passed.\n");
+  return 0;
+}
@@ -0,0 +1,29 @@
+#include "AssetRequestKey.h"
+
+#include "AssetRequestCancellation.h"
+
+namespace CesiumForUnityNative {
+
+std::string calculateAssetRequestKey(
+    const std::string& url,
+    const CesiumAsync::HttpHeaders& headers) {
+  auto groupIt = headers.find(AssetRequestCancellation::groupHeader);
+
+  // HttpHeaders is sorted, so the order the headers were given in doesn't
+  // matter.
+  std::string key = url;
+  for (auto it = headers.begin(); it != headers.end(); ++it) {
+    if (it == groupIt) {
+      continue;
+    }
+
+    key += '\n';
+    key += it->first;
+    key += ": ";
+    key += it->second;
+  }
+
+  return key;
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <CesiumAsync/HttpHeaders.h>
+
+#include <string>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Calculates a key that is the same for requests that would get the
+ * same response: requests with the same URL and headers, apart from their
+ * {@link AssetRequestCancellation} group.
+ *
+ * @param url The URL of the request.
+ * @param headers The headers of the request.
+ */
+std::string calculateAssetRequestKey(
+    const std::string& url,
+    const CesiumAsync::HttpHeaders& headers);
+
+} // namespace CesiumForUnityNative
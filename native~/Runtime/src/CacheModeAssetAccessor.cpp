@@ -0,0 +1,274 @@
+#include "CacheModeAssetAccessor.h"
+
+#include "TaskPriority.h"
+
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <ctime>
+#include <optional>
+#include <stdexcept>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The status of responses to requests that can't be answered without the
+// network in CacheOnly mode, as for an HTTP `only-if-cached` request.
+const uint16_t uncachedStatusCode = 504;
+
+class CachedAssetResponse : public IAssetResponse {
+public:
+  CachedAssetResponse(CacheResponse&& response)
+      : _statusCode(response.statusCode),
+        _contentType(),
+        _headers(std::move(response.headers)),
+        _data(std::move(response.data)) {
+    auto it = this->_headers.find("Content-Type");
+    if (it != this->_headers.end()) {
+      this->_contentType = it->second;
+    }
+  }
+
+  virtual uint16_t statusCode() const override { return this->_statusCode; }
+
+  virtual std::string contentType() const override {
+    return this->_contentType;
+  }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return this->_data;
+  }
+
+private:
+  uint16_t _statusCode;
+  std::string _contentType;
+  HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class CachedAssetRequest : public IAssetRequest {
+public:
+  CachedAssetRequest(CacheItem&& item)
+      : _method(std::move(item.cacheRequest.method)),
+        _url(std::move(item.cacheRequest.url)),
+        _headers(std::move(item.cacheRequest.headers)),
+        _response(std::move(item.cacheResponse)) {}
+
+  CachedAssetRequest(
+      const std::string& method,
+      const std::string& url,
+      const std::vector<IAssetAccessor::THeader>& headers)
+      : _method(method),
+        _url(url),
+        _headers(headers.begin(), headers.end()),
+        _response(CacheResponse(
+            uncachedStatusCode,
+            HttpHeaders(),
+            std::vector<std::byte>())) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  CachedAssetResponse _response;
+};
+
+struct NetworkResult {
+  std::shared_ptr<IAssetRequest> pRequest;
+  std::string error;
+};
+
+bool isNetworkFailure(const NetworkResult& result) {
+  if (!result.pRequest) {
+    return true;
+  }
+
+  const IAssetResponse* pResponse = result.pRequest->response();
+  return !pResponse || pResponse->statusCode() == 0 ||
+         pResponse->statusCode() >= 500;
+}
+
+Future<std::optional<CacheItem>> readCache(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<ICacheDatabase>& pDatabase,
+    const std::string& url) {
+  return asyncSystem.runInWorkerThread([pDatabase, url]() {
+    // CachingAssetAccessor keys its entries by URL alone.
+    return pDatabase->getEntry(url);
+  });
+}
+
+} // namespace
+
+CacheModeAssetAccessor::CacheModeAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAccessor,
+    const std::shared_ptr<ICacheDatabase>& pDatabase,
+    CacheMode mode)
+    : _pAccessor(pAccessor),
+      _pDatabase(pDatabase),
+      _mode(mode),
+      _mutex(),
+      _revalidating() {}
+
+Future<std::shared_ptr<IAssetRequest>> CacheModeAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  switch (this->_mode.load()) {
+  case CacheMode::StaleWhileRevalidate:
+    return this->getStaleWhileRevalidate(asyncSystem, url, headers);
+  case CacheMode::CacheOnly:
+    return this->getCacheOnly(asyncSystem, url, headers);
+  case CacheMode::NetworkFirst:
+  default:
+    return this->getNetworkFirst(asyncSystem, url, headers);
+  }
+}
+
+Future<std::shared_ptr<IAssetRequest>> CacheModeAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  if (this->_mode.load() == CacheMode::CacheOnly) {
+    return asyncSystem.createResolvedFuture<std::shared_ptr<IAssetRequest>>(
+        std::make_shared<CachedAssetRequest>(verb, url, headers));
+  }
+
+  return this->_pAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CacheModeAssetAccessor::tick() noexcept { this->_pAccessor->tick(); }
+
+CacheMode CacheModeAssetAccessor::getMode() const noexcept {
+  return this->_mode.load();
+}
+
+void CacheModeAssetAccessor::setMode(CacheMode mode) noexcept {
+  this->_mode = mode;
+}
+
+Future<std::shared_ptr<IAssetRequest>> CacheModeAssetAccessor::getNetworkFirst(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->_pAccessor->get(asyncSystem, url, headers)
+      .thenImmediately([](std::shared_ptr<IAssetRequest>&& pRequest) {
+        return NetworkResult{std::move(pRequest), std::string()};
+      })
+      .catchImmediately([](std::exception&& e) {
+        return NetworkResult{nullptr, e.what()};
+      })
+      .thenImmediately([asyncSystem, pDatabase = this->_pDatabase, url](
+                           NetworkResult&& result) {
+        if (!isNetworkFailure(result)) {
+          return asyncSystem.createResolvedFuture(std::move(result.pRequest));
+        }
+
+        // Fall back on the cached response, however stale it is.
+        return readCache(asyncSystem, pDatabase, url)
+            .thenImmediately(
+                [result = std::move(result)](
+                    std::optional<CacheItem>&& maybeItem) mutable
+                -> std::shared_ptr<IAssetRequest> {
+                  if (maybeItem) {
+                    return std::make_shared<CachedAssetRequest>(
+                        std::move(*maybeItem));
+                  }
+                  if (!result.pRequest) {
+                    throw std::runtime_error(result.error);
+                  }
+                  return std::move(result.pRequest);
+                });
+      });
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+CacheModeAssetAccessor::getStaleWhileRevalidate(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return readCache(asyncSystem, this->_pDatabase, url)
+      .thenImmediately([pThis = this->shared_from_this(),
+                        asyncSystem,
+                        url,
+                        headers](std::optional<CacheItem>&& maybeItem) {
+        if (!maybeItem) {
+          return pThis->_pAccessor->get(asyncSystem, url, headers);
+        }
+
+        if (maybeItem->expiryTime < std::time(nullptr)) {
+          pThis->revalidate(asyncSystem, url, headers);
+        }
+
+        return asyncSystem.createResolvedFuture<std::shared_ptr<IAssetRequest>>(
+            std::make_shared<CachedAssetRequest>(std::move(*maybeItem)));
+      });
+}
+
+Future<std::shared_ptr<IAssetRequest>> CacheModeAssetAccessor::getCacheOnly(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return readCache(asyncSystem, this->_pDatabase, url)
+      .thenImmediately(
+          [url, headers](std::optional<CacheItem>&& maybeItem)
+              -> std::shared_ptr<IAssetRequest> {
+            if (maybeItem) {
+              return std::make_shared<CachedAssetRequest>(
+                  std::move(*maybeItem));
+            }
+            return std::make_shared<CachedAssetRequest>("GET", url, headers);
+          });
+}
+
+void CacheModeAssetAccessor::revalidate(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (!this->_revalidating.insert(url).second) {
+      // Already being refreshed.
+      return;
+    }
+  }
+
+  // The refresh holds on to the accessor, because nothing else that outlives
+  // it is guaranteed to.
+  auto finish = [pThis = this->shared_from_this(), url]() {
+    std::lock_guard<std::mutex> lock(pThis->_mutex);
+    pThis->_revalidating.erase(url);
+  };
+
+  // The caching accessor revalidates the stale entry and stores the result,
+  // which is all that's wanted here. Nothing is waiting on it, so it mustn't
+  // hold up tiles that are.
+  TaskPriorityScope priorityScope(TaskPriority::Background);
+  this->_pAccessor->get(asyncSystem, url, headers)
+      .thenImmediately([finish](std::shared_ptr<IAssetRequest>&&) { finish(); })
+      .catchImmediately([finish](std::exception&&) { finish(); });
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/ICacheDatabase.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief How requests use the disk cache and the network.
+ */
+enum class CacheMode {
+  /**
+   * @brief Requests go to the network whenever the cached response is missing
+   * or stale. If the network fails, a stale cached response is used instead.
+   */
+  NetworkFirst,
+
+  /**
+   * @brief Cached responses are used immediately, even when stale. Stale ones
+   * are refreshed from the network in the background for next time.
+   */
+  StaleWhileRevalidate,
+
+  /**
+   * @brief Requests never go to the network. Responses that aren't cached
+   * fail with status 504.
+   */
+  CacheOnly
+};
+
+/**
+ * @brief An asset accessor that decides, according to a {@link CacheMode}
+ * that can be changed at any time, whether requests are answered from the
+ * disk cache or passed on to a {@link CesiumAsync::CachingAssetAccessor}.
+ *
+ * It reads the same cache database as the caching accessor, so that it can
+ * serve responses that the caching accessor would consider too stale to use
+ * without the network.
+ *
+ * Background refreshes keep the accessor alive until they finish, so it must
+ * be created with `std::make_shared`.
+ */
+class CacheModeAssetAccessor
+    : public CesiumAsync::IAssetAccessor,
+      public std::enable_shared_from_this<CacheModeAssetAccessor> {
+public:
+  /**
+   * @brief Creates a new accessor.
+   *
+   * @param pAccessor The caching accessor to pass requests on to.
+   * @param pDatabase The database that `pAccessor` caches responses in.
+   * @param mode The mode to start in.
+   */
+  CacheModeAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAccessor,
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+      CacheMode mode);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers = {}) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers = std::vector<THeader>(),
+      const gsl::span<const std::byte>& contentPayload = {}) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Gets the mode that new requests are made in.
+   */
+  CacheMode getMode() const noexcept;
+
+  /**
+   * @brief Sets the mode that new requests are made in. Requests that are
+   * already in progress aren't affected.
+   */
+  void setMode(CacheMode mode) noexcept;
+
+private:
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  getNetworkFirst(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers);
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  getStaleWhileRevalidate(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers);
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  getCacheOnly(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers);
+  void revalidate(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAccessor;
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pDatabase;
+  std::atomic<CacheMode> _mode;
+
+  std::mutex _mutex;
+  // The URLs that are being refreshed in the background.
+  std::unordered_set<std::string> _revalidating;
+};
+
+} // namespace CesiumForUnityNative
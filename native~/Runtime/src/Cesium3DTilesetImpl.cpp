@@ -1,6 +1,14 @@
 #include "Cesium3DTilesetImpl.h"
 
+#include "AssetRequestCancellation.h"
 #include "CameraManager.h"
+#include "MainThreadBudget.h"
+#include "MainThreadDispatcher.h"
+#include "RendererResourceMemory.h"
+#include "ScreenSpaceErrorGovernor.h"
+#include "StatisticsReport.h"
+#include "TileDestructionQueue.h"
+#include "TileMemoryBudget.h"
 #include "UnityPrepareRendererResources.h"
 #include "UnityTileExcluderAdaptor.h"
 #include "UnityTilesetExternals.h"
@@ -14,8 +22,10 @@
 #include <DotNet/CesiumForUnity/Cesium3DTilesetLoadType.h>
 #include <DotNet/CesiumForUnity/CesiumDataSource.h>
 #include <DotNet/CesiumForUnity/CesiumGeoreference.h>
+#include <DotNet/CesiumForUnity/CesiumObjectPools.h>
 #include <DotNet/CesiumForUnity/CesiumRasterOverlay.h>
 #include <DotNet/CesiumForUnity/CesiumRuntimeSettings.h>
+#include <DotNet/CesiumForUnity/CesiumSizeClassPool1.h>
 #include <DotNet/CesiumForUnity/CesiumTileExcluder.h>
 #include <DotNet/System/Action.h>
 #include <DotNet/System/Array1.h>
@@ -28,12 +38,15 @@
 #include <DotNet/UnityEngine/Experimental/Rendering/GraphicsFormat.h>
 #include <DotNet/UnityEngine/GameObject.h>
 #include <DotNet/UnityEngine/Material.h>
+#include <DotNet/UnityEngine/Mesh.h>
 #include <DotNet/UnityEngine/Quaternion.h>
 #include <DotNet/UnityEngine/SystemInfo.h>
 #include <DotNet/UnityEngine/Time.h>
 #include <DotNet/UnityEngine/Transform.h>
 #include <DotNet/UnityEngine/Vector3.h>
 
+#include <algorithm>
+#include <chrono>
 #include <variant>
 
 #if UNITY_EDITOR
@@ -47,6 +60,32 @@ using namespace DotNet;
 
 namespace CesiumForUnityNative {
 
+namespace {
+
+// Generous per-frame time limit for each tileset's loading and unloading on
+// the main thread, when the limits aren't adapted to the frame rate.
+const double fixedMainThreadTimeLimit = 5.0;
+
+// The least time left to cesium-native's main thread loading, which would
+// take a time limit of zero as no limit at all. This still loads one tile.
+const double minimumMainThreadLoadingTimeLimit = 0.01;
+
+// The frame rates that Unity aims for when Application.targetFrameRate is
+// left at its default.
+const int32_t defaultMobileFrameRate = 30;
+const int32_t defaultFrameRate = 60;
+
+int32_t getTargetFrameRate() {
+  int32_t targetFrameRate = UnityEngine::Application::targetFrameRate();
+  if (targetFrameRate > 0) {
+    return targetFrameRate;
+  }
+  return UnityEngine::Application::isMobilePlatform() ? defaultMobileFrameRate
+                                                      : defaultFrameRate;
+}
+
+} // namespace
+
 Cesium3DTilesetImpl::Cesium3DTilesetImpl(
     const DotNet::CesiumForUnity::Cesium3DTileset& tileset)
     : _pTileset(),
@@ -55,6 +94,14 @@ Cesium3DTilesetImpl::Cesium3DTilesetImpl(
       _updateInEditorCallback(nullptr),
 #endif
       _creditSystem(nullptr),
+      _pDestructionQueue(std::make_shared<TileDestructionQueue>()),
+      _pResourceMemory(std::make_shared<RendererResourceMemory>()),
+      _colliderManager(),
+      _screenSpaceErrorGovernor(),
+      _overlaySubTileCacheBytes(),
+      _maximumTileBytes(0),
+      _requestGroup(0),
+      _pTaskProcessor(),
       _destroyTilesetOnNextUpdate(false),
       _lastOpaqueMaterialHash(0) {
 }
@@ -76,8 +123,74 @@ void Cesium3DTilesetImpl::Update(
     const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
   assert(tileset.enabled());
 
+  const auto updateStart = std::chrono::steady_clock::now();
+
+  // Outside of play mode, the editor doesn't advance the frame count on every
+  // update, so time limits can't be shared by the updates of a frame.
+  int32_t frame = UnityEngine::Time::frameCount();
+#if UNITY_EDITOR
+  if (!UnityEditor::EditorApplication::isPlaying()) {
+    frame = -1;
+  }
+#endif
+
+  // All tilesets share one budget for loading and unloading on the main
+  // thread, which follows the frame rate.
+  MainThreadBudget::Allocation budget{
+      fixedMainThreadTimeLimit,
+      fixedMainThreadTimeLimit};
+  const bool adaptBudget =
+      frame >= 0 &&
+      CesiumForUnity::CesiumRuntimeSettings::useAdaptiveMainThreadBudget();
+  if (adaptBudget) {
+    budget = MainThreadBudget::beginUpdate(
+        frame,
+        this,
+        1000.0 * UnityEngine::Time::unscaledDeltaTime(),
+        getTargetFrameRate());
+  }
+
+  // Every update that began with a share of the budget reports back, even if
+  // it returns early, so that it's counted in the next frame's shares.
+  auto endBudgetUpdate = [this, adaptBudget, updateStart](
+                             size_t loadQueueLength,
+                             size_t mainThreadLoadQueueLength) {
+    if (adaptBudget) {
+      MainThreadBudget::endUpdate(
+          this,
+          std::chrono::duration<double, std::milli>(
+              std::chrono::steady_clock::now() - updateStart)
+              .count(),
+          loadQueueLength,
+          mainThreadLoadQueueLength);
+    }
+  };
+
+  // Keep destroying unloaded tiles even when updates are suspended.
+  this->_pDestructionQueue->processQueue(budget.unloadingMilliseconds);
+
+  // The main thread work of loading tiles is queued across all tilesets.
+  // With an adaptive budget, the work done in this update comes out of this
+  // tileset's share of the loading budget, and whatever is left goes to
+  // finishing loaded tiles below. Otherwise, every tileset's update shares
+  // the frame's fixed time limit, and a negative frame gives each update the
+  // whole time limit instead.
+  if (adaptBudget) {
+    const double dispatchMilliseconds =
+        MainThreadDispatcher::dispatch(frame, 0.0, budget.loadingMilliseconds);
+    budget.loadingMilliseconds = std::max(
+        budget.loadingMilliseconds - dispatchMilliseconds,
+        minimumMainThreadLoadingTimeLimit);
+  } else {
+    MainThreadDispatcher::dispatch(
+        frame,
+        CesiumForUnity::CesiumRuntimeSettings::mainThreadTaskTimeLimit(),
+        0.0);
+  }
+
   // If "Suspend Update" is true, return early.
   if (tileset.suspendUpdate()) {
+    endBudgetUpdate(0, 0);
     return;
   }
 
@@ -91,6 +204,7 @@ void Cesium3DTilesetImpl::Update(
       !UnityEditor::EditorApplication::isPlaying()) {
     // If "Update In Editor" is false, return early.
     if (!tileset.updateInEditor()) {
+      endBudgetUpdate(0, 0);
       return;
     }
 
@@ -109,8 +223,32 @@ void Cesium3DTilesetImpl::Update(
 
   if (!this->_pTileset) {
     this->LoadTileset(tileset);
-    if (!this->_pTileset)
+    if (!this->_pTileset) {
+      endBudgetUpdate(0, 0);
       return;
+    }
+  }
+
+  // Unloading tiles from the cache only hides them and queues them for
+  // destruction, so it gets the same time limit as the destruction queue.
+  TilesetOptions& options = this->_pTileset->getOptions();
+  options.mainThreadLoadingTimeLimit = budget.loadingMilliseconds;
+  options.tileCacheUnloadTimeLimit = budget.unloadingMilliseconds;
+
+  this->updateMemoryBudget(tileset, frame);
+
+  // Frame times outside of play mode say little about the frame rate.
+  if (frame >= 0 && tileset.adaptScreenSpaceError()) {
+    options.maximumScreenSpaceError = this->_screenSpaceErrorGovernor.update(
+        tileset.maximumScreenSpaceError(),
+        tileset.maximumAdaptiveScreenSpaceError(),
+        1000.0 * UnityEngine::Time::unscaledDeltaTime(),
+        1000.0 / getTargetFrameRate(),
+        this->getTileBytes(),
+        this->_maximumTileBytes);
+  } else if (this->_screenSpaceErrorGovernor.getScreenSpaceError() > 0.0) {
+    this->_screenSpaceErrorGovernor.reset();
+    options.maximumScreenSpaceError = tileset.maximumScreenSpaceError();
   }
 
   std::vector<ViewState> viewStates =
@@ -121,6 +259,23 @@ void Cesium3DTilesetImpl::Update(
       DotNet::UnityEngine::Time::deltaTime());
   this->updateLastViewUpdateResultState(tileset, updateResult);
 
+  TileMemoryBudget::report(
+      this,
+      this->getTileBytes(),
+      updateResult.tilesToRenderThisFrame.size());
+
+  // When everything the tileset visited was culled, it is only loading tiles
+  // in case they come into view, so tilesets that are in view go first.
+  bool inView = !updateResult.tilesToRenderThisFrame.empty() ||
+                updateResult.tilesCulled == 0;
+  this->_pTaskProcessor->setPriority(
+      inView ? TaskPriority::Visible : TaskPriority::Prefetch);
+
+  if (tileset.createPhysicsMeshes() &&
+      tileset.limitPhysicsMeshesToInterestPoints()) {
+    this->_colliderManager.update(tileset, *this->_pTileset, updateResult);
+  }
+
   for (auto pTile : updateResult.tilesFadingOut) {
     if (pTile->getState() != TileLoadState::Done) {
       continue;
@@ -156,6 +311,11 @@ void Cesium3DTilesetImpl::Update(
       }
     }
   }
+
+  endBudgetUpdate(
+      updateResult.workerThreadTileLoadQueueLength +
+          updateResult.mainThreadTileLoadQueueLength,
+      updateResult.mainThreadTileLoadQueueLength);
 }
 
 void Cesium3DTilesetImpl::OnValidate(
@@ -341,12 +501,33 @@ void Cesium3DTilesetImpl::setCreditSystem(
   this->_creditSystem = creditSystem;
 }
 
+const std::shared_ptr<TileDestructionQueue>&
+Cesium3DTilesetImpl::getDestructionQueue() const {
+  return this->_pDestructionQueue;
+}
+
+const std::shared_ptr<RendererResourceMemory>&
+Cesium3DTilesetImpl::getResourceMemory() const {
+  return this->_pResourceMemory;
+}
+
+uint64_t Cesium3DTilesetImpl::getRequestGroup() const {
+  return this->_requestGroup;
+}
+
+const std::shared_ptr<PrioritizedTaskProcessor>&
+Cesium3DTilesetImpl::getTaskProcessor() const {
+  return this->_pTaskProcessor;
+}
+
 void Cesium3DTilesetImpl::updateLastViewUpdateResultState(
     const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
     const Cesium3DTilesSelection::ViewUpdateResult& currentResult) {
   if (!tileset.logSelectionStats())
     return;
 
+  StatisticsReport::logIfDue(this->_pTileset->getExternals().pLogger);
+
   const ViewUpdateResult& previousResult = this->_lastUpdateResult;
   if (currentResult.tilesToRenderThisFrame.size() !=
           previousResult.tilesToRenderThisFrame.size() ||
@@ -362,7 +543,9 @@ void Cesium3DTilesetImpl::updateLastViewUpdateResultState(
         this->_pTileset->getExternals().pLogger,
         "{0}: Visited {1}, Culled Visited {2}, Rendered {3}, Culled {4}, Max "
         "Depth Visited {5}, Loading-Worker {6}, Loading-Main {7} "
-        "Total Tiles Resident {8}, Frame {9}",
+        "Total Tiles Resident {8}, Frame {9}, Screen Space Error {10:.1f}, "
+        "Tile Bytes {11} (Allowed {12}, Unity Objects {13}), Released glTF "
+        "Bytes {14}",
         tileset.gameObject().name().ToStlString(),
         currentResult.tilesVisited,
         currentResult.culledTilesVisited,
@@ -372,12 +555,98 @@ void Cesium3DTilesetImpl::updateLastViewUpdateResultState(
         currentResult.workerThreadTileLoadQueueLength,
         currentResult.mainThreadTileLoadQueueLength,
         this->_pTileset->getNumberOfTilesLoaded(),
-        currentResult.frameNumber);
+        currentResult.frameNumber,
+        this->_pTileset->getOptions().maximumScreenSpaceError,
+        this->getTileBytes(),
+        this->_maximumTileBytes,
+        this->_pResourceMemory->getBytes(),
+        this->_pResourceMemory->getReleasedGltfBytes());
   }
 
   this->_lastUpdateResult = currentResult;
 }
 
+void Cesium3DTilesetImpl::updateMemoryBudget(
+    const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+    int32_t frame) {
+  TilesetOptions& options = this->_pTileset->getOptions();
+  const int64_t configuredBytes = tileset.maximumCachedBytes();
+  int64_t budgetBytes =
+      CesiumForUnity::CesiumRuntimeSettings::tileMemoryBudgetBytes();
+
+  // Outside of play mode, frames are too irregular to share the budget by.
+  const bool useBudget = frame >= 0 && budgetBytes > 0;
+  if (useBudget) {
+    // The meshes in the mesh pool keep their buffers, and belong to no
+    // tileset, so they come off the top of the budget.
+    const int64_t pooledMeshBytes =
+        CesiumForUnity::CesiumObjectPools::MeshPool().InactiveBytes();
+    budgetBytes = std::max(budgetBytes - pooledMeshBytes, int64_t(0));
+  }
+  const bool leftBudget = !useBudget && TileMemoryBudget::remove(this);
+  this->_maximumTileBytes = configuredBytes;
+  if (useBudget) {
+    this->_maximumTileBytes = TileMemoryBudget::getAllowedBytes(
+        frame,
+        this,
+        budgetBytes,
+        configuredBytes);
+  }
+
+  // The tileset only counts the glTFs and images that its tiles are loaded
+  // from, so its limit is cut by the share of the tiles' memory that the Unity
+  // objects created from them take. It also still counts the glTF data that
+  // was released from its tiles, so that is added back on.
+  const int64_t releasedBytes = this->_pResourceMemory->getReleasedGltfBytes();
+  const int64_t dataBytes =
+      this->_pTileset->getTotalDataBytes() - releasedBytes;
+  const int64_t tileBytes = this->getTileBytes();
+  int64_t maximumDataBytes = this->_maximumTileBytes;
+  if (tileBytes > 0) {
+    maximumDataBytes = int64_t(
+        double(this->_maximumTileBytes) * double(dataBytes) /
+        double(tileBytes));
+  }
+  options.maximumCachedBytes = maximumDataBytes + releasedBytes;
+
+  if (!useBudget && !leftBudget) {
+    return;
+  }
+
+  // The raster overlays' caches of the tiles they're made from shrink along
+  // with the tileset's.
+  double overlayScale = 1.0;
+  if (useBudget) {
+    overlayScale = configuredBytes > 0 ? double(this->_maximumTileBytes) /
+                                             double(configuredBytes)
+                                       : 0.0;
+  }
+
+  std::unordered_map<const RasterOverlay*, int64_t> subTileCacheBytes;
+  for (const CesiumUtility::IntrusivePointer<RasterOverlay>& pOverlay :
+       this->_pTileset->getOverlays()) {
+    auto it = this->_overlaySubTileCacheBytes.find(pOverlay.get());
+    const int64_t configured = it != this->_overlaySubTileCacheBytes.end()
+                                   ? it->second
+                                   : pOverlay->getOptions().subTileCacheBytes;
+    pOverlay->getOptions().subTileCacheBytes =
+        int64_t(overlayScale * double(configured));
+    subTileCacheBytes.emplace(pOverlay.get(), configured);
+  }
+
+  if (useBudget) {
+    this->_overlaySubTileCacheBytes = std::move(subTileCacheBytes);
+  } else {
+    this->_overlaySubTileCacheBytes.clear();
+  }
+}
+
+int64_t Cesium3DTilesetImpl::getTileBytes() const {
+  return this->_pTileset->getTotalDataBytes() -
+         this->_pResourceMemory->getReleasedGltfBytes() +
+         this->_pResourceMemory->getBytes();
+}
+
 void Cesium3DTilesetImpl::DestroyTileset(
     const DotNet::CesiumForUnity::Cesium3DTileset& tileset) {
   // Remove any existing raster overlays
@@ -388,7 +657,33 @@ void Cesium3DTilesetImpl::DestroyTileset(
     overlay.RemoveFromTileset();
   }
 
-  this->_pTileset.reset();
+  // Nothing that the tileset is still downloading will be used, so stop
+  // spending bandwidth on it. This is the only time requests are cancelled.
+  // The requests of tiles that merely leave the view are left to finish,
+  // because cesium-native never retries a tile whose request failed.
+  if (this->_requestGroup != 0) {
+    AssetRequestCancellation::cancelGroup(this->_requestGroup);
+    this->_requestGroup = 0;
+  }
+
+  // The tileset's destructor waits for its loads in progress by running only
+  // its own main thread tasks, so hand back the ones queued in the dispatcher.
+  if (this->_pTaskProcessor) {
+    MainThreadDispatcher::beginDraining(this->_pTaskProcessor.get());
+    this->_pTileset.reset();
+    MainThreadDispatcher::endDraining(this->_pTaskProcessor.get());
+  } else {
+    this->_pTileset.reset();
+  }
+
+  // The whole tileset is going away, so there's no point in spreading the
+  // destruction of its tiles over multiple frames.
+  this->_pDestructionQueue->flush();
+  this->_pResourceMemory->clearReleasedGltfBytes();
+  this->_colliderManager.reset();
+  this->_screenSpaceErrorGovernor.reset();
+  TileMemoryBudget::remove(this);
+  this->_overlaySubTileCacheBytes.clear();
 }
 
 void Cesium3DTilesetImpl::LoadTileset(
@@ -422,9 +717,10 @@ void Cesium3DTilesetImpl::LoadTileset(
             unityDetails);
       };
 
-  // Generous per-frame time limits for loading / unloading on main thread.
-  options.mainThreadLoadingTimeLimit = 5.0;
-  options.tileCacheUnloadTimeLimit = 5.0;
+  // These are replaced with the tileset's share of the main thread budget on
+  // every update.
+  options.mainThreadLoadingTimeLimit = fixedMainThreadTimeLimit;
+  options.tileCacheUnloadTimeLimit = fixedMainThreadTimeLimit;
 
   TilesetContentOptions contentOptions{};
   contentOptions.generateMissingNormalsSmooth = tileset.generateSmoothNormals();
@@ -486,6 +782,8 @@ void Cesium3DTilesetImpl::LoadTileset(
   options.contentOptions = contentOptions;
 
   this->_lastUpdateResult = ViewUpdateResult();
+  this->_requestGroup = AssetRequestCancellation::createGroup();
+  this->_pTaskProcessor = createTaskProcessor(TaskPriority::Visible);
 
   if (tileset.tilesetSource() ==
       CesiumForUnity::CesiumDataSource::FromCesiumIon) {
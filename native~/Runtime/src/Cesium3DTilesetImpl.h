@@ -1,12 +1,18 @@
 #pragma once
 
+#include "ScreenSpaceErrorGovernor.h"
+#include "TaskPriority.h"
+#include "TileColliderManager.h"
+
 #include <Cesium3DTilesSelection/ViewUpdateResult.h>
 
 #include <DotNet/CesiumForUnity/CesiumCreditSystem.h>
 #include <DotNet/CesiumForUnity/CesiumGeoreference.h>
 #include <DotNet/System/Action.h>
 
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 
 #if UNITY_EDITOR
 #include <DotNet/UnityEditor/CallbackFunction.h>
@@ -18,11 +24,15 @@ class CesiumCreditSystem;
 } // namespace DotNet::CesiumForUnity
 
 namespace Cesium3DTilesSelection {
+class RasterOverlay;
 class Tileset;
-}
+} // namespace Cesium3DTilesSelection
 
 namespace CesiumForUnityNative {
 
+class RendererResourceMemory;
+class TileDestructionQueue;
+
 class Cesium3DTilesetImpl {
 public:
   Cesium3DTilesetImpl(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
@@ -47,6 +57,27 @@ public:
   void setCreditSystem(
       const DotNet::CesiumForUnity::CesiumCreditSystem& creditSystem);
 
+  const std::shared_ptr<TileDestructionQueue>& getDestructionQueue() const;
+
+  /**
+   * @brief Gets the count of the memory used by the Unity objects that are
+   * created for the tileset's tiles and raster overlay tiles.
+   */
+  const std::shared_ptr<RendererResourceMemory>& getResourceMemory() const;
+
+  /**
+   * @brief Gets the group of the requests made for the current tileset, which
+   * are cancelled when it is destroyed.
+   */
+  uint64_t getRequestGroup() const;
+
+  /**
+   * @brief Gets the task processor that the current tileset's worker thread
+   * tasks are started with, whose priority follows whether the tileset is in
+   * view.
+   */
+  const std::shared_ptr<PrioritizedTaskProcessor>& getTaskProcessor() const;
+
 private:
   void DestroyTileset(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
   void LoadTileset(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
@@ -54,12 +85,41 @@ private:
       const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
       const Cesium3DTilesSelection::ViewUpdateResult& currentResult);
 
+  /**
+   * @brief Sets the tileset's and its raster overlays' cache sizes from its
+   * share of the memory budget of all tilesets, or back to what they're
+   * configured to be when there is no budget. The tileset's cache size leaves
+   * room for the Unity objects that are created for its tiles.
+   */
+  void updateMemoryBudget(
+      const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+      int32_t frame);
+
+  /**
+   * @brief Gets the memory used by the tileset's tiles and raster overlay
+   * tiles, including the Unity objects created for them, in bytes.
+   */
+  int64_t getTileBytes() const;
+
   std::unique_ptr<Cesium3DTilesSelection::Tileset> _pTileset;
   Cesium3DTilesSelection::ViewUpdateResult _lastUpdateResult;
 #if UNITY_EDITOR
   DotNet::UnityEditor::CallbackFunction _updateInEditorCallback;
 #endif
   DotNet::CesiumForUnity::CesiumCreditSystem _creditSystem;
+  std::shared_ptr<TileDestructionQueue> _pDestructionQueue;
+  std::shared_ptr<RendererResourceMemory> _pResourceMemory;
+  TileColliderManager _colliderManager;
+  ScreenSpaceErrorGovernor _screenSpaceErrorGovernor;
+  // The configured sub-tile cache sizes of the raster overlays, while they
+  // are scaled down to fit the memory budget.
+  std::unordered_map<const Cesium3DTilesSelection::RasterOverlay*, int64_t>
+      _overlaySubTileCacheBytes;
+  // The memory that the tileset's tiles may use, including the Unity objects
+  // created for them, in bytes.
+  int64_t _maximumTileBytes;
+  uint64_t _requestGroup;
+  std::shared_ptr<PrioritizedTaskProcessor> _pTaskProcessor;
   bool _destroyTilesetOnNextUpdate;
   int32_t _lastOpaqueMaterialHash;
 };
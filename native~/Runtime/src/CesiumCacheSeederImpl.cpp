@@ -0,0 +1,471 @@
+#include "CesiumCacheSeederImpl.h"
+
+#include "AssetRequestCancellation.h"
+#include "UnityTilesetExternals.h"
+
+#include <Cesium3DTilesSelection/IPrepareRendererResources.h>
+#include <Cesium3DTilesSelection/IonRasterOverlay.h>
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GlobeTransforms.h>
+#include <CesiumUtility/Math.h>
+
+#include <DotNet/CesiumForUnity/CesiumCacheSeeder.h>
+#include <DotNet/CesiumForUnity/CesiumDataSource.h>
+#include <DotNet/CesiumForUnity/CesiumRuntimeSettings.h>
+#include <DotNet/System/Collections/Generic/List1.h>
+#include <DotNet/System/String.h>
+#include <DotNet/Unity/Mathematics/double3.h>
+#include <DotNet/UnityEngine/Application.h>
+#include <glm/trigonometric.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+using namespace DotNet;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// How many updates in a row must find nothing left to load before a view is
+// considered complete. Loading one tile can reveal that its children are
+// needed, and they're only requested by the next update.
+const int32_t requiredIdleUpdates = 2;
+
+// How much of each view's footprint overlaps its neighbors' when covering a
+// region, so that no tiles are missed between them.
+const double footprintOverlap = 0.1;
+
+// Seeding a region this finely would take days, and is almost certainly a
+// mistake in the region or view height.
+const size_t maximumViews = 100000;
+
+/**
+ * @brief Prepares nothing, because the seeder's tiles are never rendered.
+ */
+class SeedingPrepareRendererResources : public IPrepareRendererResources {
+public:
+  virtual CesiumAsync::Future<TileLoadResultAndRenderResources>
+  prepareInLoadThread(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      TileLoadResult&& tileLoadResult,
+      const glm::dmat4& /*transform*/,
+      const std::any& /*rendererOptions*/) override {
+    return asyncSystem.createResolvedFuture(
+        TileLoadResultAndRenderResources{std::move(tileLoadResult), nullptr});
+  }
+
+  virtual void*
+  prepareInMainThread(Tile& /*tile*/, void* /*pLoadThreadResult*/) override {
+    return nullptr;
+  }
+
+  virtual void free(
+      Tile& /*tile*/,
+      void* /*pLoadThreadResult*/,
+      void* /*pMainThreadResult*/) noexcept override {}
+
+  virtual void* prepareRasterInLoadThread(
+      CesiumGltf::ImageCesium& /*image*/,
+      const std::any& /*rendererOptions*/) override {
+    return nullptr;
+  }
+
+  virtual void* prepareRasterInMainThread(
+      RasterOverlayTile& /*rasterTile*/,
+      void* /*pLoadThreadResult*/) override {
+    return nullptr;
+  }
+
+  virtual void freeRaster(
+      const RasterOverlayTile& /*rasterTile*/,
+      void* /*pLoadThreadResult*/,
+      void* /*pMainThreadResult*/) noexcept override {}
+
+  virtual void attachRasterInMainThread(
+      const Tile& /*tile*/,
+      int32_t /*overlayTextureCoordinateID*/,
+      const RasterOverlayTile& /*rasterTile*/,
+      void* /*pMainThreadRendererResources*/,
+      const glm::dvec2& /*translation*/,
+      const glm::dvec2& /*scale*/) override {}
+
+  virtual void detachRasterInMainThread(
+      const Tile& /*tile*/,
+      int32_t /*overlayTextureCoordinateID*/,
+      const RasterOverlayTile& /*rasterTile*/,
+      void* /*pMainThreadRendererResources*/) noexcept override {}
+};
+
+/**
+ * @brief Creates the view of a camera at the given position looking straight
+ * down, with north at the top of the viewport.
+ */
+ViewState createNadirView(
+    const Cartographic& position,
+    const glm::dvec2& viewportSize,
+    double verticalFieldOfView) {
+  glm::dvec3 cameraPosition =
+      Ellipsoid::WGS84.cartographicToCartesian(position);
+  glm::dmat4 eastNorthUp = glm::dmat4(
+      GlobeTransforms::eastNorthUpToFixedFrame(cameraPosition));
+  glm::dvec3 north = glm::dvec3(eastNorthUp[1]);
+  glm::dvec3 up = glm::dvec3(eastNorthUp[2]);
+
+  double aspect = viewportSize.x / viewportSize.y;
+  double horizontalFieldOfView =
+      2 * glm::atan(aspect * glm::tan(verticalFieldOfView * 0.5));
+
+  return ViewState::create(
+      cameraPosition,
+      -up,
+      north,
+      viewportSize,
+      horizontalFieldOfView,
+      verticalFieldOfView);
+}
+
+/**
+ * @brief Gets the positions of cameras at the given height whose views
+ * together cover a region. Returns an empty vector if there would be more than
+ * {@link maximumViews}.
+ */
+std::vector<Cartographic> coverRegion(
+    double west,
+    double south,
+    double east,
+    double north,
+    double height,
+    double fieldOfView) {
+  std::vector<Cartographic> result;
+
+  // The width of the ground that a camera sees across the narrower dimension
+  // of its viewport.
+  double footprint = 2.0 * height * glm::tan(fieldOfView * 0.5);
+  double spacing = footprint * (1.0 - footprintOverlap);
+  double radius = Ellipsoid::WGS84.getMaximumRadius();
+
+  double width = east - west;
+  if (width < 0.0) {
+    // The region crosses the antimeridian.
+    width += Math::TwoPi;
+  }
+  double latitudeRange = std::max(north - south, 0.0);
+
+  size_t rows = std::max(
+      size_t(std::ceil(latitudeRange * radius / spacing)),
+      size_t(1));
+  double rowHeight = latitudeRange / double(rows);
+  for (size_t row = 0; row < rows; ++row) {
+    double latitude = south + (double(row) + 0.5) * rowHeight;
+
+    // Meridians converge towards the poles, so fewer views are needed to
+    // cover a row there.
+    double rowRadius = radius * std::max(std::cos(latitude), 1e-3);
+    size_t columns = std::max(
+        size_t(std::ceil(width * rowRadius / spacing)),
+        size_t(1));
+    if (result.size() + columns > maximumViews) {
+      return std::vector<Cartographic>();
+    }
+
+    double columnWidth = width / double(columns);
+    for (size_t column = 0; column < columns; ++column) {
+      double longitude = west + (double(column) + 0.5) * columnWidth;
+      if (longitude > Math::OnePi) {
+        longitude -= Math::TwoPi;
+      }
+      result.emplace_back(longitude, latitude, height);
+    }
+  }
+
+  return result;
+}
+
+void hashBytes(uint64_t& hash, const void* pData, size_t size) {
+  // FNV-1a, which unlike std::hash is the same on every platform and run.
+  const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= pBytes[i];
+    hash *= 0x100000001b3;
+  }
+}
+
+void hashString(uint64_t& hash, const std::string& value) {
+  hashBytes(hash, value.data(), value.size());
+  hashBytes(hash, "", 1);
+}
+
+} // namespace
+
+CesiumCacheSeederImpl::CesiumCacheSeederImpl(
+    const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder)
+    : _pTileset(),
+      _views(),
+      _nextView(0),
+      _idleUpdates(0),
+      _requestGroup(0),
+      _failed(false),
+      _progressPath() {}
+
+CesiumCacheSeederImpl::~CesiumCacheSeederImpl() { this->destroyTileset(); }
+
+void CesiumCacheSeederImpl::BeginSeeding(
+    const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder) {
+  this->destroyTileset();
+  this->_views.clear();
+  this->_nextView = 0;
+  this->_idleUpdates = 0;
+  this->_failed = false;
+
+  const std::shared_ptr<spdlog::logger>& pLogger = spdlog::default_logger();
+
+  if (getCacheMode() == CacheMode::CacheOnly) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "The cache can't be seeded while its mode is CacheOnly, because no "
+        "requests reach the network.");
+    return;
+  }
+
+  glm::dvec2 viewportSize(
+      std::max(seeder.viewportWidth(), int32_t(1)),
+      std::max(seeder.viewportHeight(), int32_t(1)));
+  double verticalFieldOfView =
+      Math::degreesToRadians(double(seeder.fieldOfView()));
+  double horizontalFieldOfView = 2 * glm::atan(
+                                         viewportSize.x / viewportSize.y *
+                                         glm::tan(verticalFieldOfView * 0.5));
+
+  std::vector<Cartographic> positions;
+  System::Collections::Generic::List1<Unity::Mathematics::double3>
+      viewPositions = seeder.viewPositions();
+  if (viewPositions != nullptr && viewPositions.Count() > 0) {
+    for (int32_t i = 0, len = viewPositions.Count(); i < len; ++i) {
+      Unity::Mathematics::double3 position = viewPositions[i];
+      positions.emplace_back(
+          Cartographic::fromDegrees(position.x, position.y, position.z));
+    }
+  } else {
+    positions = coverRegion(
+        Math::degreesToRadians(seeder.west()),
+        Math::degreesToRadians(seeder.south()),
+        Math::degreesToRadians(seeder.east()),
+        Math::degreesToRadians(seeder.north()),
+        std::max(seeder.viewHeight(), 1.0),
+        std::min(verticalFieldOfView, horizontalFieldOfView));
+    if (positions.empty()) {
+      SPDLOG_LOGGER_ERROR(
+          pLogger,
+          "Covering the region to seed would take more than {} views. Raise "
+          "the view height or shrink the region.",
+          maximumViews);
+      return;
+    }
+  }
+
+  // Identify the job by everything that affects which tiles it downloads, so
+  // that only the same job resumes from its saved progress.
+  CesiumForUnity::CesiumDataSource source = seeder.tilesetSource();
+  int64_t ionAssetID = seeder.ionAssetID();
+  int64_t overlayAssetID = seeder.rasterOverlayIonAssetID();
+  float maximumScreenSpaceError = seeder.maximumScreenSpaceError();
+  std::string url = seeder.url().ToStlString();
+
+  uint64_t hash = 0xcbf29ce484222325;
+  hashBytes(hash, &source, sizeof(source));
+  if (source == CesiumForUnity::CesiumDataSource::FromCesiumIon) {
+    hashBytes(hash, &ionAssetID, sizeof(ionAssetID));
+  } else {
+    hashString(hash, url);
+  }
+  hashBytes(hash, &overlayAssetID, sizeof(overlayAssetID));
+  hashBytes(hash, &maximumScreenSpaceError, sizeof(maximumScreenSpaceError));
+  hashBytes(hash, &viewportSize, sizeof(viewportSize));
+  hashBytes(hash, &verticalFieldOfView, sizeof(verticalFieldOfView));
+  for (const Cartographic& position : positions) {
+    hashBytes(hash, &position.longitude, sizeof(position.longitude));
+    hashBytes(hash, &position.latitude, sizeof(position.latitude));
+    hashBytes(hash, &position.height, sizeof(position.height));
+  }
+
+  char hashText[17];
+  std::snprintf(
+      hashText,
+      sizeof(hashText),
+      "%016llx",
+      static_cast<unsigned long long>(hash));
+  this->_progressPath =
+      UnityEngine::Application::temporaryCachePath().ToStlString() +
+      "/cesium-seed-" + hashText + ".progress";
+
+  for (const Cartographic& position : positions) {
+    this->_views.emplace_back(
+        createNadirView(position, viewportSize, verticalFieldOfView));
+  }
+
+  std::ifstream progressFile(std::filesystem::u8path(this->_progressPath));
+  size_t completedViews = 0;
+  if (progressFile >> completedViews) {
+    this->_nextView = std::min(completedViews, this->_views.size());
+    SPDLOG_LOGGER_INFO(
+        pLogger,
+        "Resuming cache seeding after {} of {} views",
+        this->_nextView,
+        this->_views.size());
+  }
+  progressFile.close();
+
+  if (this->_nextView == this->_views.size()) {
+    std::error_code error;
+    std::filesystem::remove(
+        std::filesystem::u8path(this->_progressPath),
+        error);
+    return;
+  }
+
+  TilesetOptions options{};
+  options.maximumScreenSpaceError = maximumScreenSpaceError;
+  // Only what the views need should be downloaded, and the views are from
+  // directly above, so there's no fog to hide distant tiles behind.
+  options.preloadSiblings = false;
+  options.enableFogCulling = false;
+  options.loadErrorCallback = [this](const TilesetLoadFailureDetails& details) {
+    SPDLOG_LOGGER_ERROR(
+        spdlog::default_logger(),
+        "The tileset to seed the cache with could not be loaded: {}",
+        details.message);
+    this->_failed = true;
+  };
+
+  this->_requestGroup = AssetRequestCancellation::createGroup();
+  TilesetExternals externals = createStandaloneTilesetExternals(
+      std::make_shared<SeedingPrepareRendererResources>(),
+      this->_requestGroup,
+      TaskPriority::Background);
+
+  System::String ionAccessToken = seeder.ionAccessToken();
+  if (System::String::IsNullOrEmpty(ionAccessToken)) {
+    ionAccessToken =
+        CesiumForUnity::CesiumRuntimeSettings::defaultIonAccessToken();
+  }
+
+  if (source == CesiumForUnity::CesiumDataSource::FromCesiumIon) {
+    this->_pTileset = std::make_unique<Tileset>(
+        externals,
+        ionAssetID,
+        ionAccessToken.ToStlString(),
+        options);
+  } else {
+    this->_pTileset = std::make_unique<Tileset>(externals, url, options);
+  }
+
+  if (overlayAssetID > 0) {
+    this->_pTileset->getOverlays().add(new IonRasterOverlay(
+        "Seeded overlay",
+        overlayAssetID,
+        ionAccessToken.ToStlString()));
+  }
+}
+
+void CesiumCacheSeederImpl::StopSeeding(
+    const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder) {
+  // The views completed so far have already been saved, so a later run will
+  // pick up from here.
+  this->destroyTileset();
+}
+
+void CesiumCacheSeederImpl::UpdateSeeding(
+    const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder) {
+  if (!this->_pTileset) {
+    return;
+  }
+
+  if (this->_failed) {
+    this->destroyTileset();
+    return;
+  }
+
+  const ViewUpdateResult& result =
+      this->_pTileset->updateView({this->_views[this->_nextView]});
+
+  bool idle = result.tilesVisited > 0 &&
+              result.workerThreadTileLoadQueueLength == 0 &&
+              result.mainThreadTileLoadQueueLength == 0 &&
+              this->_pTileset->computeLoadProgress() >= 100.0f;
+  this->_idleUpdates = idle ? this->_idleUpdates + 1 : 0;
+  if (this->_idleUpdates < requiredIdleUpdates) {
+    return;
+  }
+
+  this->_idleUpdates = 0;
+  ++this->_nextView;
+
+  if (this->_nextView < this->_views.size()) {
+    this->saveProgress();
+    return;
+  }
+
+  std::error_code error;
+  std::filesystem::remove(std::filesystem::u8path(this->_progressPath), error);
+
+  SPDLOG_LOGGER_INFO(
+      spdlog::default_logger(),
+      "Finished seeding the cache for {} views",
+      this->_views.size());
+  this->destroyTileset();
+}
+
+bool CesiumCacheSeederImpl::IsSeeding(
+    const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder) {
+  return this->_pTileset != nullptr;
+}
+
+float CesiumCacheSeederImpl::GetProgress(
+    const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder) {
+  if (this->_views.empty()) {
+    return 0.0f;
+  }
+
+  double completed = double(this->_nextView);
+  if (this->_pTileset) {
+    completed += this->_pTileset->computeLoadProgress() / 100.0;
+  }
+  return float(
+      std::min(100.0 * completed / double(this->_views.size()), 100.0));
+}
+
+void CesiumCacheSeederImpl::saveProgress() const {
+  std::ofstream progressFile(
+      std::filesystem::u8path(this->_progressPath),
+      std::ios::trunc);
+  progressFile << this->_nextView;
+  if (!progressFile) {
+    SPDLOG_LOGGER_WARN(
+        spdlog::default_logger(),
+        "Could not save cache seeding progress to {}",
+        this->_progressPath);
+  }
+}
+
+void CesiumCacheSeederImpl::destroyTileset() {
+  // Stop downloading anything for the view that wasn't completed.
+  if (this->_requestGroup != 0) {
+    AssetRequestCancellation::cancelGroup(this->_requestGroup);
+    this->_requestGroup = 0;
+  }
+
+  this->_pTileset.reset();
+}
+
+} // namespace CesiumForUnityNative
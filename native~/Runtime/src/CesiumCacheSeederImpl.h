@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/ViewState.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DotNet::CesiumForUnity {
+class CesiumCacheSeeder;
+}
+
+namespace Cesium3DTilesSelection {
+class Tileset;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Downloads the tiles that a set of views of a tileset need into the
+ * request cache, by selecting tiles for one view at a time until they have
+ * all loaded. The tiles are never rendered.
+ */
+class CesiumCacheSeederImpl {
+public:
+  CesiumCacheSeederImpl(
+      const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder);
+  ~CesiumCacheSeederImpl();
+
+  void BeginSeeding(const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder);
+  void StopSeeding(const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder);
+  void UpdateSeeding(const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder);
+  bool IsSeeding(const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder);
+  float GetProgress(const DotNet::CesiumForUnity::CesiumCacheSeeder& seeder);
+
+private:
+  void saveProgress() const;
+  void destroyTileset();
+
+  std::unique_ptr<Cesium3DTilesSelection::Tileset> _pTileset;
+  std::vector<Cesium3DTilesSelection::ViewState> _views;
+  size_t _nextView;
+  // The number of consecutive updates of the current view in which nothing
+  // was left to load.
+  int32_t _idleUpdates;
+  uint64_t _requestGroup;
+  bool _failed;
+  std::string _progressPath;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,9 @@
+#include "CesiumNativeThreadsImpl.h"
+
+#include "UnityTilesetExternals.h"
+
+namespace CesiumForUnityNative {
+
+void CesiumNativeThreadsImpl::Shutdown() { shutdownTilesetExternals(); }
+
+} // namespace CesiumForUnityNative
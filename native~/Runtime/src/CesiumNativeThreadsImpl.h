@@ -0,0 +1,10 @@
+#pragma once
+
+namespace CesiumForUnityNative {
+
+class CesiumNativeThreadsImpl {
+public:
+  static void Shutdown();
+};
+
+} // namespace CesiumForUnityNative
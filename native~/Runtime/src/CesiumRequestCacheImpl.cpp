@@ -0,0 +1,39 @@
+#include "CesiumRequestCacheImpl.h"
+
+#include "CacheModeAssetAccessor.h"
+#include "UnityTilesetExternals.h"
+
+#include <DotNet/CesiumForUnity/CesiumCacheMode.h>
+
+using namespace DotNet;
+
+namespace CesiumForUnityNative {
+
+CesiumForUnity::CesiumCacheMode CesiumRequestCacheImpl::GetMode() {
+  switch (getCacheMode()) {
+  case CacheMode::StaleWhileRevalidate:
+    return CesiumForUnity::CesiumCacheMode::StaleWhileRevalidate;
+  case CacheMode::CacheOnly:
+    return CesiumForUnity::CesiumCacheMode::CacheOnly;
+  case CacheMode::NetworkFirst:
+  default:
+    return CesiumForUnity::CesiumCacheMode::NetworkFirst;
+  }
+}
+
+void CesiumRequestCacheImpl::SetMode(CesiumForUnity::CesiumCacheMode mode) {
+  switch (mode) {
+  case CesiumForUnity::CesiumCacheMode::StaleWhileRevalidate:
+    setCacheMode(CacheMode::StaleWhileRevalidate);
+    break;
+  case CesiumForUnity::CesiumCacheMode::CacheOnly:
+    setCacheMode(CacheMode::CacheOnly);
+    break;
+  case CesiumForUnity::CesiumCacheMode::NetworkFirst:
+  default:
+    setCacheMode(CacheMode::NetworkFirst);
+    break;
+  }
+}
+
+} // namespace CesiumForUnityNative
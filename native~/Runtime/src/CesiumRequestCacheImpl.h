@@ -0,0 +1,15 @@
+#pragma once
+
+namespace DotNet::CesiumForUnity {
+enum class CesiumCacheMode;
+}
+
+namespace CesiumForUnityNative {
+
+class CesiumRequestCacheImpl {
+public:
+  static DotNet::CesiumForUnity::CesiumCacheMode GetMode();
+  static void SetMode(DotNet::CesiumForUnity::CesiumCacheMode mode);
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,194 @@
+#include "CoalescingAssetAccessor.h"
+
+#include "AssetRequestCancellation.h"
+#include "AssetRequestKey.h"
+
+#include <CesiumAsync/HttpHeaders.h>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+CoalescingAssetAccessor::CoalescingAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAccessor)
+    : _pAccessor(pAccessor),
+      _mutex(),
+      _inFlightRequests(),
+      _nextID(1),
+      _cancellationListenerID(0),
+      _requests(0),
+      _coalescedRequests(0) {
+  this->_cancellationListenerID = AssetRequestCancellation::addListener(
+      [this](uint64_t group) { this->cancelGroup(group); });
+}
+
+CoalescingAssetAccessor::~CoalescingAssetAccessor() noexcept {
+  AssetRequestCancellation::removeListener(this->_cancellationListenerID);
+}
+
+Future<std::shared_ptr<IAssetRequest>> CoalescingAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  ++this->_requests;
+
+  // Sort the headers so that the order they're given in doesn't matter, and
+  // leave out the group so that requests from different tilesets can be
+  // shared.
+  HttpHeaders sortedHeaders(headers.begin(), headers.end());
+  uint64_t group = AssetRequestCancellation::takeGroup(sortedHeaders);
+
+  Promise<std::shared_ptr<IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+  Future<std::shared_ptr<IAssetRequest>> future = promise.getFuture();
+
+  if (AssetRequestCancellation::isCancelled(group)) {
+    AssetRequestCancellation::recordCancelledRequest(0);
+    promise.reject(std::runtime_error(
+        "Request for " + url + " was cancelled before it was sent."));
+    return future;
+  }
+
+  std::string key = calculateAssetRequestKey(url, sortedHeaders);
+
+  uint64_t id;
+  uint64_t sharedGroup;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto it = this->_inFlightRequests.find(key);
+    if (it != this->_inFlightRequests.end()) {
+      it->second.waiters.emplace_back(Waiter{group, std::move(promise)});
+      ++this->_coalescedRequests;
+      return future;
+    }
+
+    // The shared request gets a group of its own, which is cancelled only
+    // once every request waiting on it has been cancelled.
+    id = this->_nextID++;
+    sharedGroup = AssetRequestCancellation::createGroup();
+
+    InFlightRequest& inFlight = this->_inFlightRequests[key];
+    inFlight.id = id;
+    inFlight.group = sharedGroup;
+    inFlight.waiters.emplace_back(Waiter{group, std::move(promise)});
+  }
+
+  std::vector<THeader> sharedHeaders(
+      sortedHeaders.begin(),
+      sortedHeaders.end());
+  sharedHeaders.emplace_back(
+      AssetRequestCancellation::groupHeader,
+      std::to_string(sharedGroup));
+
+  std::shared_ptr<CoalescingAssetAccessor> pThis = this->shared_from_this();
+  this->_pAccessor->get(asyncSystem, url, sharedHeaders)
+      .thenImmediately(
+          [pThis, key, id](std::shared_ptr<IAssetRequest>&& pRequest) {
+            pThis->complete(key, id, pRequest, nullptr);
+          })
+      .catchImmediately([pThis, key, id](std::exception&& e) {
+        pThis->complete(key, id, nullptr, &e);
+      });
+
+  return future;
+}
+
+Future<std::shared_ptr<IAssetRequest>> CoalescingAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  // Only GET requests are shared. Anything else may have side effects.
+  return this->_pAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CoalescingAssetAccessor::tick() noexcept { this->_pAccessor->tick(); }
+
+CoalescingAssetAccessor::Statistics
+CoalescingAssetAccessor::getStatistics() const noexcept {
+  return Statistics{this->_requests.load(), this->_coalescedRequests.load()};
+}
+
+void CoalescingAssetAccessor::complete(
+    const std::string& key,
+    uint64_t id,
+    const std::shared_ptr<IAssetRequest>& pRequest,
+    const std::exception* pException) {
+  std::vector<Waiter> waiters;
+  uint64_t sharedGroup = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    // The request is gone if everything waiting on it was cancelled, and
+    // another request with the same key may have been started since.
+    auto it = this->_inFlightRequests.find(key);
+    if (it == this->_inFlightRequests.end() || it->second.id != id) {
+      return;
+    }
+
+    waiters = std::move(it->second.waiters);
+    sharedGroup = it->second.group;
+    this->_inFlightRequests.erase(it);
+  }
+
+  AssetRequestCancellation::releaseGroup(sharedGroup);
+
+  for (Waiter& waiter : waiters) {
+    if (pException) {
+      waiter.promise.reject(std::runtime_error(pException->what()));
+    } else {
+      waiter.promise.resolve(pRequest);
+    }
+  }
+}
+
+void CoalescingAssetAccessor::cancelGroup(uint64_t group) {
+  std::vector<Waiter> cancelledWaiters;
+  std::vector<uint64_t> abandonedGroups;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    for (auto it = this->_inFlightRequests.begin();
+         it != this->_inFlightRequests.end();) {
+      std::vector<Waiter>& waiters = it->second.waiters;
+      auto cancelledIt = std::stable_partition(
+          waiters.begin(),
+          waiters.end(),
+          [group](const Waiter& waiter) { return waiter.group != group; });
+      std::move(
+          cancelledIt,
+          waiters.end(),
+          std::back_inserter(cancelledWaiters));
+      waiters.erase(cancelledIt, waiters.end());
+
+      if (waiters.empty()) {
+        abandonedGroups.emplace_back(it->second.group);
+        it = this->_inFlightRequests.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  for (Waiter& waiter : cancelledWaiters) {
+    waiter.promise.reject(std::runtime_error("Request was cancelled."));
+  }
+
+  // Nothing needs the abandoned requests anymore, so cancel them too. The
+  // network accessors record these in the cancellation statistics.
+  for (uint64_t abandonedGroup : abandonedGroups) {
+    AssetRequestCancellation::cancelGroup(abandonedGroup);
+  }
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief An asset accessor that lets concurrent, identical GET requests share
+ * a single request to the underlying accessor.
+ *
+ * Requests are identical if they have the same URL and headers, apart from
+ * their {@link AssetRequestCancellation} group. So when two tilesets use the
+ * same imagery, for example, each image is downloaded and written to the
+ * cache once. A shared request is only cancelled when the groups of all of
+ * the requests waiting on it have been cancelled.
+ *
+ * A shared request keeps the accessor alive until it completes, even if every
+ * request waiting on it was cancelled, so the accessor must be created with
+ * `std::make_shared`.
+ */
+class CoalescingAssetAccessor
+    : public CesiumAsync::IAssetAccessor,
+      public std::enable_shared_from_this<CoalescingAssetAccessor> {
+public:
+  struct Statistics {
+    /**
+     * @brief The number of GET requests made.
+     */
+    uint64_t requests;
+
+    /**
+     * @brief The number of GET requests that were served by a request that
+     * was already in progress, rather than by a new one.
+     */
+    uint64_t coalescedRequests;
+  };
+
+  /**
+   * @brief Creates a new accessor.
+   *
+   * @param pAccessor The accessor to make the shared requests with.
+   */
+  CoalescingAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAccessor);
+  virtual ~CoalescingAssetAccessor() noexcept;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers = {}) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers = std::vector<THeader>(),
+      const gsl::span<const std::byte>& contentPayload = {}) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Gets the totals of the requests made so far.
+   */
+  Statistics getStatistics() const noexcept;
+
+private:
+  struct Waiter {
+    uint64_t group;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise;
+  };
+
+  struct InFlightRequest {
+    uint64_t id;
+    uint64_t group;
+    std::vector<Waiter> waiters;
+  };
+
+  void complete(
+      const std::string& key,
+      uint64_t id,
+      const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest,
+      const std::exception* pException);
+  void cancelGroup(uint64_t group);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAccessor;
+
+  std::mutex _mutex;
+  std::unordered_map<std::string, InFlightRequest> _inFlightRequests;
+  uint64_t _nextID;
+  int32_t _cancellationListenerID;
+
+  std::atomic<uint64_t> _requests;
+  std::atomic<uint64_t> _coalescedRequests;
+};
+
+} // namespace CesiumForUnityNative
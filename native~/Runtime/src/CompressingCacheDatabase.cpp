@@ -0,0 +1,216 @@
+#include "CompressingCacheDatabase.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <limits>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// Added to the stored response headers of a compressed entry, with the length
+// of its data before compression as the value. It is removed again on read.
+const std::string uncompressedLengthHeader =
+    "X-Cesium-Unity-Cache-Uncompressed-Length";
+
+// Smaller responses aren't worth the time, and barely shrink.
+const size_t minimumCompressedSize = 512;
+
+bool startsWith(const std::string& value, const std::string& prefix) {
+  return value.size() >= prefix.size() &&
+         std::equal(
+             prefix.begin(),
+             prefix.end(),
+             value.begin(),
+             [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) ==
+                      std::tolower(static_cast<unsigned char>(b));
+             });
+}
+
+/**
+ * @brief Determines whether a response's data might get meaningfully smaller
+ * when compressed.
+ */
+bool isCompressible(
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  if (responseData.size() < minimumCompressedSize ||
+      responseData.size() > std::numeric_limits<uLong>::max()) {
+    return false;
+  }
+
+  // Data that is still gzipped was compressed by the server.
+  if (responseData[0] == std::byte{0x1f} &&
+      responseData[1] == std::byte{0x8b}) {
+    return false;
+  }
+
+  auto encodingIt = responseHeaders.find("Content-Encoding");
+  if (encodingIt != responseHeaders.end() &&
+      !startsWith(encodingIt->second, "identity")) {
+    return false;
+  }
+
+  // PNG, JPEG, WebP, and KTX2 images are already compressed.
+  auto typeIt = responseHeaders.find("Content-Type");
+  if (typeIt != responseHeaders.end() &&
+      (startsWith(typeIt->second, "image/") &&
+       !startsWith(typeIt->second, "image/svg"))) {
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace
+
+CompressingCacheDatabase::CompressingCacheDatabase(
+    const std::shared_ptr<ICacheDatabase>& pDatabase)
+    : _pDatabase(pDatabase),
+      _uncompressedBytes(0),
+      _storedBytes(0),
+      _inflatedBytes(0),
+      _inflateNanoseconds(0) {}
+
+std::optional<CacheItem>
+CompressingCacheDatabase::getEntry(const std::string& key) const {
+  std::optional<CacheItem> maybeItem = this->_pDatabase->getEntry(key);
+  if (!maybeItem) {
+    return maybeItem;
+  }
+
+  HttpHeaders& headers = maybeItem->cacheResponse.headers;
+  auto it = headers.find(uncompressedLengthHeader);
+  if (it == headers.end()) {
+    // Stored without compression.
+    return maybeItem;
+  }
+
+  CESIUM_TRACE("CompressingCacheDatabase::inflate");
+
+  auto start = std::chrono::steady_clock::now();
+
+  const std::string& lengthString = it->second;
+  uint64_t length = 0;
+  std::from_chars_result parsed = std::from_chars(
+      lengthString.data(),
+      lengthString.data() + lengthString.size(),
+      length);
+  if (parsed.ec != std::errc() ||
+      length > std::numeric_limits<uLong>::max()) {
+    // Treat a corrupted entry as a miss, so that it's requested again and
+    // overwritten.
+    return std::nullopt;
+  }
+
+  std::vector<std::byte>& compressed = maybeItem->cacheResponse.data;
+
+  // The length is known, so inflate in a single call straight into a buffer of
+  // the right size.
+  std::vector<std::byte> data(length);
+  uLongf inflatedLength = uLongf(length);
+  int result = uncompress(
+      reinterpret_cast<Bytef*>(data.data()),
+      &inflatedLength,
+      reinterpret_cast<const Bytef*>(compressed.data()),
+      uLong(compressed.size()));
+  if (result != Z_OK || inflatedLength != length) {
+    return std::nullopt;
+  }
+
+  headers.erase(it);
+  compressed = std::move(data);
+
+  this->_inflatedBytes += length;
+  this->_inflateNanoseconds +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+  return maybeItem;
+}
+
+bool CompressingCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  this->_uncompressedBytes += uint64_t(responseData.size());
+
+  if (isCompressible(responseHeaders, responseData)) {
+    CESIUM_TRACE("CompressingCacheDatabase::deflate");
+
+    std::vector<std::byte> compressed(
+        compressBound(uLong(responseData.size())));
+    uLongf compressedLength = uLongf(compressed.size());
+    int result = compress2(
+        reinterpret_cast<Bytef*>(compressed.data()),
+        &compressedLength,
+        reinterpret_cast<const Bytef*>(responseData.data()),
+        uLong(responseData.size()),
+        Z_BEST_SPEED);
+
+    // Only keep the compressed data if it saves at least an eighth of the
+    // space, as inflating it on every read isn't free.
+    if (result == Z_OK &&
+        compressedLength < responseData.size() - responseData.size() / 8) {
+      compressed.resize(compressedLength);
+
+      HttpHeaders compressedHeaders = responseHeaders;
+      compressedHeaders[uncompressedLengthHeader] =
+          std::to_string(responseData.size());
+
+      this->_storedBytes += uint64_t(compressedLength);
+      return this->_pDatabase->storeEntry(
+          key,
+          expiryTime,
+          url,
+          requestMethod,
+          requestHeaders,
+          statusCode,
+          compressedHeaders,
+          compressed);
+    }
+  }
+
+  this->_storedBytes += uint64_t(responseData.size());
+  return this->_pDatabase->storeEntry(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+}
+
+bool CompressingCacheDatabase::prune() { return this->_pDatabase->prune(); }
+
+bool CompressingCacheDatabase::clearAll() {
+  return this->_pDatabase->clearAll();
+}
+
+CompressingCacheDatabase::Statistics
+CompressingCacheDatabase::getStatistics() const noexcept {
+  return Statistics{
+      this->_uncompressedBytes.load(),
+      this->_storedBytes.load(),
+      this->_inflatedBytes.load(),
+      double(this->_inflateNanoseconds.load()) / 1e9};
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <CesiumAsync/ICacheDatabase.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A cache database that deflates response data before storing it in
+ * another database, and inflates it again when it is read.
+ *
+ * {@link InflatingAssetAccessor} sits above the cache, so responses that
+ * weren't compressed on the wire, such as most glTF, b3dm, and JSON tiles,
+ * would otherwise be stored at their full size. Responses that are already
+ * compressed, such as images and gzip-encoded bodies, or that don't get
+ * meaningfully smaller, are stored as they are. Entries written before
+ * compression was enabled are still read correctly.
+ *
+ * Compression happens in `storeEntry`, so this should be wrapped in a
+ * {@link WriteBehindCacheDatabase} to keep it off of the request path.
+ */
+class CompressingCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  struct Statistics {
+    /**
+     * @brief The number of bytes of response data that have been stored.
+     */
+    uint64_t uncompressedBytes;
+
+    /**
+     * @brief The number of bytes that the response data took up once stored,
+     * after compression.
+     */
+    uint64_t storedBytes;
+
+    /**
+     * @brief The number of bytes of response data that have been inflated when
+     * read.
+     */
+    uint64_t inflatedBytes;
+
+    /**
+     * @brief The time, in seconds, spent inflating response data when read.
+     */
+    double inflateSeconds;
+  };
+
+  /**
+   * @brief Creates a new database.
+   *
+   * @param pDatabase The database to store the compressed entries in.
+   */
+  CompressingCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase);
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+  /**
+   * @brief Gets the totals of the data stored and read so far.
+   */
+  Statistics getStatistics() const noexcept;
+
+private:
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pDatabase;
+
+  std::atomic<uint64_t> _uncompressedBytes;
+  std::atomic<uint64_t> _storedBytes;
+  mutable std::atomic<uint64_t> _inflatedBytes;
+  mutable std::atomic<int64_t> _inflateNanoseconds;
+};
+
+} // namespace CesiumForUnityNative
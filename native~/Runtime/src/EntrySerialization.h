@@ -0,0 +1,125 @@
+#pragma once
+
+#include <CesiumAsync/HttpHeaders.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Serializes values into a growing buffer, in the host's byte order.
+ */
+class EntryWriter {
+public:
+  void writeUint16(uint16_t value) { this->writeRaw(&value, sizeof(value)); }
+  void writeUint32(uint32_t value) { this->writeRaw(&value, sizeof(value)); }
+  void writeUint64(uint64_t value) { this->writeRaw(&value, sizeof(value)); }
+  void writeInt64(int64_t value) { this->writeRaw(&value, sizeof(value)); }
+
+  void writeString(const std::string& value) {
+    this->writeUint32(uint32_t(value.size()));
+    this->writeRaw(value.data(), value.size());
+  }
+
+  void writeHeaders(const CesiumAsync::HttpHeaders& headers) {
+    this->writeUint32(uint32_t(headers.size()));
+    for (const auto& header : headers) {
+      this->writeString(header.first);
+      this->writeString(header.second);
+    }
+  }
+
+  void writeBytes(const gsl::span<const std::byte>& bytes) {
+    this->writeUint64(uint64_t(bytes.size()));
+    this->writeRaw(bytes.data(), bytes.size());
+  }
+
+  std::vector<std::byte>& getData() { return this->_data; }
+
+private:
+  void writeRaw(const void* pData, size_t size) {
+    const std::byte* pBytes = static_cast<const std::byte*>(pData);
+    this->_data.insert(this->_data.end(), pBytes, pBytes + size);
+  }
+
+  std::vector<std::byte> _data;
+};
+
+/**
+ * @brief Reads values written by {@link EntryWriter} from a buffer. Each read
+ * returns false, rather than reading past the end, if the buffer is too short.
+ */
+class EntryReader {
+public:
+  explicit EntryReader(const gsl::span<const std::byte>& data)
+      : _data(data), _offset(0) {}
+
+  bool readUint16(uint16_t& value) { return this->readRaw(&value, 2); }
+  bool readUint32(uint32_t& value) { return this->readRaw(&value, 4); }
+  bool readUint64(uint64_t& value) { return this->readRaw(&value, 8); }
+  bool readInt64(int64_t& value) { return this->readRaw(&value, 8); }
+
+  bool readString(std::string& value) {
+    uint32_t size;
+    if (!this->readUint32(size) || !this->has(size)) {
+      return false;
+    }
+    value.assign(
+        reinterpret_cast<const char*>(this->_data.data() + this->_offset),
+        size);
+    this->_offset += size;
+    return true;
+  }
+
+  bool readHeaders(CesiumAsync::HttpHeaders& headers) {
+    uint32_t count;
+    if (!this->readUint32(count)) {
+      return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+      std::string name;
+      std::string value;
+      if (!this->readString(name) || !this->readString(value)) {
+        return false;
+      }
+      headers.emplace(std::move(name), std::move(value));
+    }
+    return true;
+  }
+
+  bool readBytes(std::vector<std::byte>& bytes) {
+    uint64_t size;
+    if (!this->readUint64(size) || !this->has(size)) {
+      return false;
+    }
+    const std::byte* pStart = this->_data.data() + this->_offset;
+    bytes.assign(pStart, pStart + size);
+    this->_offset += size_t(size);
+    return true;
+  }
+
+private:
+  bool has(uint64_t size) const {
+    return size <= this->_data.size() - this->_offset;
+  }
+
+  bool readRaw(void* pValue, size_t size) {
+    if (!this->has(size)) {
+      return false;
+    }
+    std::memcpy(pValue, this->_data.data() + this->_offset, size);
+    this->_offset += size;
+    return true;
+  }
+
+  gsl::span<const std::byte> _data;
+  size_t _offset;
+};
+
+} // namespace CesiumForUnityNative
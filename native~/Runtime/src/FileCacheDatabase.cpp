@@ -0,0 +1,725 @@
+#include "FileCacheDatabase.h"
+
+#include "EntrySerialization.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+const char indexFileName[] = "index.log";
+const char indexMagic[8] = {'C', 'F', 'U', 'I', 'D', 'X', '0', '1'};
+const uint32_t entryMagic = 0x43465545; // CFUE
+const uint32_t entryVersion = 1;
+
+const uint64_t putOperation = 1;
+const uint64_t removeOperation = 2;
+
+// Writes are dropped, rather than queued, while more than this many bytes are
+// waiting to be written, so that a slow disk can't use unbounded memory.
+const uint64_t maximumPendingBytes = 64 * 1024 * 1024;
+
+// When the cache is over budget, entries are evicted until it is this
+// fraction of the budget, so that eviction doesn't happen on every write.
+const double evictionTargetFraction = 0.9;
+
+uint64_t hashKey(const std::string& key) {
+  // 64-bit FNV-1a.
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : key) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+std::FILE* openFile(const std::filesystem::path& path, const char* mode) {
+#ifdef _WIN32
+  std::wstring wideMode(mode, mode + std::strlen(mode));
+  return _wfopen(path.c_str(), wideMode.c_str());
+#else
+  return std::fopen(path.c_str(), mode);
+#endif
+}
+
+std::string toHex(uint64_t value) {
+  static const char digits[] = "0123456789abcdef";
+  std::string result(16, '0');
+  for (int i = 15; i >= 0; --i) {
+    result[size_t(i)] = digits[value & 0xf];
+    value >>= 4;
+  }
+  return result;
+}
+
+/**
+ * @brief Reads a whole entry file, or returns nothing if it can't be read.
+ *
+ * The file is read into memory and closed straight away, rather than being
+ * memory-mapped, because an entry is copied into its response anyway, and
+ * because Windows won't let the disk thread rename a new version of the entry
+ * over a file that is mapped.
+ */
+std::optional<std::vector<std::byte>>
+readEntryFile(const std::filesystem::path& path) {
+  std::vector<std::byte> contents;
+
+#ifdef _WIN32
+  // FILE_SHARE_DELETE lets the disk thread replace the file while it's open.
+  HANDLE file = CreateFileW(
+      path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+      nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return std::nullopt;
+  }
+
+  LARGE_INTEGER size;
+  bool read = GetFileSizeEx(file, &size) != 0;
+  if (read) {
+    contents.resize(size_t(size.QuadPart));
+    size_t offset = 0;
+    while (read && offset < contents.size()) {
+      DWORD toRead = DWORD(std::min<size_t>(
+          contents.size() - offset,
+          std::numeric_limits<DWORD>::max()));
+      DWORD bytesRead = 0;
+      read = ReadFile(
+                 file,
+                 contents.data() + offset,
+                 toRead,
+                 &bytesRead,
+                 nullptr) != 0 &&
+             bytesRead == toRead;
+      offset += bytesRead;
+    }
+  }
+
+  CloseHandle(file);
+#else
+  std::FILE* pFile = openFile(path, "rb");
+  if (pFile == nullptr) {
+    return std::nullopt;
+  }
+
+  bool read = std::fseek(pFile, 0, SEEK_END) == 0;
+  long size = read ? std::ftell(pFile) : -1;
+  read = size >= 0 && std::fseek(pFile, 0, SEEK_SET) == 0;
+  if (read) {
+    contents.resize(size_t(size));
+    read = std::fread(contents.data(), 1, contents.size(), pFile) ==
+           contents.size();
+  }
+
+  std::fclose(pFile);
+#endif
+
+  if (!read) {
+    return std::nullopt;
+  }
+
+  return contents;
+}
+
+std::optional<CacheItem>
+parseEntry(const gsl::span<const std::byte>& data, const std::string& key) {
+  EntryReader reader(data);
+
+  uint32_t magic;
+  uint32_t version;
+  std::string storedKey;
+  int64_t expiryTime;
+  uint16_t statusCode;
+  std::string url;
+  std::string method;
+  HttpHeaders requestHeaders;
+  HttpHeaders responseHeaders;
+  std::vector<std::byte> responseData;
+
+  if (!reader.readUint32(magic) || magic != entryMagic ||
+      !reader.readUint32(version) || version != entryVersion ||
+      !reader.readString(storedKey) || storedKey != key ||
+      !reader.readInt64(expiryTime) || !reader.readUint16(statusCode) ||
+      !reader.readString(url) || !reader.readString(method) ||
+      !reader.readHeaders(requestHeaders) ||
+      !reader.readHeaders(responseHeaders) ||
+      !reader.readBytes(responseData)) {
+    return std::nullopt;
+  }
+
+  return CacheItem{
+      std::time_t(expiryTime),
+      CacheRequest{
+          std::move(requestHeaders),
+          std::move(method),
+          std::move(url)},
+      CacheResponse{
+          statusCode,
+          std::move(responseHeaders),
+          std::move(responseData)}};
+}
+
+} // namespace
+
+FileCacheDatabase::FileCacheDatabase(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& directory,
+    uint64_t maximumBytes)
+    : _pLogger(pLogger),
+      _directory(directory),
+      _maximumBytes(maximumBytes),
+      _mutex(),
+      _operationsAvailable(),
+      _entries(),
+      _accessCounter(0),
+      _operations(),
+      _totalBytes(0),
+      _pendingWrites(),
+      _pendingBytes(0),
+      _stopping(false),
+      _diskThreadStopped(false),
+      _diskMutex(),
+      _pIndexFile(nullptr),
+      _indexRecordCount(0),
+      _diskThread() {
+  std::error_code error;
+  std::filesystem::create_directories(
+      std::filesystem::u8path(directory),
+      error);
+  if (error) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pLogger,
+        "Failed to create the cache directory {}: {}",
+        directory,
+        error.message());
+  }
+
+  this->loadIndex();
+  this->evictToBudget();
+
+  this->_diskThread = std::thread([this]() { this->processDiskOperations(); });
+}
+
+FileCacheDatabase::~FileCacheDatabase() noexcept {
+  this->shutdown();
+
+  if (this->_pIndexFile) {
+    std::fclose(this->_pIndexFile);
+  }
+}
+
+void FileCacheDatabase::shutdown() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_stopping) {
+      return;
+    }
+    this->_stopping = true;
+  }
+
+  // Let the disk thread finish the writes that are already queued.
+  this->_operationsAvailable.notify_all();
+  this->_diskThread.join();
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_diskThreadStopped = true;
+  }
+
+  // Perform anything that was queued after the disk thread last looked.
+  this->performDiskOperationsHere();
+}
+
+std::optional<CacheItem>
+FileCacheDatabase::getEntry(const std::string& key) const {
+  CESIUM_TRACE("FileCacheDatabase::getEntry");
+
+  uint64_t hash = hashKey(key);
+  std::shared_ptr<const std::vector<std::byte>> pPending;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto it = this->_entries.find(hash);
+    if (it == this->_entries.end()) {
+      return std::nullopt;
+    }
+
+    it->second.lastAccess = ++this->_accessCounter;
+
+    auto pendingIt = this->_pendingWrites.find(hash);
+    if (pendingIt != this->_pendingWrites.end()) {
+      pPending = pendingIt->second;
+    }
+  }
+
+  // An entry that hasn't been written yet is served from memory.
+  if (pPending) {
+    return parseEntry(*pPending, key);
+  }
+
+  std::optional<std::vector<std::byte>> maybeContents =
+      readEntryFile(std::filesystem::u8path(this->getEntryPath(hash)));
+  std::optional<CacheItem> result;
+  if (maybeContents) {
+    result = parseEntry(*maybeContents, key);
+  }
+
+  if (!result) {
+    // The file is missing or damaged, or belongs to a different key with the
+    // same hash. Either way, it's no use.
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->removeEntry(hash);
+  }
+
+  return result;
+}
+
+bool FileCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  CESIUM_TRACE("FileCacheDatabase::storeEntry");
+
+  // Serialize the entry before taking the lock, so that callers only contend
+  // for the bookkeeping.
+  EntryWriter writer;
+  writer.writeUint32(entryMagic);
+  writer.writeUint32(entryVersion);
+  writer.writeString(key);
+  writer.writeInt64(int64_t(expiryTime));
+  writer.writeUint16(statusCode);
+  writer.writeString(url);
+  writer.writeString(requestMethod);
+  writer.writeHeaders(requestHeaders);
+  writer.writeHeaders(responseHeaders);
+  writer.writeBytes(responseData);
+
+  auto pContents = std::make_shared<const std::vector<std::byte>>(
+      std::move(writer.getData()));
+  uint64_t size = uint64_t(pContents->size());
+  uint64_t hash = hashKey(key);
+  bool diskThreadStopped;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (this->_pendingBytes + size > maximumPendingBytes) {
+      return false;
+    }
+
+    auto it = this->_entries.find(hash);
+    if (it != this->_entries.end()) {
+      this->_totalBytes -= it->second.size;
+    }
+
+    this->_entries[hash] = Entry{size, expiryTime, ++this->_accessCounter};
+    this->_totalBytes += size;
+
+    auto pendingIt = this->_pendingWrites.find(hash);
+    if (pendingIt != this->_pendingWrites.end()) {
+      this->_pendingBytes -= pendingIt->second->size();
+    }
+    this->_pendingWrites[hash] = pContents;
+    this->_pendingBytes += size;
+
+    this->_operations.emplace_back(DiskOperation{
+        DiskOperation::Type::Write,
+        hash,
+        std::move(pContents),
+        expiryTime,
+        {}});
+
+    // Eviction is normally left to prune, which sorts every entry, but don't
+    // let the cache grow without bound if it isn't pruned often enough.
+    if (this->_totalBytes > 2 * this->_maximumBytes) {
+      this->evictToBudget();
+    }
+
+    diskThreadStopped = this->_diskThreadStopped;
+  }
+
+  this->startDiskOperations(diskThreadStopped);
+  return true;
+}
+
+bool FileCacheDatabase::prune() {
+  CESIUM_TRACE("FileCacheDatabase::prune");
+
+  std::time_t now = std::time(nullptr);
+  bool diskThreadStopped;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    std::vector<uint64_t> expired;
+    for (const auto& entry : this->_entries) {
+      if (entry.second.expiryTime < now) {
+        expired.emplace_back(entry.first);
+      }
+    }
+
+    for (uint64_t hash : expired) {
+      this->removeEntry(hash);
+    }
+
+    this->evictToBudget();
+
+    // Rewrite the index once most of its records are out of date.
+    if (this->_indexRecordCount > 2 * this->_entries.size() + 1024) {
+      DiskOperation compact{DiskOperation::Type::Compact, 0, nullptr, 0, {}};
+      compact.liveRecords.reserve(this->_entries.size());
+      for (const auto& entry : this->_entries) {
+        compact.liveRecords.emplace_back(IndexRecord{
+            putOperation,
+            entry.first,
+            entry.second.size,
+            int64_t(entry.second.expiryTime)});
+      }
+      this->_operations.emplace_back(std::move(compact));
+    }
+
+    diskThreadStopped = this->_diskThreadStopped;
+  }
+
+  this->startDiskOperations(diskThreadStopped);
+  return true;
+}
+
+bool FileCacheDatabase::clearAll() {
+  bool diskThreadStopped;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_entries.clear();
+    this->_totalBytes = 0;
+    this->_pendingWrites.clear();
+    this->_pendingBytes = 0;
+
+    // Nothing queued so far needs to reach the disk.
+    this->_operations.clear();
+    this->_operations.emplace_back(
+        DiskOperation{DiskOperation::Type::Clear, 0, nullptr, 0, {}});
+
+    diskThreadStopped = this->_diskThreadStopped;
+  }
+
+  this->startDiskOperations(diskThreadStopped);
+  return true;
+}
+
+std::string FileCacheDatabase::getEntryPath(uint64_t hash) const {
+  // Spread the files over subdirectories so that none gets too large.
+  std::string name = toHex(hash);
+  return this->_directory + "/" + name.substr(0, 2) + "/" + name + ".bin";
+}
+
+void FileCacheDatabase::loadIndex() {
+  std::string indexPath = this->_directory + "/" + indexFileName;
+  std::FILE* pFile = openFile(std::filesystem::u8path(indexPath), "rb");
+  if (!pFile) {
+    this->openIndex(true);
+    return;
+  }
+
+  char magic[sizeof(indexMagic)];
+  bool valid = std::fread(magic, sizeof(magic), 1, pFile) == 1 &&
+               std::memcmp(magic, indexMagic, sizeof(magic)) == 0;
+
+  IndexRecord record;
+  while (valid && std::fread(&record, sizeof(record), 1, pFile) == 1) {
+    ++this->_indexRecordCount;
+
+    auto it = this->_entries.find(record.hash);
+    if (it != this->_entries.end()) {
+      this->_totalBytes -= it->second.size;
+      this->_entries.erase(it);
+    }
+
+    if (record.operation == putOperation) {
+      this->_entries.emplace(
+          record.hash,
+          Entry{
+              record.size,
+              std::time_t(record.expiryTime),
+              ++this->_accessCounter});
+      this->_totalBytes += record.size;
+    } else if (record.operation != removeOperation) {
+      valid = false;
+    }
+  }
+
+  std::fclose(pFile);
+
+  if (!valid) {
+    SPDLOG_LOGGER_WARN(
+        this->_pLogger,
+        "The cache index at {} is not valid, so the cache will be cleared.",
+        indexPath);
+
+    this->_entries.clear();
+    this->_totalBytes = 0;
+    this->_operations.emplace_back(
+        DiskOperation{DiskOperation::Type::Clear, 0, nullptr, 0, {}});
+    return;
+  }
+
+  this->openIndex(false);
+}
+
+void FileCacheDatabase::openIndex(bool truncate) {
+  if (this->_pIndexFile) {
+    std::fclose(this->_pIndexFile);
+  }
+
+  std::string indexPath = this->_directory + "/" + indexFileName;
+  this->_pIndexFile =
+      openFile(std::filesystem::u8path(indexPath), truncate ? "wb" : "ab");
+  if (!this->_pIndexFile) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pLogger,
+        "Failed to open the cache index at {}.",
+        indexPath);
+    return;
+  }
+
+  if (truncate) {
+    std::fwrite(indexMagic, sizeof(indexMagic), 1, this->_pIndexFile);
+    std::fflush(this->_pIndexFile);
+    this->_indexRecordCount = 0;
+  }
+}
+
+void FileCacheDatabase::appendIndexRecord(const IndexRecord& record) {
+  if (this->_pIndexFile) {
+    std::fwrite(&record, sizeof(record), 1, this->_pIndexFile);
+    ++this->_indexRecordCount;
+  }
+}
+
+void FileCacheDatabase::removeEntry(uint64_t hash) const {
+  auto it = this->_entries.find(hash);
+  if (it == this->_entries.end()) {
+    return;
+  }
+
+  this->_totalBytes -= it->second.size;
+  this->_entries.erase(it);
+
+  auto pendingIt = this->_pendingWrites.find(hash);
+  if (pendingIt != this->_pendingWrites.end()) {
+    this->_pendingBytes -= pendingIt->second->size();
+    this->_pendingWrites.erase(pendingIt);
+  }
+
+  this->_operations.emplace_back(
+      DiskOperation{DiskOperation::Type::Remove, hash, nullptr, 0, {}});
+}
+
+void FileCacheDatabase::evictToBudget() {
+  if (this->_totalBytes <= this->_maximumBytes) {
+    return;
+  }
+
+  std::vector<std::pair<uint64_t, uint64_t>> byAge;
+  byAge.reserve(this->_entries.size());
+  for (const auto& entry : this->_entries) {
+    byAge.emplace_back(entry.second.lastAccess, entry.first);
+  }
+  std::sort(byAge.begin(), byAge.end());
+
+  uint64_t target =
+      uint64_t(double(this->_maximumBytes) * evictionTargetFraction);
+  for (const auto& entry : byAge) {
+    if (this->_totalBytes <= target) {
+      break;
+    }
+    this->removeEntry(entry.second);
+  }
+}
+
+void FileCacheDatabase::startDiskOperations(bool diskThreadStopped) {
+  if (diskThreadStopped) {
+    this->performDiskOperationsHere();
+  } else {
+    this->_operationsAvailable.notify_one();
+  }
+}
+
+void FileCacheDatabase::processDiskOperations() {
+  std::unique_lock<std::mutex> lock(this->_mutex);
+
+  while (true) {
+    this->_operationsAvailable.wait(lock, [this]() {
+      return this->_stopping || !this->_operations.empty();
+    });
+
+    if (!this->performNextDiskOperation(lock)) {
+      // Stopping, and everything has been written.
+      return;
+    }
+  }
+}
+
+void FileCacheDatabase::performDiskOperationsHere() {
+  std::lock_guard<std::mutex> diskLock(this->_diskMutex);
+  std::unique_lock<std::mutex> lock(this->_mutex);
+  while (this->performNextDiskOperation(lock)) {
+  }
+}
+
+bool FileCacheDatabase::performNextDiskOperation(
+    std::unique_lock<std::mutex>& lock) {
+  if (this->_operations.empty()) {
+    return false;
+  }
+
+  DiskOperation operation = std::move(this->_operations.front());
+  this->_operations.pop_front();
+
+  lock.unlock();
+  this->performDiskOperation(operation);
+  lock.lock();
+
+  if (operation.type == DiskOperation::Type::Write) {
+    // A newer write of the same entry may have been queued in the meantime.
+    auto pendingIt = this->_pendingWrites.find(operation.hash);
+    if (pendingIt != this->_pendingWrites.end() &&
+        pendingIt->second == operation.pContents) {
+      this->_pendingBytes -= pendingIt->second->size();
+      this->_pendingWrites.erase(pendingIt);
+    }
+  }
+
+  if (this->_operations.empty() && this->_pIndexFile) {
+    std::fflush(this->_pIndexFile);
+  }
+
+  return true;
+}
+
+void FileCacheDatabase::performDiskOperation(DiskOperation& operation) {
+  CESIUM_TRACE("FileCacheDatabase::performDiskOperation");
+
+  namespace fs = std::filesystem;
+  std::error_code error;
+
+  switch (operation.type) {
+  case DiskOperation::Type::Write: {
+    fs::path path = fs::u8path(this->getEntryPath(operation.hash));
+    fs::create_directories(path.parent_path(), error);
+
+    // Write to a temporary file first, so that a reader never sees a partly
+    // written entry.
+    fs::path temporaryPath = path;
+    temporaryPath += ".tmp";
+    std::FILE* pFile = openFile(temporaryPath, "wb");
+    bool written =
+        pFile != nullptr &&
+        std::fwrite(
+            operation.pContents->data(),
+            1,
+            operation.pContents->size(),
+            pFile) == operation.pContents->size();
+    if (pFile && std::fclose(pFile) != 0) {
+      written = false;
+    }
+
+    if (written) {
+      fs::rename(temporaryPath, path, error);
+      written = !error;
+    }
+
+    if (!written) {
+      SPDLOG_LOGGER_WARN(
+          this->_pLogger,
+          "Failed to write the cache entry {}.",
+          path.string());
+      fs::remove(temporaryPath, error);
+      return;
+    }
+
+    this->appendIndexRecord(IndexRecord{
+        putOperation,
+        operation.hash,
+        uint64_t(operation.pContents->size()),
+        int64_t(operation.expiryTime)});
+    break;
+  }
+  case DiskOperation::Type::Remove:
+    fs::remove(fs::u8path(this->getEntryPath(operation.hash)), error);
+    this->appendIndexRecord(
+        IndexRecord{removeOperation, operation.hash, 0, 0});
+    break;
+  case DiskOperation::Type::Clear:
+    if (this->_pIndexFile) {
+      std::fclose(this->_pIndexFile);
+      this->_pIndexFile = nullptr;
+    }
+    fs::remove_all(fs::u8path(this->_directory), error);
+    fs::create_directories(fs::u8path(this->_directory), error);
+    this->openIndex(true);
+    break;
+  case DiskOperation::Type::Compact: {
+    std::string indexPath = this->_directory + "/" + indexFileName;
+    std::string temporaryPath = indexPath + ".tmp";
+    std::FILE* pFile = openFile(fs::u8path(temporaryPath), "wb");
+    if (!pFile) {
+      return;
+    }
+
+    std::fwrite(indexMagic, sizeof(indexMagic), 1, pFile);
+    std::fwrite(
+        operation.liveRecords.data(),
+        sizeof(IndexRecord),
+        operation.liveRecords.size(),
+        pFile);
+    std::fclose(pFile);
+
+    if (this->_pIndexFile) {
+      std::fclose(this->_pIndexFile);
+      this->_pIndexFile = nullptr;
+    }
+
+    fs::rename(fs::u8path(temporaryPath), fs::u8path(indexPath), error);
+    if (!error) {
+      this->_indexRecordCount = operation.liveRecords.size();
+    }
+    this->openIndex(false);
+    break;
+  }
+  }
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <CesiumAsync/ICacheDatabase.h>
+
+#include <spdlog/fwd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A cache database that stores each response in its own file, as an
+ * alternative to {@link CesiumAsync::SqliteCache} that is cheaper under heavy
+ * streaming.
+ *
+ * Each entry's file is named from a hash of its key, and is read in one go
+ * when the entry is requested. The size and expiry time of every entry are
+ * recorded in an append-only index file, which is replayed when the cache is
+ * opened and compacted when it accumulates too many stale records. Entries are
+ * written on a background thread, so storing one never waits for the disk.
+ * The least recently used entries are evicted when the cache is pruned and is
+ * over its byte budget.
+ */
+class FileCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  /**
+   * @brief Opens or creates a cache in the given directory.
+   *
+   * @param pLogger The logger that receives error messages.
+   * @param directory The directory to store the cache in. Nothing else should
+   * be stored in it.
+   * @param maximumBytes The number of bytes that the cache may use on disk
+   * before entries are evicted.
+   */
+  FileCacheDatabase(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& directory,
+      uint64_t maximumBytes);
+  virtual ~FileCacheDatabase() noexcept;
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+  /**
+   * @brief Finishes the writes that are already queued and stops the disk
+   * thread.
+   *
+   * Entries stored afterwards are written on the thread that stores them.
+   * This is called by the destructor, and may be called earlier so that the
+   * thread is gone before the native code is unloaded or the .NET domain is
+   * reloaded.
+   */
+  void shutdown() noexcept;
+
+private:
+  struct Entry {
+    uint64_t size;
+    std::time_t expiryTime;
+    uint64_t lastAccess;
+  };
+
+  struct IndexRecord {
+    uint64_t operation;
+    uint64_t hash;
+    uint64_t size;
+    int64_t expiryTime;
+  };
+
+  struct DiskOperation {
+    enum class Type { Write, Remove, Clear, Compact };
+
+    Type type;
+    uint64_t hash;
+    std::shared_ptr<const std::vector<std::byte>> pContents;
+    std::time_t expiryTime;
+    std::vector<IndexRecord> liveRecords;
+  };
+
+  std::string getEntryPath(uint64_t hash) const;
+  void loadIndex();
+  void openIndex(bool truncate);
+  void appendIndexRecord(const IndexRecord& record);
+  void removeEntry(uint64_t hash) const;
+  void evictToBudget();
+  void startDiskOperations(bool diskThreadStopped);
+  void processDiskOperations();
+  void performDiskOperationsHere();
+  bool performNextDiskOperation(std::unique_lock<std::mutex>& lock);
+  void performDiskOperation(DiskOperation& operation);
+
+  std::shared_ptr<spdlog::logger> _pLogger;
+  std::string _directory;
+  uint64_t _maximumBytes;
+
+  mutable std::mutex _mutex;
+  mutable std::condition_variable _operationsAvailable;
+  mutable std::unordered_map<uint64_t, Entry> _entries;
+  mutable uint64_t _accessCounter;
+  mutable std::deque<DiskOperation> _operations;
+  mutable uint64_t _totalBytes;
+  mutable std::
+      unordered_map<uint64_t, std::shared_ptr<const std::vector<std::byte>>>
+          _pendingWrites;
+  mutable uint64_t _pendingBytes;
+  bool _stopping;
+  bool _diskThreadStopped;
+
+  // Disk operations are performed by the disk thread until it stops, and then
+  // by the threads that queue them, one at a time.
+  std::mutex _diskMutex;
+
+  // Only accessed by whichever thread performs the disk operations.
+  std::FILE* _pIndexFile;
+  std::atomic<uint64_t> _indexRecordCount;
+
+  std::thread _diskThread;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,166 @@
+#include "GltfDataReleaser.h"
+
+#include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
+#include <CesiumGltf/ExtensionModelExtFeatureMetadata.h>
+#include <CesiumGltf/Model.h>
+
+#include <cstring>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The kept buffer views are aligned to this in their new buffer, which is
+// enough for any accessor component type.
+const size_t bufferViewAlignment = 8;
+
+/**
+ * @brief Measures a glTF the way that a tileset does when it counts the memory
+ * used by its tiles. Images are counted once they're decoded, instead of in
+ * the buffer they were decoded from.
+ */
+int64_t computeDataBytes(const Model& model) {
+  int64_t bytes = 0;
+  for (const Buffer& buffer : model.buffers) {
+    bytes += int64_t(buffer.cesium.data.size());
+  }
+  for (const Image& image : model.images) {
+    const BufferView* pBufferView =
+        Model::getSafe(&model.bufferViews, image.bufferView);
+    if (pBufferView) {
+      bytes -= pBufferView->byteLength;
+    }
+    bytes += int64_t(image.cesium.pixelData.size());
+  }
+  return bytes;
+}
+
+void addAccessorBufferViews(
+    const Model& model,
+    int32_t accessorIndex,
+    std::set<int32_t>& bufferViews) {
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+  if (!pAccessor) {
+    return;
+  }
+
+  bufferViews.insert(pAccessor->bufferView);
+  if (pAccessor->sparse) {
+    bufferViews.insert(pAccessor->sparse->indices.bufferView);
+    bufferViews.insert(pAccessor->sparse->values.bufferView);
+  }
+}
+
+/**
+ * @brief Finds the buffer views that `CesiumMetadataImpl::GetFeatures` reads.
+ */
+std::set<int32_t> findMetadataBufferViews(const Model& model) {
+  std::set<int32_t> bufferViews;
+
+  const ExtensionModelExtFeatureMetadata* pModelMetadata =
+      model.getExtension<ExtensionModelExtFeatureMetadata>();
+  if (!pModelMetadata) {
+    return bufferViews;
+  }
+
+  for (const auto& [tableName, featureTable] : pModelMetadata->featureTables) {
+    for (const auto& [propertyName, property] : featureTable.properties) {
+      bufferViews.insert(property.bufferView);
+      bufferViews.insert(property.arrayOffsetBufferView);
+      bufferViews.insert(property.stringOffsetBufferView);
+    }
+  }
+
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      const ExtensionMeshPrimitiveExtFeatureMetadata* pMetadata =
+          primitive.getExtension<ExtensionMeshPrimitiveExtFeatureMetadata>();
+      if (!pMetadata) {
+        continue;
+      }
+
+      // Features are looked up by triangle, through the indices.
+      addAccessorBufferViews(model, primitive.indices, bufferViews);
+      for (const FeatureIDAttribute& attribute :
+           pMetadata->featureIdAttributes) {
+        if (!attribute.featureIds.attribute) {
+          continue;
+        }
+        auto it = primitive.attributes.find(*attribute.featureIds.attribute);
+        if (it != primitive.attributes.end()) {
+          addAccessorBufferViews(model, it->second, bufferViews);
+        }
+      }
+    }
+  }
+
+  // Properties without offsets, and accessors without buffer views, have -1
+  // in their place.
+  bufferViews.erase(-1);
+  return bufferViews;
+}
+
+} // namespace
+
+int64_t GltfDataReleaser::release(Model& model) {
+  const int64_t bytesBefore = computeDataBytes(model);
+
+  // Copy the buffer views to keep into a buffer of their own.
+  std::vector<std::byte> keptData;
+  std::vector<std::pair<BufferView*, size_t>> keptBufferViews;
+  for (int32_t index : findMetadataBufferViews(model)) {
+    BufferView* pBufferView = Model::getSafe(&model.bufferViews, index);
+    if (!pBufferView) {
+      continue;
+    }
+    const Buffer* pBuffer = Model::getSafe(&model.buffers, pBufferView->buffer);
+    if (!pBuffer || pBufferView->byteOffset < 0 ||
+        pBufferView->byteLength < 0 ||
+        pBufferView->byteOffset + pBufferView->byteLength >
+            int64_t(pBuffer->cesium.data.size())) {
+      continue;
+    }
+
+    const size_t offset = (keptData.size() + bufferViewAlignment - 1) /
+                          bufferViewAlignment * bufferViewAlignment;
+    keptData.resize(offset + size_t(pBufferView->byteLength));
+    std::memcpy(
+        keptData.data() + offset,
+        pBuffer->cesium.data.data() + pBufferView->byteOffset,
+        size_t(pBufferView->byteLength));
+    keptBufferViews.emplace_back(pBufferView, offset);
+  }
+
+  for (Buffer& buffer : model.buffers) {
+    std::vector<std::byte>().swap(buffer.cesium.data);
+    buffer.byteLength = 0;
+  }
+
+  // The textures were created from the decoded images, and the encoded images
+  // were in the buffers that were just emptied.
+  for (Image& image : model.images) {
+    std::vector<std::byte>().swap(image.cesium.pixelData);
+    image.cesium.mipPositions.clear();
+    image.bufferView = -1;
+  }
+
+  if (!keptData.empty()) {
+    const int32_t keptBufferIndex = int32_t(model.buffers.size());
+    Buffer& keptBuffer = model.buffers.emplace_back();
+    keptBuffer.byteLength = int64_t(keptData.size());
+    keptBuffer.cesium.data = std::move(keptData);
+    for (auto& [pBufferView, offset] : keptBufferViews) {
+      pBufferView->buffer = keptBufferIndex;
+      pBufferView->byteOffset = int64_t(offset);
+    }
+  }
+
+  return bytesBefore - computeDataBytes(model);
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Releases the data of a glTF that isn't needed once the Unity objects
+ * for it have been created.
+ *
+ * The vertices, indices, and images of a loaded tile are only read while its
+ * meshes and textures are created, but they stay in memory for as long as the
+ * tile is loaded. Only the buffer views that `CesiumMetadataImpl` reads to
+ * look up the features of a triangle are kept: the indices and feature IDs of
+ * the primitives with `EXT_feature_metadata`, and the feature tables. These
+ * are copied into a new buffer of their own, and every other buffer and image
+ * is emptied. Accessors of the released buffer views remain in the glTF, but
+ * views of them report that their buffer is too small.
+ */
+class GltfDataReleaser {
+public:
+  /**
+   * @brief Releases the data of a glTF.
+   *
+   * @param model The glTF.
+   * @return The number of bytes released, as a tileset counts them.
+   */
+  static int64_t release(CesiumGltf::Model& model);
+};
+
+} // namespace CesiumForUnityNative
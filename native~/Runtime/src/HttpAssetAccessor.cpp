@@ -0,0 +1,452 @@
+#include "HttpAssetAccessor.h"
+
+#include "AssetRequestCancellation.h"
+#include "DownloadBufferPool.h"
+
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <httplib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <stdexcept>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+const time_t connectionTimeoutSeconds = 10;
+const time_t readTimeoutSeconds = 30;
+
+class HttpAssetResponse : public IAssetResponse {
+public:
+  HttpAssetResponse(
+      uint16_t statusCode,
+      HttpHeaders&& headers,
+      std::vector<std::byte>&& data)
+      : _statusCode(statusCode),
+        _contentType(),
+        _headers(std::move(headers)),
+        _data(std::move(data)) {
+    auto find = this->_headers.find("content-type");
+    if (find != this->_headers.end()) {
+      this->_contentType = find->second;
+    }
+  }
+
+  virtual ~HttpAssetResponse() {
+    DownloadBufferPool::release(std::move(this->_data));
+  }
+
+  HttpAssetResponse(HttpAssetResponse&&) = default;
+
+  virtual uint16_t statusCode() const override { return _statusCode; }
+
+  virtual std::string contentType() const override { return _contentType; }
+
+  virtual const HttpHeaders& headers() const override { return _headers; }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return this->_data;
+  }
+
+private:
+  uint16_t _statusCode;
+  std::string _contentType;
+  HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class HttpAssetRequest : public IAssetRequest {
+public:
+  HttpAssetRequest(
+      const std::string& method,
+      const std::string& url,
+      HttpHeaders&& headers,
+      HttpAssetResponse&& response)
+      : _method(method),
+        _url(url),
+        _headers(std::move(headers)),
+        _response(std::move(response)) {}
+
+  virtual const std::string& method() const override { return _method; }
+
+  virtual const std::string& url() const override { return _url; }
+
+  virtual const HttpHeaders& headers() const override { return _headers; }
+
+  virtual const IAssetResponse* response() const override { return &_response; }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  HttpAssetResponse _response;
+};
+
+/**
+ * @brief Splits a URL into the scheme and authority, which identify the host
+ * to connect to, and the path and query to request from it. Returns false if
+ * the native client can't handle the URL.
+ */
+bool splitUrl(const std::string& url, std::string& host, std::string& path) {
+  size_t schemeEnd = url.find("://");
+  if (schemeEnd == std::string::npos) {
+    return false;
+  }
+
+  std::string scheme = url.substr(0, schemeEnd);
+  std::transform(
+      scheme.begin(),
+      scheme.end(),
+      scheme.begin(),
+      [](unsigned char c) { return char(std::tolower(c)); });
+
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+  if (scheme != "http" && scheme != "https") {
+    return false;
+  }
+#else
+  if (scheme != "http") {
+    return false;
+  }
+#endif
+
+  size_t authorityStart = schemeEnd + 3;
+  size_t pathStart = url.find_first_of("/?#", authorityStart);
+  std::string authority =
+      url.substr(authorityStart, pathStart - authorityStart);
+  if (authority.empty() || authority.find('@') != std::string::npos) {
+    // Leave URLs with credentials to the fallback.
+    return false;
+  }
+
+  host = scheme + "://" + authority;
+
+  if (pathStart == std::string::npos) {
+    path = "/";
+  } else {
+    size_t fragmentStart = url.find('#', pathStart);
+    path = url.substr(pathStart, fragmentStart - pathStart);
+    if (path.empty() || path[0] != '/') {
+      path.insert(path.begin(), '/');
+    }
+  }
+
+  return true;
+}
+
+std::unique_ptr<httplib::Client> createClient(const std::string& host) {
+  auto pClient = std::make_unique<httplib::Client>(host);
+  pClient->set_keep_alive(true);
+  pClient->set_follow_location(true);
+  // The URLs we're given are already encoded.
+  pClient->set_url_encode(false);
+  pClient->set_connection_timeout(connectionTimeoutSeconds);
+  pClient->set_read_timeout(readTimeoutSeconds);
+  return pClient;
+}
+
+} // namespace
+
+HttpAssetAccessor::HttpAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pFallback,
+    const HttpHeaders& requestHeaders,
+    int32_t maximumConnectionsPerHost)
+    : _pFallback(pFallback),
+      _requestHeaders(requestHeaders),
+      _maximumConnectionsPerHost(std::max(maximumConnectionsPerHost, 1)),
+      _mutex(),
+      _requestsAvailable(),
+      _pendingRequests(),
+      _hosts(),
+      _activeClients(),
+      _stopping(false),
+      _threads(),
+      _cancellationListenerID(0) {
+  // Use enough threads for two hosts, such as a tileset and its imagery, to
+  // be downloaded from at full concurrency at the same time.
+  const int32_t threadCount = 2 * this->_maximumConnectionsPerHost;
+  this->_threads.reserve(threadCount);
+  for (int32_t i = 0; i < threadCount; ++i) {
+    this->_threads.emplace_back([this]() { this->processRequests(); });
+  }
+
+  this->_cancellationListenerID = AssetRequestCancellation::addListener(
+      [this](uint64_t group) { this->cancelGroup(group); });
+}
+
+HttpAssetAccessor::~HttpAssetAccessor() noexcept { this->shutdown(); }
+
+void HttpAssetAccessor::shutdown() noexcept {
+  std::deque<PendingRequest> abandonedRequests;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_stopping) {
+      return;
+    }
+    this->_stopping = true;
+
+    // Abort the requests in progress so that the threads finish promptly.
+    for (const auto& activeClient : this->_activeClients) {
+      activeClient.first->stop();
+    }
+
+    abandonedRequests.swap(this->_pendingRequests);
+  }
+
+  AssetRequestCancellation::removeListener(this->_cancellationListenerID);
+
+  this->_requestsAvailable.notify_all();
+  for (std::thread& thread : this->_threads) {
+    thread.join();
+  }
+
+  for (PendingRequest& request : abandonedRequests) {
+    request.promise.reject(std::runtime_error(
+        "Request for " + request.url +
+        " was abandoned because the asset accessor was shut down."));
+  }
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+HttpAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->request(asyncSystem, "GET", url, headers);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+HttpAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  std::string host;
+  std::string path;
+  if (!splitUrl(url, host, path)) {
+    return this->_pFallback
+        ->request(asyncSystem, verb, url, headers, contentPayload);
+  }
+
+  HttpHeaders requestHeaders = this->_requestHeaders;
+  for (const THeader& header : headers) {
+    requestHeaders.insert(header);
+  }
+
+  Promise<std::shared_ptr<IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+  Future<std::shared_ptr<IAssetRequest>> future = promise.getFuture();
+
+  uint64_t group = AssetRequestCancellation::takeGroup(requestHeaders);
+  if (AssetRequestCancellation::isCancelled(group)) {
+    AssetRequestCancellation::recordCancelledRequest(0);
+    promise.reject(std::runtime_error(
+        "Request for " + url + " was cancelled before it was sent."));
+    return future;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_stopping) {
+      promise.reject(std::runtime_error(
+          "Request for " + url +
+          " was abandoned because the asset accessor was shut down."));
+      return future;
+    }
+
+    this->_pendingRequests.push_back(PendingRequest{
+        verb,
+        url,
+        std::move(host),
+        std::move(path),
+        std::move(requestHeaders),
+        group,
+        std::vector<std::byte>(contentPayload.begin(), contentPayload.end()),
+        std::move(promise)});
+  }
+
+  this->_requestsAvailable.notify_one();
+
+  return future;
+}
+
+void HttpAssetAccessor::tick() noexcept { this->_pFallback->tick(); }
+
+void HttpAssetAccessor::processRequests() {
+  std::unique_lock<std::mutex> lock(this->_mutex);
+
+  while (true) {
+    // Take the oldest request to a host that isn't already at its limit.
+    auto requestIt = this->_pendingRequests.end();
+    this->_requestsAvailable.wait(lock, [this, &requestIt]() {
+      if (this->_stopping) {
+        return true;
+      }
+
+      requestIt = std::find_if(
+          this->_pendingRequests.begin(),
+          this->_pendingRequests.end(),
+          [this](const PendingRequest& request) {
+            auto hostIt = this->_hosts.find(request.host);
+            return hostIt == this->_hosts.end() ||
+                   hostIt->second.activeRequests <
+                       this->_maximumConnectionsPerHost;
+          });
+      return requestIt != this->_pendingRequests.end();
+    });
+
+    if (this->_stopping) {
+      return;
+    }
+
+    PendingRequest request = std::move(*requestIt);
+    this->_pendingRequests.erase(requestIt);
+
+    // Reuse an idle connection to the host if there is one.
+    Host& host = this->_hosts[request.host];
+    ++host.activeRequests;
+
+    std::unique_ptr<httplib::Client> pClient;
+    if (!host.idleClients.empty()) {
+      pClient = std::move(host.idleClients.back());
+      host.idleClients.pop_back();
+    } else {
+      pClient = createClient(request.host);
+    }
+
+    this->_activeClients.emplace(pClient.get(), request.group);
+
+    lock.unlock();
+    this->sendRequest(request, *pClient);
+    lock.lock();
+
+    this->_activeClients.erase(pClient.get());
+    --host.activeRequests;
+    if (!this->_stopping) {
+      host.idleClients.emplace_back(std::move(pClient));
+    }
+
+    // A request that was waiting for this host can be sent now.
+    this->_requestsAvailable.notify_one();
+  }
+}
+
+void HttpAssetAccessor::sendRequest(
+    PendingRequest& request,
+    httplib::Client& client) {
+  CESIUM_TRACE("Cesium::HttpAssetAccessor::sendRequest");
+
+  httplib::Request httpRequest;
+  httpRequest.method = request.verb;
+  httpRequest.path = request.path;
+  for (const auto& header : request.headers) {
+    httpRequest.headers.emplace(header.first, header.second);
+  }
+  if (!request.payload.empty()) {
+    httpRequest.body.assign(
+        reinterpret_cast<const char*>(request.payload.data()),
+        request.payload.size());
+  }
+
+  // Receive the body directly into a pooled buffer, sized from the
+  // Content-Length when there is one, rather than into a string that would
+  // have to be copied afterward.
+  std::vector<std::byte> data = DownloadBufferPool::acquire();
+  httpRequest.content_receiver = [&data, group = request.group](
+                                     const char* pChunk,
+                                     size_t length,
+                                     uint64_t offset,
+                                     uint64_t totalLength) {
+    // Stopping the client doesn't help if the request was cancelled before
+    // the client was connected, so check here as well.
+    if (AssetRequestCancellation::isCancelled(group)) {
+      return false;
+    }
+
+    if (offset == 0) {
+      // A new response, such as the target of a redirect, is starting.
+      data.clear();
+      if (totalLength > data.capacity()) {
+        data.reserve(size_t(totalLength));
+      }
+    }
+
+    const std::byte* p = reinterpret_cast<const std::byte*>(pChunk);
+    data.insert(data.end(), p, p + length);
+    return true;
+  };
+
+  httplib::Response httpResponse;
+  httplib::Error error = httplib::Error::Success;
+  if (!client.send(httpRequest, httpResponse, error)) {
+    if (AssetRequestCancellation::isCancelled(request.group)) {
+      AssetRequestCancellation::recordCancelledRequest(data.size());
+      DownloadBufferPool::release(std::move(data));
+      request.promise.reject(
+          std::runtime_error("Request for " + request.url + " was cancelled."));
+      return;
+    }
+
+    DownloadBufferPool::release(std::move(data));
+    request.promise.reject(std::runtime_error(
+        "Request for " + request.url +
+        " failed: " + httplib::to_string(error)));
+    return;
+  }
+
+  HttpHeaders responseHeaders;
+  for (const auto& header : httpResponse.headers) {
+    responseHeaders.emplace(header.first, header.second);
+  }
+
+  request.promise.resolve(std::make_shared<HttpAssetRequest>(
+      request.verb,
+      request.url,
+      std::move(request.headers),
+      HttpAssetResponse(
+          static_cast<uint16_t>(httpResponse.status),
+          std::move(responseHeaders),
+          std::move(data))));
+}
+
+void HttpAssetAccessor::cancelGroup(uint64_t group) {
+  std::vector<PendingRequest> cancelledRequests;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto it = std::stable_partition(
+        this->_pendingRequests.begin(),
+        this->_pendingRequests.end(),
+        [group](const PendingRequest& request) {
+          return request.group != group;
+        });
+    std::move(
+        it,
+        this->_pendingRequests.end(),
+        std::back_inserter(cancelledRequests));
+    this->_pendingRequests.erase(it, this->_pendingRequests.end());
+
+    for (const auto& activeClient : this->_activeClients) {
+      if (activeClient.second == group) {
+        activeClient.first->stop();
+      }
+    }
+  }
+
+  for (PendingRequest& request : cancelledRequests) {
+    AssetRequestCancellation::recordCancelledRequest(0);
+    request.promise.reject(std::runtime_error(
+        "Request for " + request.url + " was cancelled before it was sent."));
+  }
+}
+
+} // namespace CesiumForUnityNative
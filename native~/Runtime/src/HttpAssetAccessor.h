@@ -0,0 +1,115 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumAsync/IAssetAccessor.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace httplib {
+class Client;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief An asset accessor that downloads with a native HTTP client on its own
+ * background threads, so that requests never need the Unity main thread.
+ *
+ * Connections are kept alive and reused for later requests to the same host,
+ * and no more than a configurable number of requests are sent to any one host
+ * at a time. Requests that the native client can't handle, such as HTTPS
+ * requests when it was built without TLS support, are passed to a fallback
+ * accessor instead.
+ *
+ * When a request group is cancelled with {@link AssetRequestCancellation},
+ * the group's queued requests are dropped and its requests in progress are
+ * aborted.
+ */
+class HttpAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * @brief Creates a new accessor.
+   *
+   * @param pFallback The accessor to use for requests that can't be handled
+   * natively.
+   * @param requestHeaders The headers to add to every request.
+   * @param maximumConnectionsPerHost The maximum number of simultaneous
+   * requests to each host.
+   */
+  HttpAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pFallback,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      int32_t maximumConnectionsPerHost);
+  virtual ~HttpAssetAccessor() noexcept;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers = {}) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers = std::vector<THeader>(),
+      const gsl::span<const std::byte>& contentPayload = {}) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Aborts the requests in progress, rejects the queued ones, and stops
+   * the threads.
+   *
+   * Requests made afterwards are rejected. This is called by the destructor,
+   * and may be called earlier so that the threads are gone before the native
+   * code is unloaded or the .NET domain is reloaded.
+   */
+  void shutdown() noexcept;
+
+private:
+  struct PendingRequest {
+    std::string verb;
+    std::string url;
+    std::string host;
+    std::string path;
+    CesiumAsync::HttpHeaders headers;
+    uint64_t group;
+    std::vector<std::byte> payload;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise;
+  };
+
+  struct Host {
+    int32_t activeRequests = 0;
+    std::vector<std::unique_ptr<httplib::Client>> idleClients;
+  };
+
+  void processRequests();
+  void sendRequest(PendingRequest& request, httplib::Client& client);
+  void cancelGroup(uint64_t group);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pFallback;
+  CesiumAsync::HttpHeaders _requestHeaders;
+  int32_t _maximumConnectionsPerHost;
+
+  std::mutex _mutex;
+  std::condition_variable _requestsAvailable;
+  std::deque<PendingRequest> _pendingRequests;
+  std::unordered_map<std::string, Host> _hosts;
+  // The clients with requests in progress, and the groups of those requests.
+  std::unordered_map<httplib::Client*, uint64_t> _activeClients;
+  bool _stopping;
+  std::vector<std::thread> _threads;
+  int32_t _cancellationListenerID;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,291 @@
+#include "InflatingAssetAccessor.h"
+
+#include "DownloadBufferPool.h"
+
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// Gzipped responses larger than this are inflated in a worker thread rather
+// than in whichever thread completed the request.
+const size_t minimumWorkerThreadBytes = 64 * 1024;
+
+// Deflate can't expand data by more than about this much, so a larger length
+// in the gzip trailer is corrupt.
+const size_t maximumInflateRatio = 1032;
+
+/**
+ * @brief The inflate state of one thread, which is reset between responses
+ * instead of being allocated again for each one.
+ */
+class InflateState {
+public:
+  InflateState() noexcept : _stream(), _initialized(false) {}
+
+  ~InflateState() noexcept {
+    if (this->_initialized) {
+      inflateEnd(&this->_stream);
+    }
+  }
+
+  InflateState(const InflateState&) = delete;
+  InflateState& operator=(const InflateState&) = delete;
+
+  z_stream* begin() noexcept {
+    if (!this->_initialized) {
+      this->_stream = z_stream();
+      // Adding 16 to the window bits makes zlib expect a gzip header.
+      if (inflateInit2(&this->_stream, 16 + MAX_WBITS) != Z_OK) {
+        return nullptr;
+      }
+      this->_initialized = true;
+    } else if (inflateReset(&this->_stream) != Z_OK) {
+      return nullptr;
+    }
+
+    return &this->_stream;
+  }
+
+private:
+  z_stream _stream;
+  bool _initialized;
+};
+
+thread_local InflateState inflateState;
+
+bool isGzip(const gsl::span<const std::byte>& data) {
+  // A gzip stream has a 10 byte header and an 8 byte trailer.
+  return data.size() >= 18 && data[0] == std::byte{0x1f} &&
+         data[1] == std::byte{0x8b};
+}
+
+/**
+ * @brief Inflates a gzip stream into a buffer from the pool. Returns false,
+ * with the buffer released, if the data isn't valid.
+ */
+bool inflateGzip(
+    const gsl::span<const std::byte>& compressed,
+    std::vector<std::byte>& result) {
+  if (compressed.size() > std::numeric_limits<uInt>::max()) {
+    return false;
+  }
+
+  // The trailer ends with the uncompressed length, modulo 2^32, in little
+  // endian order.
+  const std::byte* pTrailer = compressed.data() + compressed.size() - 4;
+  size_t expectedSize = size_t(uint32_t(pTrailer[0])) |
+                        size_t(uint32_t(pTrailer[1])) << 8 |
+                        size_t(uint32_t(pTrailer[2])) << 16 |
+                        size_t(uint32_t(pTrailer[3])) << 24;
+  if (expectedSize == 0 ||
+      expectedSize > compressed.size() * maximumInflateRatio) {
+    // Guess, and grow as needed.
+    expectedSize = compressed.size() * 4;
+  }
+
+  z_stream* pStream = inflateState.begin();
+  if (!pStream) {
+    return false;
+  }
+
+  result = DownloadBufferPool::acquire(expectedSize);
+  result.resize(expectedSize);
+
+  pStream->next_in =
+      reinterpret_cast<Bytef*>(const_cast<std::byte*>(compressed.data()));
+  pStream->avail_in = uInt(compressed.size());
+
+  // When the trailer is right, this inflates everything in the first pass.
+  size_t written = 0;
+  while (true) {
+    if (written == result.size()) {
+      result.resize(result.size() * 2);
+    }
+
+    size_t available = std::min(
+        result.size() - written,
+        size_t(std::numeric_limits<uInt>::max()));
+    pStream->next_out = reinterpret_cast<Bytef*>(result.data() + written);
+    pStream->avail_out = uInt(available);
+
+    int status = inflate(pStream, Z_NO_FLUSH);
+    written += available - pStream->avail_out;
+
+    if (status == Z_STREAM_END) {
+      result.resize(written);
+      return true;
+    }
+
+    // Z_BUF_ERROR with room left for output means the input was truncated.
+    if ((status != Z_OK && status != Z_BUF_ERROR) ||
+        (status == Z_BUF_ERROR && pStream->avail_out != 0)) {
+      DownloadBufferPool::release(std::move(result));
+      return false;
+    }
+  }
+}
+
+class InflatedAssetResponse : public IAssetResponse {
+public:
+  InflatedAssetResponse(
+      const IAssetResponse* pResponse,
+      std::vector<std::byte>&& data) noexcept
+      : _pResponse(pResponse), _data(std::move(data)) {}
+
+  virtual ~InflatedAssetResponse() {
+    DownloadBufferPool::release(std::move(this->_data));
+  }
+
+  virtual uint16_t statusCode() const override {
+    return this->_pResponse->statusCode();
+  }
+
+  virtual std::string contentType() const override {
+    return this->_pResponse->contentType();
+  }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_pResponse->headers();
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return this->_data;
+  }
+
+private:
+  const IAssetResponse* _pResponse;
+  std::vector<std::byte> _data;
+};
+
+class InflatedAssetRequest : public IAssetRequest {
+public:
+  InflatedAssetRequest(
+      std::shared_ptr<IAssetRequest>&& pRequest,
+      std::vector<std::byte>&& data)
+      : _pRequest(std::move(pRequest)),
+        _response(this->_pRequest->response(), std::move(data)) {}
+
+  virtual const std::string& method() const override {
+    return this->_pRequest->method();
+  }
+
+  virtual const std::string& url() const override {
+    return this->_pRequest->url();
+  }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_pRequest->headers();
+  }
+
+  virtual const IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::shared_ptr<IAssetRequest> _pRequest;
+  InflatedAssetResponse _response;
+};
+
+} // namespace
+
+InflatingAssetAccessor::InflatingAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAccessor)
+    : _pAccessor(pAccessor),
+      _responses(0),
+      _compressedBytes(0),
+      _inflatedBytes(0),
+      _inflateNanoseconds(0) {}
+
+Future<std::shared_ptr<IAssetRequest>> InflatingAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->inflateIfNeeded(
+      asyncSystem,
+      this->_pAccessor->get(asyncSystem, url, headers));
+}
+
+Future<std::shared_ptr<IAssetRequest>> InflatingAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->inflateIfNeeded(
+      asyncSystem,
+      this->_pAccessor
+          ->request(asyncSystem, verb, url, headers, contentPayload));
+}
+
+void InflatingAssetAccessor::tick() noexcept { this->_pAccessor->tick(); }
+
+InflatingAssetAccessor::Statistics
+InflatingAssetAccessor::getStatistics() const noexcept {
+  return Statistics{
+      this->_responses.load(),
+      this->_compressedBytes.load(),
+      this->_inflatedBytes.load(),
+      double(this->_inflateNanoseconds.load()) / 1e9};
+}
+
+Future<std::shared_ptr<IAssetRequest>> InflatingAssetAccessor::inflateIfNeeded(
+    const AsyncSystem& asyncSystem,
+    Future<std::shared_ptr<IAssetRequest>>&& future) {
+  return std::move(future).thenImmediately(
+      [pThis = this, asyncSystem](std::shared_ptr<IAssetRequest>&& pRequest) {
+        const IAssetResponse* pResponse = pRequest->response();
+        if (!pResponse || !isGzip(pResponse->data())) {
+          return asyncSystem.createResolvedFuture(std::move(pRequest));
+        }
+
+        if (pResponse->data().size() < minimumWorkerThreadBytes) {
+          return asyncSystem.createResolvedFuture(
+              pThis->inflate(std::move(pRequest)));
+        }
+
+        return asyncSystem.runInWorkerThread(
+            [pThis, pRequest = std::move(pRequest)]() mutable {
+              return pThis->inflate(std::move(pRequest));
+            });
+      });
+}
+
+std::shared_ptr<IAssetRequest>
+InflatingAssetAccessor::inflate(std::shared_ptr<IAssetRequest>&& pRequest) {
+  CESIUM_TRACE("InflatingAssetAccessor::inflate");
+
+  auto start = std::chrono::steady_clock::now();
+
+  gsl::span<const std::byte> compressed = pRequest->response()->data();
+  std::vector<std::byte> data;
+  if (!inflateGzip(compressed, data)) {
+    // Pass it on as it is, like GunzipAssetAccessor does.
+    return std::move(pRequest);
+  }
+
+  ++this->_responses;
+  this->_compressedBytes += uint64_t(compressed.size());
+  this->_inflatedBytes += uint64_t(data.size());
+  this->_inflateNanoseconds +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+  return std::make_shared<InflatedAssetRequest>(
+      std::move(pRequest),
+      std::move(data));
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief An asset accessor that inflates gzipped response data, in place of
+ * {@link CesiumAsync::GunzipAssetAccessor}.
+ *
+ * A gzip stream ends with the length of its uncompressed data, so the data is
+ * inflated in a single pass into a buffer of exactly the right size, taken
+ * from the {@link DownloadBufferPool} and returned to it when the response is
+ * destroyed. Each thread reuses its inflate state rather than allocating a new
+ * one per response. Large responses are inflated in a worker thread, because
+ * requests made with `UnityWebRequest` complete in the main thread.
+ */
+class InflatingAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  struct Statistics {
+    /**
+     * @brief The number of responses that have been inflated.
+     */
+    uint64_t responses;
+
+    /**
+     * @brief The number of gzipped bytes that have been inflated.
+     */
+    uint64_t compressedBytes;
+
+    /**
+     * @brief The number of bytes that gzipped data has inflated to.
+     */
+    uint64_t inflatedBytes;
+
+    /**
+     * @brief The time, in seconds, spent inflating.
+     */
+    double inflateSeconds;
+  };
+
+  /**
+   * @brief Creates a new accessor.
+   *
+   * @param pAccessor The accessor to make requests with.
+   */
+  InflatingAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAccessor);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers = {}) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers = std::vector<THeader>(),
+      const gsl::span<const std::byte>& contentPayload = {}) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Gets the totals of the data inflated so far.
+   */
+  Statistics getStatistics() const noexcept;
+
+private:
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  inflateIfNeeded(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>&&
+          future);
+  std::shared_ptr<CesiumAsync::IAssetRequest>
+  inflate(std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAccessor;
+
+  std::atomic<uint64_t> _responses;
+  std::atomic<uint64_t> _compressedBytes;
+  std::atomic<uint64_t> _inflatedBytes;
+  std::atomic<int64_t> _inflateNanoseconds;
+};
+
+} // namespace CesiumForUnityNative
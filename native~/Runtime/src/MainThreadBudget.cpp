@@ -0,0 +1,143 @@
+#include "MainThreadBudget.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The budget never drops below this, so that loading continues, however
+// slowly, even when the application alone takes longer than a frame.
+const double minimumBudgetMilliseconds = 0.5;
+
+// The budget never takes more than this fraction of the target frame time.
+const double maximumBudgetFraction = 0.5;
+
+// The budget that the first frame starts with, which was once the fixed time
+// limit of every tileset.
+const double initialBudgetMilliseconds = 5.0;
+
+// How much the budget grows after a frame that was on time, and how much of
+// it, or of what was spent if that's less, is kept after a frame that was
+// late.
+const double budgetIncreaseMilliseconds = 0.1;
+const double budgetDecreaseFactor = 0.75;
+
+// A frame isn't late unless it takes this much longer than the target, which
+// allows for the jitter of frames that are paced by vsync.
+const double lateFrameTolerance = 1.1;
+
+// Most of the budget goes to loading. Unloading only needs to keep pace with
+// the tiles that loading pushes out of the cache.
+const double loadingFraction = 0.75;
+
+const int32_t defaultTargetFrameRate = 60;
+
+struct TilesetReport {
+  size_t loadQueueLength;
+};
+
+int32_t currentFrame = -1;
+double budget = initialBudgetMilliseconds;
+double targetFrame = 1000.0 / defaultTargetFrameRate;
+double lastFrame = 0.0;
+double lastUpdates = 0.0;
+
+// What the tilesets reported in the previous frame, which the budget of the
+// current frame is shared by.
+std::unordered_map<const void*, TilesetReport> previousReports;
+size_t previousWeight = 0;
+
+// What the tilesets have reported so far in the current frame.
+std::unordered_map<const void*, TilesetReport> currentReports;
+double currentUpdates = 0.0;
+size_t currentMainThreadLoadQueueLength = 0;
+
+size_t weightOf(const TilesetReport& report) {
+  // Tilesets with nothing to load still get a little, so that they can
+  // unload.
+  return report.loadQueueLength + 1;
+}
+
+void beginFrame(
+    int32_t frame,
+    double frameMilliseconds,
+    int32_t targetFrameRate) {
+  targetFrame = 1000.0 / (targetFrameRate > 0 ? targetFrameRate
+                                              : defaultTargetFrameRate);
+  lastFrame = frameMilliseconds;
+  lastUpdates = currentUpdates;
+
+  const double maximumBudget =
+      std::max(minimumBudgetMilliseconds, maximumBudgetFraction * targetFrame);
+  if (currentFrame >= 0) {
+    if (frameMilliseconds > lateFrameTolerance * targetFrame) {
+      // Shrink from what the tilesets actually spent, so that a budget they
+      // weren't using doesn't take several late frames to come down.
+      budget = budgetDecreaseFactor * std::min(budget, currentUpdates);
+    } else if (currentMainThreadLoadQueueLength > 0) {
+      // Only grow the budget while it's what is holding tiles back.
+      budget += budgetIncreaseMilliseconds;
+    }
+  }
+  budget = std::clamp(budget, minimumBudgetMilliseconds, maximumBudget);
+
+  previousReports = std::move(currentReports);
+  currentReports.clear();
+  previousWeight = 0;
+  for (const auto& [pTileset, report] : previousReports) {
+    previousWeight += weightOf(report);
+  }
+
+  currentFrame = frame;
+  currentUpdates = 0.0;
+  currentMainThreadLoadQueueLength = 0;
+}
+
+} // namespace
+
+MainThreadBudget::Allocation MainThreadBudget::beginUpdate(
+    int32_t frame,
+    const void* pTileset,
+    double frameMilliseconds,
+    int32_t targetFrameRate) {
+  if (frame != currentFrame) {
+    beginFrame(frame, frameMilliseconds, targetFrameRate);
+  }
+
+  // A tileset that didn't update in the previous frame is weighted as if it
+  // had nothing to load.
+  double share;
+  auto it = previousReports.find(pTileset);
+  if (it != previousReports.end()) {
+    share = budget * double(weightOf(it->second)) / double(previousWeight);
+  } else if (previousWeight > 0) {
+    share = budget / double(previousWeight + 1);
+  } else {
+    // No tileset updated in the previous frame, so there's nothing to tell
+    // how many will share this one. Every tileset gets the same small share
+    // rather than the whole budget, until they've all reported.
+    share = std::min(budget, minimumBudgetMilliseconds);
+  }
+
+  return Allocation{
+      loadingFraction * share,
+      (1.0 - loadingFraction) * share};
+}
+
+void MainThreadBudget::endUpdate(
+    const void* pTileset,
+    double updateMilliseconds,
+    size_t loadQueueLength,
+    size_t mainThreadLoadQueueLength) {
+  currentReports[pTileset] = TilesetReport{loadQueueLength};
+  currentUpdates += updateMilliseconds;
+  currentMainThreadLoadQueueLength += mainThreadLoadQueueLength;
+}
+
+MainThreadBudget::Statistics MainThreadBudget::getStatistics() {
+  return Statistics{budget, targetFrame, lastFrame, lastUpdates};
+}
+
+} // namespace CesiumForUnityNative
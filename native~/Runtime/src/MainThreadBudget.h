@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Divides one main thread time budget for loading and unloading tiles
+ * among all tilesets, and adjusts it from frame to frame so that the frame
+ * rate stays on target.
+ *
+ * Each tileset's update calls {@link beginUpdate} for its time limits and
+ * {@link endUpdate} to report what it cost. At the start of each frame, the
+ * budget grows a little if the previous frame was on time and tiles were left
+ * waiting for the main thread, and shrinks by a fraction if the previous frame
+ * was late. The budget is shared by the tilesets that updated in the previous
+ * frame, in proportion to the number of tiles each had waiting to load.
+ * Every update that calls {@link beginUpdate} must also call
+ * {@link endUpdate}, even when it returns early, or it won't be counted in the
+ * next frame's shares.
+ */
+class MainThreadBudget {
+public:
+  /**
+   * @brief The time limits for one tileset's update.
+   */
+  struct Allocation {
+    /**
+     * @brief The time to spend creating the Unity objects of loaded tiles, in
+     * milliseconds.
+     */
+    double loadingMilliseconds;
+
+    /**
+     * @brief The time to spend unloading tiles from the cache and destroying
+     * their Unity objects, in milliseconds.
+     */
+    double unloadingMilliseconds;
+  };
+
+  struct Statistics {
+    /**
+     * @brief The budget shared by all tilesets in the current frame, in
+     * milliseconds.
+     */
+    double budgetMilliseconds;
+
+    /**
+     * @brief The time that the previous frame should have taken, in
+     * milliseconds.
+     */
+    double targetFrameMilliseconds;
+
+    /**
+     * @brief The time that the previous frame took, in milliseconds.
+     */
+    double frameMilliseconds;
+
+    /**
+     * @brief The time that all tilesets' updates took in the previous frame,
+     * in milliseconds.
+     */
+    double updateMilliseconds;
+  };
+
+  /**
+   * @brief Gets the time limits for a tileset's update. The first call in
+   * each frame adjusts the budget from the previous frame.
+   *
+   * @param frame The current frame.
+   * @param pTileset The tileset.
+   * @param frameMilliseconds The time that the previous frame took, in
+   * milliseconds.
+   * @param targetFrameRate The frame rate to aim for. If this is zero or
+   * negative, 60 frames per second is used.
+   */
+  static Allocation beginUpdate(
+      int32_t frame,
+      const void* pTileset,
+      double frameMilliseconds,
+      int32_t targetFrameRate);
+
+  /**
+   * @brief Reports what a tileset's update cost.
+   *
+   * @param pTileset The tileset.
+   * @param updateMilliseconds The time that the update took, in milliseconds.
+   * @param loadQueueLength The number of tiles that are waiting to load,
+   * whether in worker threads or in the main thread.
+   * @param mainThreadLoadQueueLength The number of those tiles that are
+   * waiting for the main thread.
+   */
+  static void endUpdate(
+      const void* pTileset,
+      double updateMilliseconds,
+      size_t loadQueueLength,
+      size_t mainThreadLoadQueueLength);
+
+  /**
+   * @brief Gets the current state of the budget.
+   */
+  static Statistics getStatistics();
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,206 @@
+#include "MainThreadDispatcher.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+const std::array<double, MainThreadDispatcher::histogramBuckets - 1>
+    MainThreadDispatcher::histogramLimits{0.1, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct QueuedTask {
+  std::function<void()> f;
+  CesiumAsync::AsyncSystem asyncSystem;
+  const void* pOwner;
+};
+
+std::mutex queueMutex;
+std::array<std::deque<QueuedTask>, taskPriorityCount> queues;
+size_t queuedTasks = 0;
+std::vector<const void*> drainingOwners;
+
+// The state below is only used by the main thread.
+int32_t currentFrame = -1;
+double frameMilliseconds = 0.0;
+bool frameDispatchedAny = false;
+size_t maximumQueuedTasks = 0;
+uint64_t dispatchedTasks = 0;
+MainThreadDispatcher::Histogram taskTimes{};
+MainThreadDispatcher::Histogram frameTimes{};
+
+void record(MainThreadDispatcher::Histogram& histogram, double milliseconds) {
+  const auto& limits = MainThreadDispatcher::histogramLimits;
+  size_t bucket = size_t(
+      std::upper_bound(limits.begin(), limits.end(), milliseconds) -
+      limits.begin());
+  ++histogram[bucket];
+}
+
+void endFrame() {
+  if (frameMilliseconds > 0.0) {
+    record(frameTimes, frameMilliseconds);
+  }
+  frameMilliseconds = 0.0;
+  frameDispatchedAny = false;
+}
+
+bool popTask(std::function<void()>& task) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  for (std::deque<QueuedTask>& queue : queues) {
+    if (!queue.empty()) {
+      task = std::move(queue.front().f);
+      queue.pop_front();
+      --queuedTasks;
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+void MainThreadDispatcher::enqueue(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const void* pOwner,
+    TaskPriority priority,
+    std::function<void()>&& task) {
+  std::unique_lock<std::mutex> lock(queueMutex);
+  if (std::find(drainingOwners.begin(), drainingOwners.end(), pOwner) !=
+      drainingOwners.end()) {
+    lock.unlock();
+    asyncSystem.runInMainThread(std::move(task));
+    return;
+  }
+
+  queues[size_t(priority)].emplace_back(
+      QueuedTask{std::move(task), asyncSystem, pOwner});
+  ++queuedTasks;
+}
+
+void MainThreadDispatcher::beginDraining(const void* pOwner) {
+  std::vector<QueuedTask> drained;
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    drainingOwners.emplace_back(pOwner);
+
+    for (std::deque<QueuedTask>& queue : queues) {
+      auto it = std::stable_partition(
+          queue.begin(),
+          queue.end(),
+          [pOwner](const QueuedTask& task) { return task.pOwner != pOwner; });
+      std::move(it, queue.end(), std::back_inserter(drained));
+      queue.erase(it, queue.end());
+    }
+    queuedTasks -= drained.size();
+  }
+
+  for (QueuedTask& task : drained) {
+    task.asyncSystem.runInMainThread(std::move(task.f));
+  }
+}
+
+void MainThreadDispatcher::endDraining(const void* pOwner) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  auto it = std::find(drainingOwners.begin(), drainingOwners.end(), pOwner);
+  if (it != drainingOwners.end()) {
+    drainingOwners.erase(it);
+  }
+}
+
+double MainThreadDispatcher::dispatch(
+    int32_t frame,
+    double frameTimeLimitMilliseconds,
+    double callTimeLimitMilliseconds) {
+  CESIUM_TRACE("Cesium::MainThreadDispatcher::dispatch");
+
+  if (frame < 0 || frame != currentFrame) {
+    endFrame();
+    currentFrame = frame;
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    maximumQueuedTasks = std::max(maximumQueuedTasks, queuedTasks);
+  }
+
+  const bool frameUnlimited = frameTimeLimitMilliseconds <= 0.0;
+  const bool callUnlimited = callTimeLimitMilliseconds <= 0.0;
+  double callMilliseconds = 0.0;
+
+  // Each frame runs at least one task, so the queue always makes progress,
+  // but later calls in the frame don't run anything once the time is used up.
+  std::function<void()> task;
+  while (!frameDispatchedAny ||
+         ((frameUnlimited || frameMilliseconds < frameTimeLimitMilliseconds) &&
+          (callUnlimited || callMilliseconds < callTimeLimitMilliseconds))) {
+    if (!popTask(task)) {
+      break;
+    }
+
+    const Clock::time_point start = Clock::now();
+    try {
+      task();
+    } catch (const std::exception& e) {
+      SPDLOG_LOGGER_ERROR(
+          spdlog::default_logger(),
+          "A main thread task failed: {}",
+          e.what());
+    } catch (...) {
+      SPDLOG_LOGGER_ERROR(
+          spdlog::default_logger(),
+          "A main thread task failed with an unknown error.");
+    }
+    task = nullptr;
+
+    const double milliseconds =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    record(taskTimes, milliseconds);
+    frameMilliseconds += milliseconds;
+    callMilliseconds += milliseconds;
+    ++dispatchedTasks;
+    frameDispatchedAny = true;
+  }
+
+  return callMilliseconds;
+}
+
+MainThreadDispatcher::Statistics MainThreadDispatcher::getStatistics() {
+  Statistics result{};
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    result.queuedTasks = queuedTasks;
+  }
+  result.maximumQueuedTasks = maximumQueuedTasks;
+  result.dispatchedTasks = dispatchedTasks;
+  result.taskTimes = taskTimes;
+  result.frameTimes = frameTimes;
+  return result;
+}
+
+std::string MainThreadDispatcher::formatHistogram(const Histogram& histogram) {
+  std::string result;
+  for (size_t i = 0; i < histogram.size(); ++i) {
+    if (i > 0) {
+      result += ' ';
+    }
+    if (i < histogramLimits.size()) {
+      result += fmt::format("<{}:{}", histogramLimits[i], histogram[i]);
+    } else {
+      result += fmt::format(">={}:{}", histogramLimits.back(), histogram[i]);
+    }
+  }
+  return result;
+}
+
+} // namespace CesiumForUnityNative
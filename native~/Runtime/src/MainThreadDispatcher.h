@@ -0,0 +1,203 @@
+#pragma once
+
+#include "TaskPriority.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/Future.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Runs tile loading work that must happen on the main thread, such as
+ * allocating and applying mesh data, under a per-frame time budget shared by
+ * all tilesets.
+ *
+ * Work that is run with {@link CesiumAsync::AsyncSystem::runInMainThread}
+ * happens whenever the tileset that queued it next updates, all at once,
+ * however long that takes. Work that is run with {@link run} instead waits in
+ * a single queue, in {@link TaskPriority} order, until {@link dispatch} has
+ * time for it.
+ *
+ * A tileset's destructor waits for its loads in progress by running only the
+ * main thread tasks of its own async system, so before a tileset is destroyed
+ * the tasks it owns must be handed back with {@link beginDraining}.
+ */
+class MainThreadDispatcher {
+public:
+  /**
+   * @brief The number of buckets in a histogram of times.
+   */
+  static constexpr size_t histogramBuckets = 8;
+
+  /**
+   * @brief The upper limit of each bucket of a histogram of times, in
+   * milliseconds, except the last, which has no upper limit.
+   */
+  static const std::array<double, histogramBuckets - 1> histogramLimits;
+
+  /**
+   * @brief The number of times that fell in each bucket.
+   */
+  using Histogram = std::array<uint64_t, histogramBuckets>;
+
+  struct Statistics {
+    /**
+     * @brief The number of tasks that are waiting to run.
+     */
+    size_t queuedTasks;
+
+    /**
+     * @brief The most tasks that have been waiting at the start of a frame.
+     */
+    size_t maximumQueuedTasks;
+
+    /**
+     * @brief The number of tasks that have been run.
+     */
+    uint64_t dispatchedTasks;
+
+    /**
+     * @brief How long each task took to run.
+     */
+    Histogram taskTimes;
+
+    /**
+     * @brief How long was spent running tasks in each frame that ran any.
+     */
+    Histogram frameTimes;
+  };
+
+  /**
+   * @brief Runs a function in the main thread when there's time for it.
+   *
+   * @param asyncSystem The async system that the returned future belongs to.
+   * @param pOwner The object that the function is run for, which identifies
+   * the function's tasks to {@link beginDraining}.
+   * @param priority The priority of the function.
+   * @param f The function. It may return a future, in which case the returned
+   * future resolves when that one does.
+   * @return A future that resolves with the function's result.
+   */
+  template <typename Func>
+  static auto run(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const void* pOwner,
+      TaskPriority priority,
+      Func&& f);
+
+  /**
+   * @brief Runs queued tasks, most urgent first, until none are left or a
+   * time limit is used up. At least one task is run in each frame, so the
+   * queue always makes progress, but once a time limit is used up, nothing
+   * more is run.
+   *
+   * @param frame The current frame. A negative frame is a frame of its own.
+   * @param frameTimeLimitMilliseconds The maximum time to spend in all calls
+   * in the same frame, in milliseconds. If this is zero or negative, there is
+   * no limit.
+   * @param callTimeLimitMilliseconds The maximum time to spend in this call,
+   * in milliseconds. If this is zero or negative, there is no limit.
+   * @return The time spent running tasks in this call, in milliseconds.
+   */
+  static double dispatch(
+      int32_t frame,
+      double frameTimeLimitMilliseconds,
+      double callTimeLimitMilliseconds);
+
+  /**
+   * @brief Hands the queued tasks of an owner to the async systems they were
+   * run with, whose next dispatch of main thread tasks runs them regardless
+   * of the time limit. Tasks that the owner runs from now on go there
+   * directly, until {@link endDraining} is called.
+   */
+  static void beginDraining(const void* pOwner);
+
+  /**
+   * @brief Goes back to queuing the tasks of an owner.
+   */
+  static void endDraining(const void* pOwner);
+
+  /**
+   * @brief Gets the statistics of the queue so far.
+   */
+  static Statistics getStatistics();
+
+  /**
+   * @brief Formats a histogram as its buckets' upper limits and counts.
+   */
+  static std::string formatHistogram(const Histogram& histogram);
+
+private:
+  template <typename T> struct FutureTraits {
+    using Value = T;
+    static constexpr bool isFuture = false;
+  };
+
+  template <typename T> struct FutureTraits<CesiumAsync::Future<T>> {
+    using Value = T;
+    static constexpr bool isFuture = true;
+  };
+
+  static void enqueue(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const void* pOwner,
+      TaskPriority priority,
+      std::function<void()>&& task);
+};
+
+template <typename Func>
+auto MainThreadDispatcher::run(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const void* pOwner,
+    TaskPriority priority,
+    Func&& f) {
+  using Result = std::invoke_result_t<std::decay_t<Func>&>;
+  using Traits = FutureTraits<Result>;
+  using T = typename Traits::Value;
+
+  CesiumAsync::Promise<T> promise = asyncSystem.createPromise<T>();
+  CesiumAsync::Future<T> future = promise.getFuture();
+
+  // std::function must be copyable, but the function may not be.
+  auto pFunction = std::make_shared<std::decay_t<Func>>(std::forward<Func>(f));
+
+  enqueue(asyncSystem, pOwner, priority, [promise, pFunction]() {
+    try {
+      if constexpr (Traits::isFuture) {
+        if constexpr (std::is_void_v<T>) {
+          (*pFunction)()
+              .thenImmediately([promise]() { promise.resolve(); })
+              .catchImmediately(
+                  [promise](std::exception&& e) { promise.reject(e); });
+        } else {
+          (*pFunction)()
+              .thenImmediately(
+                  [promise](T&& value) { promise.resolve(std::move(value)); })
+              .catchImmediately(
+                  [promise](std::exception&& e) { promise.reject(e); });
+        }
+      } else if constexpr (std::is_void_v<T>) {
+        (*pFunction)();
+        promise.resolve();
+      } else {
+        promise.resolve((*pFunction)());
+      }
+    } catch (...) {
+      promise.reject(std::current_exception());
+    }
+  });
+
+  return future;
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,277 @@
+#include "MemoryCacheAssetAccessor.h"
+
+#include "AssetRequestKey.h"
+
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Roughly what each entry costs in memory beyond its URL and response data.
+const uint64_t entryOverheadBytes = 256;
+
+/**
+ * @brief Determines how long a response may be served from memory, from its
+ * Cache-Control header. Returns nothing if it must not be cached.
+ */
+std::optional<std::chrono::seconds>
+getMaximumAge(const IAssetResponse& response) {
+  const HttpHeaders& headers = response.headers();
+  auto it = headers.find("Cache-Control");
+  if (it == headers.end()) {
+    return std::nullopt;
+  }
+
+  std::string cacheControl = it->second;
+  std::transform(
+      cacheControl.begin(),
+      cacheControl.end(),
+      cacheControl.begin(),
+      [](unsigned char c) { return char(std::tolower(c)); });
+
+  if (cacheControl.find("no-store") != std::string::npos ||
+      cacheControl.find("no-cache") != std::string::npos) {
+    return std::nullopt;
+  }
+
+  const std::string maxAge = "max-age=";
+  size_t maxAgeStart = cacheControl.find(maxAge);
+  if (maxAgeStart == std::string::npos) {
+    return std::nullopt;
+  }
+
+  size_t valueStart = maxAgeStart + maxAge.size();
+  size_t valueEnd = valueStart;
+  while (valueEnd < cacheControl.size() &&
+         std::isdigit(static_cast<unsigned char>(cacheControl[valueEnd]))) {
+    ++valueEnd;
+  }
+
+  if (valueEnd == valueStart || valueEnd - valueStart > 9) {
+    // Missing, or too long to be a sensible number of seconds.
+    return std::nullopt;
+  }
+
+  int64_t seconds =
+      std::stoll(cacheControl.substr(valueStart, valueEnd - valueStart));
+  if (seconds <= 0) {
+    return std::nullopt;
+  }
+
+  return std::chrono::seconds(seconds);
+}
+
+/**
+ * @brief A copy of a response, with its data in a buffer of exactly the right
+ * size.
+ */
+class MemoryCachedAssetResponse : public IAssetResponse {
+public:
+  MemoryCachedAssetResponse(const IAssetResponse& response)
+      : _statusCode(response.statusCode()),
+        _contentType(response.contentType()),
+        _headers(response.headers()),
+        _data(response.data().begin(), response.data().end()) {}
+
+  virtual uint16_t statusCode() const override { return this->_statusCode; }
+
+  virtual std::string contentType() const override {
+    return this->_contentType;
+  }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return this->_data;
+  }
+
+private:
+  uint16_t _statusCode;
+  std::string _contentType;
+  HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+/**
+ * @brief A copy of a request and its response, as kept in memory.
+ *
+ * The response received from the network holds on to a buffer from the
+ * {@link DownloadBufferPool}, which can be much larger than its data. Keeping
+ * a right-sized copy instead means the cache's byte budget counts the memory
+ * that is really used, and the pooled buffer goes back to the pool as soon as
+ * the tile that requested it is done with it.
+ */
+class MemoryCachedAssetRequest : public IAssetRequest {
+public:
+  MemoryCachedAssetRequest(
+      const IAssetRequest& request,
+      const IAssetResponse& response)
+      : _method(request.method()),
+        _url(request.url()),
+        _headers(request.headers()),
+        _response(response) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  MemoryCachedAssetResponse _response;
+};
+
+} // namespace
+
+MemoryCacheAssetAccessor::MemoryCacheAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAccessor,
+    uint64_t maximumBytes)
+    : _pAccessor(pAccessor),
+      _maximumBytesPerShard(maximumBytes / shardCount),
+      _shards(),
+      _requests(0),
+      _hits(0),
+      _bytes(0) {}
+
+Future<std::shared_ptr<IAssetRequest>> MemoryCacheAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  ++this->_requests;
+
+  if (this->_maximumBytesPerShard == 0) {
+    return this->_pAccessor->get(asyncSystem, url, headers);
+  }
+
+  std::string key = calculateAssetRequestKey(
+      url,
+      HttpHeaders(headers.begin(), headers.end()));
+
+  {
+    Shard& shard = this->getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+      auto entryIt = it->second;
+      if (entryIt->expiryTime > Clock::now()) {
+        shard.entries.splice(shard.entries.begin(), shard.entries, entryIt);
+        ++this->_hits;
+        return asyncSystem.createResolvedFuture(
+            std::shared_ptr<IAssetRequest>(entryIt->pRequest));
+      }
+
+      // It's stale, so the response has to be revalidated by the disk cache.
+      shard.bytes -= entryIt->size;
+      this->_bytes -= entryIt->size;
+      shard.index.erase(it);
+      shard.entries.erase(entryIt);
+    }
+  }
+
+  return this->_pAccessor->get(asyncSystem, url, headers)
+      .thenImmediately([pThis = this->shared_from_this(), key = std::move(key)](
+                           std::shared_ptr<IAssetRequest>&& pRequest) {
+        pThis->insert(key, pRequest);
+        return std::move(pRequest);
+      });
+}
+
+Future<std::shared_ptr<IAssetRequest>> MemoryCacheAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void MemoryCacheAssetAccessor::tick() noexcept { this->_pAccessor->tick(); }
+
+MemoryCacheAssetAccessor::Statistics
+MemoryCacheAssetAccessor::getStatistics() const noexcept {
+  return Statistics{
+      this->_requests.load(),
+      this->_hits.load(),
+      this->_bytes.load()};
+}
+
+MemoryCacheAssetAccessor::Shard&
+MemoryCacheAssetAccessor::getShard(const std::string& key) {
+  return this->_shards[std::hash<std::string>()(key) % shardCount];
+}
+
+void MemoryCacheAssetAccessor::insert(
+    const std::string& key,
+    const std::shared_ptr<IAssetRequest>& pRequest) {
+  const IAssetResponse* pResponse = pRequest ? pRequest->response() : nullptr;
+  if (!pResponse || pResponse->statusCode() < 200 ||
+      pResponse->statusCode() >= 300) {
+    return;
+  }
+
+  std::optional<std::chrono::seconds> maximumAge = getMaximumAge(*pResponse);
+  if (!maximumAge) {
+    return;
+  }
+
+  uint64_t size = uint64_t(pResponse->data().size()) +
+                  uint64_t(key.size()) + entryOverheadBytes;
+  if (size > this->_maximumBytesPerShard / 2) {
+    // Don't let one large response push out everything else.
+    return;
+  }
+
+  std::shared_ptr<IAssetRequest> pCopy =
+      std::make_shared<MemoryCachedAssetRequest>(*pRequest, *pResponse);
+
+  Shard& shard = this->getShard(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.index.find(key);
+  if (it != shard.index.end()) {
+    shard.bytes -= it->second->size;
+    this->_bytes -= it->second->size;
+    shard.entries.erase(it->second);
+    shard.index.erase(it);
+  }
+
+  shard.entries.emplace_front(
+      Entry{key, std::move(pCopy), Clock::now() + *maximumAge, size});
+  shard.index.emplace(key, shard.entries.begin());
+  shard.bytes += size;
+  this->_bytes += size;
+
+  while (shard.bytes > this->_maximumBytesPerShard) {
+    Entry& leastRecentlyUsed = shard.entries.back();
+    shard.bytes -= leastRecentlyUsed.size;
+    this->_bytes -= leastRecentlyUsed.size;
+    shard.index.erase(leastRecentlyUsed.key);
+    shard.entries.pop_back();
+  }
+}
+
+} // namespace CesiumForUnityNative
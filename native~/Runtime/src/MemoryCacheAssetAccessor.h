@@ -0,0 +1,121 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief An asset accessor that keeps recently received responses in memory,
+ * so that requesting them again doesn't need to go to the disk cache.
+ *
+ * This is most useful for tiles that are unloaded to stay within the
+ * tileset's `maximumCachedBytes` and then loaded again, which happens all the
+ * time when the camera orbits. Only successful GET responses that may be
+ * cached according to their `Cache-Control` header are kept, and only until
+ * their `max-age` elapses. The least recently used responses are evicted to
+ * stay within a byte budget.
+ *
+ * The cache is split into shards, each with its own lock, so that concurrent
+ * requests rarely wait on one another.
+ *
+ * Requests in progress keep the accessor alive until they complete, so it
+ * must be created with `std::make_shared`.
+ */
+class MemoryCacheAssetAccessor
+    : public CesiumAsync::IAssetAccessor,
+      public std::enable_shared_from_this<MemoryCacheAssetAccessor> {
+public:
+  struct Statistics {
+    /**
+     * @brief The number of GET requests made.
+     */
+    uint64_t requests;
+
+    /**
+     * @brief The number of GET requests that were served from memory.
+     */
+    uint64_t hits;
+
+    /**
+     * @brief The number of bytes of responses currently held in memory.
+     */
+    uint64_t bytes;
+  };
+
+  /**
+   * @brief Creates a new accessor.
+   *
+   * @param pAccessor The accessor to make requests with when the response
+   * isn't in memory.
+   * @param maximumBytes The number of bytes of responses to keep in memory.
+   */
+  MemoryCacheAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAccessor,
+      uint64_t maximumBytes);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers = {}) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers = std::vector<THeader>(),
+      const gsl::span<const std::byte>& contentPayload = {}) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Gets the totals of the requests made so far, and the size of the
+   * cache.
+   */
+  Statistics getStatistics() const noexcept;
+
+private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+    std::chrono::steady_clock::time_point expiryTime;
+    uint64_t size;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    // Ordered from most to least recently used.
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    uint64_t bytes = 0;
+  };
+
+  static const size_t shardCount = 16;
+
+  Shard& getShard(const std::string& key);
+  void insert(
+      const std::string& key,
+      const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAccessor;
+  uint64_t _maximumBytesPerShard;
+  std::array<Shard, shardCount> _shards;
+
+  std::atomic<uint64_t> _requests;
+  std::atomic<uint64_t> _hits;
+  std::atomic<uint64_t> _bytes;
+};
+
+} // namespace CesiumForUnityNative
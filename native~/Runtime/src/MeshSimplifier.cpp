@@ -0,0 +1,390 @@
+#include "MeshSimplifier.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+/**
+ * @brief The symmetric 4x4 matrix used to compute the sum of squared distances
+ * from a point to a set of planes.
+ */
+struct Quadric {
+  double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+  double b2 = 0.0, bc = 0.0, bd = 0.0;
+  double c2 = 0.0, cd = 0.0;
+  double d2 = 0.0;
+
+  void addPlane(const glm::dvec3& normal, double d) {
+    this->a2 += normal.x * normal.x;
+    this->ab += normal.x * normal.y;
+    this->ac += normal.x * normal.z;
+    this->ad += normal.x * d;
+    this->b2 += normal.y * normal.y;
+    this->bc += normal.y * normal.z;
+    this->bd += normal.y * d;
+    this->c2 += normal.z * normal.z;
+    this->cd += normal.z * d;
+    this->d2 += d * d;
+  }
+
+  Quadric& operator+=(const Quadric& other) {
+    this->a2 += other.a2;
+    this->ab += other.ab;
+    this->ac += other.ac;
+    this->ad += other.ad;
+    this->b2 += other.b2;
+    this->bc += other.bc;
+    this->bd += other.bd;
+    this->c2 += other.c2;
+    this->cd += other.cd;
+    this->d2 += other.d2;
+    return *this;
+  }
+
+  double evaluate(const glm::dvec3& p) const {
+    return this->a2 * p.x * p.x + 2.0 * this->ab * p.x * p.y +
+           2.0 * this->ac * p.x * p.z + 2.0 * this->ad * p.x +
+           this->b2 * p.y * p.y + 2.0 * this->bc * p.y * p.z +
+           2.0 * this->bd * p.y + this->c2 * p.z * p.z +
+           2.0 * this->cd * p.z + this->d2;
+  }
+};
+
+/**
+ * @brief Moves the vertex `from` onto the vertex `to`.
+ */
+struct Collapse {
+  uint32_t from;
+  uint32_t to;
+  double cost;
+};
+
+struct PositionHash {
+  size_t operator()(const glm::vec3& position) const noexcept {
+    std::hash<float> hash;
+    size_t result = hash(position.x);
+    result ^= hash(position.y) + 0x9e3779b9 + (result << 6) + (result >> 2);
+    result ^= hash(position.z) + 0x9e3779b9 + (result << 6) + (result >> 2);
+    return result;
+  }
+};
+
+uint64_t edgeKey(uint32_t a, uint32_t b) {
+  if (a > b) {
+    std::swap(a, b);
+  }
+  return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+glm::dvec3 triangleNormal(
+    const glm::dvec3& p0,
+    const glm::dvec3& p1,
+    const glm::dvec3& p2) {
+  return glm::cross(p1 - p0, p2 - p0);
+}
+
+/**
+ * @brief Builds a list of the triangles that use each vertex. The triangles
+ * using vertex `v` are `vertexTriangles[offsets[v]]` up to
+ * `vertexTriangles[offsets[v + 1]]`.
+ */
+void buildAdjacency(
+    const std::vector<uint32_t>& triangles,
+    size_t vertexCount,
+    std::vector<uint32_t>& offsets,
+    std::vector<uint32_t>& vertexTriangles) {
+  offsets.assign(vertexCount + 1, 0);
+  for (uint32_t vertex : triangles) {
+    ++offsets[vertex + 1];
+  }
+
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  std::vector<uint32_t> writePositions(offsets.begin(), offsets.end() - 1);
+  vertexTriangles.resize(triangles.size());
+  for (size_t i = 0; i < triangles.size(); ++i) {
+    uint32_t vertex = triangles[i];
+    vertexTriangles[writePositions[vertex]++] = static_cast<uint32_t>(i / 3);
+  }
+}
+
+/**
+ * @brief Determines if a collapse would flip, or nearly flip, any of the
+ * triangles that remain after it.
+ */
+bool flipsTriangle(
+    const Collapse& collapse,
+    const std::vector<glm::dvec3>& vertices,
+    const std::vector<uint32_t>& triangles,
+    const std::vector<uint32_t>& offsets,
+    const std::vector<uint32_t>& vertexTriangles) {
+  for (uint32_t i = offsets[collapse.from]; i < offsets[collapse.from + 1];
+       ++i) {
+    const uint32_t* pTriangle = &triangles[3 * vertexTriangles[i]];
+    if (pTriangle[0] == collapse.to || pTriangle[1] == collapse.to ||
+        pTriangle[2] == collapse.to) {
+      // This triangle is removed by the collapse.
+      continue;
+    }
+
+    glm::dvec3 before[3];
+    glm::dvec3 after[3];
+    for (int k = 0; k < 3; ++k) {
+      before[k] = vertices[pTriangle[k]];
+      after[k] = pTriangle[k] == collapse.from ? vertices[collapse.to]
+                                               : vertices[pTriangle[k]];
+    }
+
+    // Also reject collapses that turn a triangle by more than about 75
+    // degrees, because repeated smaller turns would eventually flip it.
+    glm::dvec3 normalBefore = triangleNormal(before[0], before[1], before[2]);
+    glm::dvec3 normalAfter = triangleNormal(after[0], after[1], after[2]);
+    if (glm::dot(normalBefore, normalAfter) <=
+        0.25 * glm::length(normalBefore) * glm::length(normalAfter)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+} // namespace
+
+SimplifiedMesh MeshSimplifier::simplify(
+    const std::vector<glm::vec3>& positions,
+    const std::vector<uint32_t>& indices,
+    const MeshSimplificationOptions& options) {
+  CESIUM_TRACE("Cesium::MeshSimplifier::simplify");
+
+  // Weld vertices with identical positions, because vertices that were only
+  // split for normals or texture coordinates don't matter here.
+  std::vector<glm::dvec3> vertices;
+  std::vector<uint32_t> remap(positions.size());
+  {
+    std::unordered_map<glm::vec3, uint32_t, PositionHash> uniqueVertices;
+    uniqueVertices.reserve(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+      auto [it, inserted] = uniqueVertices.emplace(
+          positions[i],
+          static_cast<uint32_t>(vertices.size()));
+      if (inserted) {
+        vertices.emplace_back(positions[i]);
+      }
+      remap[i] = it->second;
+    }
+  }
+
+  std::vector<uint32_t> triangles;
+  triangles.reserve(indices.size());
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    if (indices[i] >= positions.size() || indices[i + 1] >= positions.size() ||
+        indices[i + 2] >= positions.size()) {
+      continue;
+    }
+
+    uint32_t v0 = remap[indices[i]];
+    uint32_t v1 = remap[indices[i + 1]];
+    uint32_t v2 = remap[indices[i + 2]];
+    if (v0 == v1 || v1 == v2 || v2 == v0) {
+      continue;
+    }
+
+    triangles.push_back(v0);
+    triangles.push_back(v1);
+    triangles.push_back(v2);
+  }
+
+  if (triangles.empty()) {
+    return SimplifiedMesh();
+  }
+
+  const size_t targetTriangleCount = static_cast<size_t>(std::ceil(
+      static_cast<double>(triangles.size() / 3) *
+      std::clamp(options.targetTriangleRatio, 0.0, 1.0)));
+  const double maximumCost = options.maximumError * options.maximumError;
+
+  // Lock the vertices of edges that aren't shared by exactly two triangles.
+  // These are on the boundary of the tile, and moving them would open gaps
+  // between neighboring tiles.
+  std::vector<bool> locked(vertices.size(), false);
+  {
+    std::unordered_map<uint64_t, uint32_t> edgeUseCounts;
+    edgeUseCounts.reserve(triangles.size());
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+      for (size_t k = 0; k < 3; ++k) {
+        ++edgeUseCounts[edgeKey(triangles[i + k], triangles[i + (k + 1) % 3])];
+      }
+    }
+
+    for (const auto& [key, count] : edgeUseCounts) {
+      if (count != 2) {
+        locked[static_cast<uint32_t>(key >> 32)] = true;
+        locked[static_cast<uint32_t>(key)] = true;
+      }
+    }
+  }
+
+  // Each vertex starts with the planes of the triangles that use it.
+  std::vector<Quadric> quadrics(vertices.size());
+  for (size_t i = 0; i < triangles.size(); i += 3) {
+    const glm::dvec3& p0 = vertices[triangles[i]];
+    glm::dvec3 normal = triangleNormal(
+        p0,
+        vertices[triangles[i + 1]],
+        vertices[triangles[i + 2]]);
+    double length = glm::length(normal);
+    if (length <= 0.0) {
+      continue;
+    }
+
+    normal /= length;
+    Quadric plane;
+    plane.addPlane(normal, -glm::dot(normal, p0));
+    for (size_t k = 0; k < 3; ++k) {
+      quadrics[triangles[i + k]] += plane;
+    }
+  }
+
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> vertexTriangles;
+  std::vector<Collapse> collapses;
+  std::vector<bool> touched;
+  std::vector<uint32_t> collapseTargets(vertices.size());
+
+  // Collapse the cheapest edges in passes. Within a pass, each collapse locks
+  // the neighborhood of the removed vertex, so the adjacency and the flip
+  // checks only need to be computed once per pass.
+  size_t triangleCount = triangles.size() / 3;
+  while (triangleCount > targetTriangleCount) {
+    buildAdjacency(triangles, vertices.size(), offsets, vertexTriangles);
+
+    collapses.clear();
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+      for (size_t k = 0; k < 3; ++k) {
+        uint32_t a = triangles[i + k];
+        uint32_t b = triangles[i + (k + 1) % 3];
+
+        // Interior edges appear in two triangles with opposite winding, so
+        // this considers each of them once.
+        if (a > b || (locked[a] && locked[b])) {
+          continue;
+        }
+
+        Quadric quadric = quadrics[a];
+        quadric += quadrics[b];
+
+        Collapse best{0, 0, std::numeric_limits<double>::max()};
+        if (!locked[a]) {
+          best = Collapse{a, b, quadric.evaluate(vertices[b])};
+        }
+        if (!locked[b]) {
+          double cost = quadric.evaluate(vertices[a]);
+          if (cost < best.cost) {
+            best = Collapse{b, a, cost};
+          }
+        }
+
+        if (best.cost <= maximumCost) {
+          collapses.push_back(best);
+        }
+      }
+    }
+
+    if (collapses.empty()) {
+      break;
+    }
+
+    std::sort(
+        collapses.begin(),
+        collapses.end(),
+        [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+    touched.assign(vertices.size(), false);
+    std::iota(collapseTargets.begin(), collapseTargets.end(), 0);
+
+    size_t collapsed = 0;
+    for (const Collapse& collapse : collapses) {
+      if (triangleCount <= targetTriangleCount) {
+        break;
+      }
+
+      if (touched[collapse.from] || touched[collapse.to] ||
+          flipsTriangle(
+              collapse,
+              vertices,
+              triangles,
+              offsets,
+              vertexTriangles)) {
+        continue;
+      }
+
+      for (uint32_t i = offsets[collapse.from]; i < offsets[collapse.from + 1];
+           ++i) {
+        const uint32_t* pTriangle = &triangles[3 * vertexTriangles[i]];
+        if (pTriangle[0] == collapse.to || pTriangle[1] == collapse.to ||
+            pTriangle[2] == collapse.to) {
+          --triangleCount;
+        }
+        for (size_t k = 0; k < 3; ++k) {
+          touched[pTriangle[k]] = true;
+        }
+      }
+
+      collapseTargets[collapse.from] = collapse.to;
+      quadrics[collapse.to] += quadrics[collapse.from];
+      ++collapsed;
+    }
+
+    if (collapsed == 0) {
+      break;
+    }
+
+    // Apply the collapses and remove the triangles that became degenerate.
+    size_t writeIndex = 0;
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+      uint32_t v0 = collapseTargets[triangles[i]];
+      uint32_t v1 = collapseTargets[triangles[i + 1]];
+      uint32_t v2 = collapseTargets[triangles[i + 2]];
+      if (v0 == v1 || v1 == v2 || v2 == v0) {
+        continue;
+      }
+
+      triangles[writeIndex++] = v0;
+      triangles[writeIndex++] = v1;
+      triangles[writeIndex++] = v2;
+    }
+    triangles.resize(writeIndex);
+    triangleCount = triangles.size() / 3;
+  }
+
+  // Keep only the vertices that are still used.
+  SimplifiedMesh result;
+  result.indices.reserve(triangles.size());
+  std::vector<uint32_t> outputIndices(
+      vertices.size(),
+      std::numeric_limits<uint32_t>::max());
+  for (uint32_t vertex : triangles) {
+    uint32_t& outputIndex = outputIndices[vertex];
+    if (outputIndex == std::numeric_limits<uint32_t>::max()) {
+      outputIndex = static_cast<uint32_t>(result.positions.size());
+      result.positions.emplace_back(vertices[vertex]);
+    }
+    result.indices.push_back(outputIndex);
+  }
+
+  return result;
+}
+
+} // namespace CesiumForUnityNative
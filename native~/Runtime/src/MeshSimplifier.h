@@ -0,0 +1,65 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Options that control how far `MeshSimplifier::simplify` simplifies a
+ * mesh.
+ */
+struct MeshSimplificationOptions {
+  /**
+   * @brief The fraction of the original triangles to keep. Simplification
+   * stops once the mesh has at most this many triangles.
+   */
+  double targetTriangleRatio = 0.25;
+
+  /**
+   * @brief The maximum distance, in the units of the vertex positions, that
+   * the simplified surface may deviate from the original one. No edge is
+   * collapsed if doing so would exceed this error, even if the target triangle
+   * count has not been reached.
+   */
+  double maximumError = 0.5;
+};
+
+/**
+ * @brief A triangle mesh with positions only, such as one used for physics.
+ */
+struct SimplifiedMesh {
+  std::vector<glm::vec3> positions;
+  std::vector<uint32_t> indices;
+};
+
+/**
+ * @brief Reduces the number of triangles in a mesh using quadric error metric
+ * edge collapses.
+ *
+ * Only positions are considered, so vertices that were split for normals or
+ * texture coordinates are welded first. Vertices on the boundary of the mesh
+ * are never moved, so that the simplified meshes of adjacent tiles still meet
+ * without gaps. Collapses that would flip a triangle are rejected.
+ */
+class MeshSimplifier {
+public:
+  /**
+   * @brief Simplifies a triangle list.
+   *
+   * @param positions The vertex positions.
+   * @param indices The vertex indices, three per triangle. Triangles that
+   * reference vertices outside of `positions` are ignored.
+   * @param options The options that control how far to simplify.
+   * @return The simplified mesh. Its `indices` are empty if the mesh did not
+   * have any valid triangles.
+   */
+  static SimplifiedMesh simplify(
+      const std::vector<glm::vec3>& positions,
+      const std::vector<uint32_t>& indices,
+      const MeshSimplificationOptions& options);
+};
+
+} // namespace CesiumForUnityNative
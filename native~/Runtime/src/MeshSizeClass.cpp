@@ -0,0 +1,133 @@
+#include "MeshSizeClass.h"
+
+#include "RendererResourceMemory.h"
+
+#include <cassert>
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// Counts up to this are their own capacity.
+const int32_t maximumExactCount = 64;
+
+// Larger capacities are one of 2^stepBits steps between each power of two.
+const int32_t stepBits = 3;
+
+// Counts above this aren't rounded up, so that their capacity still fits.
+const int32_t maximumRoundedCount = 1 << 30;
+
+// What an empty mesh is counted as while it's pooled.
+const int64_t emptyMeshBytes = 1024;
+
+// The sizes of the vertex attributes of a tile mesh, in bytes.
+const size_t positionBytes = 3 * sizeof(float);
+const size_t normalBytes = 3 * sizeof(float);
+const size_t colorBytes = sizeof(uint32_t);
+const size_t texCoordBytes = 2 * sizeof(float);
+
+int32_t floorLog2(int32_t value) {
+  int32_t result = 0;
+  while (value >>= 1) {
+    ++result;
+  }
+  return result;
+}
+
+/**
+ * @brief Numbers the capacities in order, so that they fit into 9 bits.
+ */
+int32_t getCapacityIndex(int32_t capacity) {
+  if (capacity <= maximumExactCount) {
+    return capacity;
+  }
+
+  const int32_t exponent = floorLog2(capacity);
+  const int32_t step = capacity >> (exponent - stepBits);
+  return maximumExactCount + 1 +
+         (exponent - floorLog2(maximumExactCount)) * (1 << stepBits) +
+         (step - (1 << stepBits));
+}
+
+/**
+ * @brief The inverse of {@link getCapacityIndex}.
+ */
+int64_t getCapacityFromIndex(int32_t index) {
+  if (index <= maximumExactCount) {
+    return index;
+  }
+
+  const int32_t offset = index - maximumExactCount - 1;
+  const int32_t exponent =
+      floorLog2(maximumExactCount) + offset / (1 << stepBits);
+  const int64_t step = (1 << stepBits) + offset % (1 << stepBits);
+  return step << (exponent - stepBits);
+}
+
+} // namespace
+
+int32_t MeshSizeClass::getCapacity(int32_t count) noexcept {
+  if (count <= maximumExactCount || count > maximumRoundedCount) {
+    return count;
+  }
+
+  const int32_t stepSize = 1 << (floorLog2(count) - stepBits);
+  return (count + stepSize - 1) / stepSize * stepSize;
+}
+
+int32_t MeshSizeClass::getSizeClass(
+    int32_t vertexCapacity,
+    int32_t indexCapacity,
+    uint32_t vertexLayout,
+    bool uint32Indices) noexcept {
+  assert(vertexLayout < 256);
+  if (vertexCapacity < 0 || vertexCapacity > maximumRoundedCount ||
+      indexCapacity < 0 || indexCapacity > maximumRoundedCount) {
+    return Unsized;
+  }
+
+  // The lowest bit is set so that no size class is Unsized.
+  return 1 | (uint32Indices ? 1 << 1 : 0) | int32_t(vertexLayout << 2) |
+         (getCapacityIndex(vertexCapacity) << 10) |
+         (getCapacityIndex(indexCapacity) << 19);
+}
+
+uint32_t MeshSizeClass::getVertexLayout(
+    bool hasNormals,
+    bool hasVertexColors,
+    int32_t texCoordCount) noexcept {
+  assert(texCoordCount >= 0 && texCoordCount <= 8);
+  return (hasNormals ? 1 : 0) | (hasVertexColors ? 1 << 1 : 0) |
+         uint32_t(texCoordCount << 2);
+}
+
+int64_t MeshSizeClass::getPooledBytes(int32_t sizeClass) noexcept {
+  if (sizeClass == Unsized) {
+    return emptyMeshBytes;
+  }
+
+  const bool uint32Indices = (sizeClass & (1 << 1)) != 0;
+  const uint32_t vertexLayout = uint32_t(sizeClass >> 2) & 0xff;
+  const int64_t vertexCapacity =
+      getCapacityFromIndex((sizeClass >> 10) & 0x1ff);
+  const int64_t indexCapacity =
+      getCapacityFromIndex((sizeClass >> 19) & 0x1ff);
+
+  size_t vertexStride = positionBytes;
+  if ((vertexLayout & 1) != 0) {
+    vertexStride += normalBytes;
+  }
+  if ((vertexLayout & (1 << 1)) != 0) {
+    vertexStride += colorBytes;
+  }
+  vertexStride += size_t(vertexLayout >> 2) * texCoordBytes;
+
+  return emptyMeshBytes +
+         RendererResourceMemory::computeMeshBytes(
+             vertexCapacity,
+             vertexStride,
+             indexCapacity,
+             uint32Indices ? sizeof(uint32_t) : sizeof(uint16_t));
+}
+
+} // namespace CesiumForUnityNative
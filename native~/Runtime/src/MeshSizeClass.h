@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Sorts tile meshes into the size classes of the mesh pool.
+ *
+ * A mesh's vertex and index buffers are reallocated whenever it's filled with
+ * more or fewer vertices or indices than it had, so a pooled mesh only saves
+ * that work when it's reused for a mesh of exactly the same size. Tiles are
+ * rarely exactly the same size, but are often close, so meshes are padded up
+ * to a capacity: counts up to 64 are kept as they are, and larger counts are
+ * rounded up to one of eight steps between each power of two, which wastes
+ * at most an eighth. The size class combines the vertex and index capacities
+ * with the vertex layout, because a mesh's buffers only fit another mesh
+ * with the same layout.
+ */
+class MeshSizeClass {
+public:
+  /**
+   * @brief The size class of meshes that aren't padded to a capacity, such
+   * as point clouds. These are still pooled, but their buffers are freed.
+   */
+  static constexpr int32_t Unsized = 0;
+
+  /**
+   * @brief Rounds a vertex or index count up to its capacity.
+   */
+  static int32_t getCapacity(int32_t count) noexcept;
+
+  /**
+   * @brief Gets the size class of a mesh.
+   *
+   * @param vertexCapacity The vertex capacity, from {@link getCapacity}.
+   * @param indexCapacity The index capacity, from {@link getCapacity}.
+   * @param vertexLayout A value that identifies the vertex attributes, which
+   * must be less than 256.
+   * @param uint32Indices Whether the indices are 32-bit rather than 16-bit.
+   */
+  static int32_t getSizeClass(
+      int32_t vertexCapacity,
+      int32_t indexCapacity,
+      uint32_t vertexLayout,
+      bool uint32Indices) noexcept;
+
+  /**
+   * @brief Computes the vertex layout identifier of a tile mesh.
+   *
+   * @param hasNormals Whether the vertices have normals.
+   * @param hasVertexColors Whether the vertices have colors.
+   * @param texCoordCount The number of texture coordinate sets, up to 8.
+   */
+  static uint32_t getVertexLayout(
+      bool hasNormals,
+      bool hasVertexColors,
+      int32_t texCoordCount) noexcept;
+
+  /**
+   * @brief Gets the memory that a mesh of a size class keeps while it's
+   * pooled, in bytes, which is what its padded buffers take. An
+   * {@link Unsized} mesh is cleared when it's pooled, but is still counted
+   * as a small amount, so that empty meshes can't pile up without limit.
+   */
+  static int64_t getPooledBytes(int32_t sizeClass) noexcept;
+};
+
+} // namespace CesiumForUnityNative
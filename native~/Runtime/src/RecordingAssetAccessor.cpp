@@ -0,0 +1,61 @@
+#include "RecordingAssetAccessor.h"
+
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumUtility/Tracing.h>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+RecordingAssetAccessor::RecordingAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAccessor,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& path)
+    : _pAccessor(pAccessor),
+      _pWriter(std::make_shared<RequestArchiveWriter>(pLogger, path)) {}
+
+Future<std::shared_ptr<IAssetRequest>> RecordingAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->record(
+      "GET",
+      url,
+      this->_pAccessor->get(asyncSystem, url, headers));
+}
+
+Future<std::shared_ptr<IAssetRequest>> RecordingAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->record(
+      verb,
+      url,
+      this->_pAccessor
+          ->request(asyncSystem, verb, url, headers, contentPayload));
+}
+
+void RecordingAssetAccessor::tick() noexcept { this->_pAccessor->tick(); }
+
+Future<std::shared_ptr<IAssetRequest>> RecordingAssetAccessor::record(
+    const std::string& method,
+    const std::string& url,
+    Future<std::shared_ptr<IAssetRequest>>&& future) {
+  return std::move(future).thenImmediately(
+      [pWriter = this->_pWriter, method, url](
+          std::shared_ptr<IAssetRequest>&& pRequest) {
+        const IAssetResponse* pResponse = pRequest->response();
+        if (pResponse) {
+          CESIUM_TRACE("RecordingAssetAccessor::record");
+          // Record it under the URL it was requested with, which may differ
+          // from pRequest->url() after a redirect.
+          pWriter->write(method, url, *pResponse);
+        }
+        return std::move(pRequest);
+      });
+}
+
+} // namespace CesiumForUnityNative
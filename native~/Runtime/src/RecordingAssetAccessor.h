@@ -0,0 +1,64 @@
+#pragma once
+
+#include "RequestArchive.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+
+#include <spdlog/fwd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief An asset accessor that records every response it receives to a
+ * request archive, so that a session can be played back later by a
+ * {@link ReplayAssetAccessor} without the network.
+ *
+ * Requests that fail without a response aren't recorded.
+ */
+class RecordingAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * @brief Creates a new accessor.
+   *
+   * @param pAccessor The accessor to make requests with.
+   * @param pLogger The logger that receives error messages.
+   * @param path The path of the archive to record to. Any existing file is
+   * replaced.
+   */
+  RecordingAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAccessor,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& path);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers = {}) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers = std::vector<THeader>(),
+      const gsl::span<const std::byte>& contentPayload = {}) override;
+
+  virtual void tick() noexcept override;
+
+private:
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> record(
+      const std::string& method,
+      const std::string& url,
+      CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>&&
+          future);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAccessor;
+  std::shared_ptr<RequestArchiveWriter> _pWriter;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,81 @@
+#include "RendererResourceMemory.h"
+
+#include <CesiumGltf/ImageCesium.h>
+
+#include <algorithm>
+#include <cassert>
+
+using namespace CesiumGltf;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// Uncompressed images are loaded into RGBA32 textures.
+const int64_t uncompressedBytesPerPixel = 4;
+
+// PhysX keeps a baked mesh's positions and triangles, with 32-bit indices,
+// along with a bounding volume hierarchy and a map back to the original
+// triangles, which together take about twice as much as the triangles do.
+const int64_t bakedBytesPerVertex = 12;
+const int64_t bakedBytesPerIndex = 12;
+
+// A material instance holds its own copy of the values of its shader's
+// properties, which for the tileset materials come to a few kilobytes.
+const int64_t materialBytes = 4096;
+
+} // namespace
+
+RendererResourceMemory::RendererResourceMemory()
+    : _bytes(0), _releasedGltfBytes(0) {}
+
+void RendererResourceMemory::add(int64_t bytes) noexcept {
+  this->_bytes += bytes;
+}
+
+void RendererResourceMemory::remove(int64_t bytes) noexcept {
+  assert(bytes <= this->_bytes);
+  this->_bytes -= bytes;
+}
+
+int64_t RendererResourceMemory::computeMeshBytes(
+    int64_t vertexCount,
+    size_t vertexStride,
+    int64_t indexCount,
+    size_t indexSize) noexcept {
+  const int64_t bufferBytes = vertexCount * int64_t(vertexStride) +
+                              indexCount * int64_t(indexSize);
+  return 2 * bufferBytes;
+}
+
+int64_t RendererResourceMemory::computeBakedMeshBytes(
+    int64_t vertexCount,
+    int64_t indexCount) noexcept {
+  return vertexCount * bakedBytesPerVertex + indexCount * bakedBytesPerIndex;
+}
+
+int64_t RendererResourceMemory::computeTextureBytes(
+    const ImageCesium& image) noexcept {
+  if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
+    // The texture holds exactly the image's blocks, mipmaps included.
+    return int64_t(image.pixelData.size());
+  }
+
+  const size_t mipCount =
+      image.mipPositions.empty() ? 1 : image.mipPositions.size();
+  int64_t bytes = 0;
+  int64_t width = image.width;
+  int64_t height = image.height;
+  for (size_t i = 0; i < mipCount; ++i) {
+    bytes += width * height * uncompressedBytesPerPixel;
+    width = std::max(int64_t(1), width / 2);
+    height = std::max(int64_t(1), height / 2);
+  }
+  return bytes;
+}
+
+int64_t RendererResourceMemory::computeMaterialBytes() noexcept {
+  return materialBytes;
+}
+
+} // namespace CesiumForUnityNative
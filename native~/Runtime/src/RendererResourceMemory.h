@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumGltf {
+struct ImageCesium;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Counts the memory used by the Unity objects that are created for a
+ * tileset's tiles and raster overlay tiles.
+ *
+ * The tileset itself only counts the glTFs and images that its tiles are
+ * loaded from. The meshes, textures, materials, and baked physics meshes that
+ * are created from them are counted here when they're created and freed, so
+ * that they can be counted against the tileset's cache size, too. Physics
+ * meshes that are baked later, near physics interest points, aren't counted.
+ */
+class RendererResourceMemory {
+public:
+  RendererResourceMemory();
+
+  /**
+   * @brief Counts the memory of objects that were just created.
+   */
+  void add(int64_t bytes) noexcept;
+
+  /**
+   * @brief Stops counting the memory of objects that were freed.
+   */
+  void remove(int64_t bytes) noexcept;
+
+  /**
+   * @brief Gets the memory used by the objects that are counted, in bytes.
+   */
+  int64_t getBytes() const noexcept { return this->_bytes; }
+
+  /**
+   * @brief Counts the glTF data that was released from a loaded tile.
+   *
+   * A tileset measures a tile's glTF again when it unloads the tile, so data
+   * that was released from the tile is never taken back out of the tileset's
+   * count. This is how much the tileset overcounts by.
+   */
+  void addReleasedGltfBytes(int64_t bytes) noexcept {
+    this->_releasedGltfBytes += bytes;
+  }
+
+  /**
+   * @brief Gets the glTF data released from the tileset's tiles so far, in
+   * bytes.
+   */
+  int64_t getReleasedGltfBytes() const noexcept {
+    return this->_releasedGltfBytes;
+  }
+
+  /**
+   * @brief Forgets the glTF data released from the tiles of a tileset that has
+   * been destroyed.
+   */
+  void clearReleasedGltfBytes() noexcept { this->_releasedGltfBytes = 0; }
+
+  /**
+   * @brief Computes the memory used by a mesh. Meshes stay readable, so their
+   * vertices and indices are both in main memory and on the GPU.
+   *
+   * @param vertexCount The number of vertices.
+   * @param vertexStride The size of a vertex, in bytes.
+   * @param indexCount The number of indices.
+   * @param indexSize The size of an index, in bytes.
+   */
+  static int64_t computeMeshBytes(
+      int64_t vertexCount,
+      size_t vertexStride,
+      int64_t indexCount,
+      size_t indexSize) noexcept;
+
+  /**
+   * @brief Estimates the memory used by the physics mesh that is baked from a
+   * mesh's positions and triangles.
+   *
+   * @param vertexCount The number of vertices.
+   * @param indexCount The number of indices.
+   */
+  static int64_t
+  computeBakedMeshBytes(int64_t vertexCount, int64_t indexCount) noexcept;
+
+  /**
+   * @brief Computes the memory used by the texture that
+   * {@link TextureLoader::loadTexture} creates from an image, including its
+   * mipmaps.
+   */
+  static int64_t
+  computeTextureBytes(const CesiumGltf::ImageCesium& image) noexcept;
+
+  /**
+   * @brief Estimates the memory used by a material instance.
+   */
+  static int64_t computeMaterialBytes() noexcept;
+
+private:
+  int64_t _bytes;
+  int64_t _releasedGltfBytes;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,237 @@
+#include "ReplayAssetAccessor.h"
+
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+class ReplayedAssetResponse : public IAssetResponse {
+public:
+  ReplayedAssetResponse(
+      const std::shared_ptr<const ArchivedResponse>& pResponse)
+      : _pResponse(pResponse) {}
+
+  virtual uint16_t statusCode() const override {
+    return this->_pResponse->statusCode;
+  }
+
+  virtual std::string contentType() const override {
+    auto it = this->_pResponse->headers.find("Content-Type");
+    return it != this->_pResponse->headers.end() ? it->second : std::string();
+  }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_pResponse->headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return this->_pResponse->data;
+  }
+
+private:
+  std::shared_ptr<const ArchivedResponse> _pResponse;
+};
+
+class ReplayedAssetRequest : public IAssetRequest {
+public:
+  ReplayedAssetRequest(
+      const std::string& method,
+      const std::string& url,
+      const std::vector<IAssetAccessor::THeader>& headers,
+      const std::shared_ptr<const ArchivedResponse>& pResponse)
+      : _method(method),
+        _url(url),
+        _headers(headers.begin(), headers.end()),
+        _response(pResponse) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  ReplayedAssetResponse _response;
+};
+
+} // namespace
+
+ReplayAssetAccessor::ReplayAssetAccessor(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& path,
+    std::chrono::milliseconds latency,
+    uint64_t bytesPerSecond)
+    : _pLogger(pLogger),
+      _archive(readRequestArchive(pLogger, path)),
+      _latency(latency),
+      _bytesPerSecond(bytesPerSecond),
+      _mutex(),
+      _responsesScheduled(),
+      _scheduledResponses(),
+      _nextSequence(0),
+      _linkAvailableTime(Clock::now()),
+      _stopping(false),
+      _deliveryThread(),
+      _replayedRequests(0),
+      _missingRequests(0) {
+  if (this->_latency > Clock::duration::zero() || this->_bytesPerSecond > 0) {
+    this->_deliveryThread = std::thread([this]() { this->deliverResponses(); });
+  }
+}
+
+ReplayAssetAccessor::~ReplayAssetAccessor() noexcept { this->shutdown(); }
+
+void ReplayAssetAccessor::shutdown() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_stopping) {
+      return;
+    }
+    this->_stopping = true;
+  }
+
+  if (this->_deliveryThread.joinable()) {
+    this->_responsesScheduled.notify_all();
+    this->_deliveryThread.join();
+  }
+}
+
+Future<std::shared_ptr<IAssetRequest>> ReplayAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->replay(asyncSystem, "GET", url, headers);
+}
+
+Future<std::shared_ptr<IAssetRequest>> ReplayAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& /*contentPayload*/) {
+  return this->replay(asyncSystem, verb, url, headers);
+}
+
+void ReplayAssetAccessor::tick() noexcept {}
+
+ReplayAssetAccessor::Statistics
+ReplayAssetAccessor::getStatistics() const noexcept {
+  return Statistics{
+      this->_replayedRequests.load(),
+      this->_missingRequests.load()};
+}
+
+Future<std::shared_ptr<IAssetRequest>> ReplayAssetAccessor::replay(
+    const AsyncSystem& asyncSystem,
+    const std::string& method,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  std::shared_ptr<const ArchivedResponse> pResponse;
+  auto it = this->_archive.find(getRequestArchiveKey(method, url));
+  if (it != this->_archive.end()) {
+    pResponse = it->second;
+    ++this->_replayedRequests;
+  } else {
+    SPDLOG_LOGGER_WARN(
+        this->_pLogger,
+        "No response to {} {} was recorded in the request archive",
+        method,
+        url);
+    pResponse = std::make_shared<const ArchivedResponse>(
+        ArchivedResponse{method, url, 404, HttpHeaders(), {}});
+    ++this->_missingRequests;
+  }
+
+  std::shared_ptr<IAssetRequest> pRequest =
+      std::make_shared<ReplayedAssetRequest>(method, url, headers, pResponse);
+
+  if (this->_latency <= Clock::duration::zero() && this->_bytesPerSecond == 0) {
+    return asyncSystem.createResolvedFuture(std::move(pRequest));
+  }
+
+  Clock::duration transferTime = Clock::duration::zero();
+  if (this->_bytesPerSecond > 0) {
+    transferTime = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(
+            double(pResponse->data.size()) / double(this->_bytesPerSecond)));
+  }
+
+  return asyncSystem.createFuture<std::shared_ptr<IAssetRequest>>(
+      [this, &pRequest, transferTime](const auto& promise) {
+        bool scheduled = false;
+        {
+          std::lock_guard<std::mutex> lock(this->_mutex);
+          if (!this->_stopping) {
+            // The data starts to arrive after the latency, once the link has
+            // finished sending the responses ahead of it.
+            Clock::time_point startTime = std::max(
+                Clock::now() + this->_latency,
+                this->_linkAvailableTime);
+            Clock::time_point dueTime = startTime + transferTime;
+            this->_linkAvailableTime = dueTime;
+
+            this->_scheduledResponses.push(ScheduledResponse{
+                dueTime,
+                this->_nextSequence++,
+                promise,
+                std::move(pRequest)});
+            scheduled = true;
+          }
+        }
+
+        if (scheduled) {
+          this->_responsesScheduled.notify_one();
+        } else {
+          // The delivery thread has been shut down, so don't delay it.
+          promise.resolve(std::move(pRequest));
+        }
+      });
+}
+
+void ReplayAssetAccessor::deliverResponses() {
+  std::unique_lock<std::mutex> lock(this->_mutex);
+
+  while (true) {
+    if (this->_scheduledResponses.empty()) {
+      if (this->_stopping) {
+        return;
+      }
+      this->_responsesScheduled.wait(lock);
+      continue;
+    }
+
+    Clock::time_point dueTime = this->_scheduledResponses.top().dueTime;
+    if (!this->_stopping && dueTime > Clock::now()) {
+      this->_responsesScheduled.wait_until(lock, dueTime);
+      continue;
+    }
+
+    // When stopping, deliver everything that's left straight away, so that
+    // nothing waits on a response forever.
+    ScheduledResponse response = this->_scheduledResponses.top();
+    this->_scheduledResponses.pop();
+
+    lock.unlock();
+    response.promise.resolve(std::move(response.pRequest));
+    lock.lock();
+  }
+}
+
+} // namespace CesiumForUnityNative
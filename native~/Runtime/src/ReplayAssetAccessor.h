@@ -0,0 +1,143 @@
+#pragma once
+
+#include "RequestArchive.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/Promise.h>
+
+#include <spdlog/fwd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief An asset accessor that answers requests from a request archive
+ * recorded by a {@link RecordingAssetAccessor}, instead of the network, so
+ * that tile streaming can be benchmarked and tested reproducibly offline.
+ *
+ * To make the timing resemble a real network, each response can be delayed by
+ * a fixed latency, and then by the time its data takes to arrive over a link
+ * of limited bandwidth that all responses share. Requests that weren't
+ * recorded get an empty 404 response.
+ */
+class ReplayAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  struct Statistics {
+    /**
+     * @brief The number of requests answered from the archive.
+     */
+    uint64_t replayedRequests;
+
+    /**
+     * @brief The number of requests that weren't in the archive.
+     */
+    uint64_t missingRequests;
+  };
+
+  /**
+   * @brief Creates a new accessor.
+   *
+   * @param pLogger The logger that receives error messages.
+   * @param path The path of the archive to replay.
+   * @param latency How long to wait before each response starts to arrive.
+   * @param bytesPerSecond The bandwidth of the simulated link, or 0 for no
+   * limit.
+   */
+  ReplayAssetAccessor(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& path,
+      std::chrono::milliseconds latency,
+      uint64_t bytesPerSecond);
+  virtual ~ReplayAssetAccessor() noexcept;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers = {}) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers = std::vector<THeader>(),
+      const gsl::span<const std::byte>& contentPayload = {}) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Delivers the responses that are still delayed straight away, and
+   * stops the thread that delivers them.
+   *
+   * Responses to later requests are delivered without a delay. This is called
+   * by the destructor, and may be called earlier so that the thread is gone
+   * before the native code is unloaded or the .NET domain is reloaded.
+   */
+  void shutdown() noexcept;
+
+  /**
+   * @brief Gets the totals of the requests made so far.
+   */
+  Statistics getStatistics() const noexcept;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct ScheduledResponse {
+    Clock::time_point dueTime;
+    uint64_t sequence;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise;
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+  };
+
+  struct LaterDueTime {
+    bool operator()(
+        const ScheduledResponse& a,
+        const ScheduledResponse& b) const noexcept {
+      return a.dueTime != b.dueTime ? a.dueTime > b.dueTime
+                                    : a.sequence > b.sequence;
+    }
+  };
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> replay(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& method,
+      const std::string& url,
+      const std::vector<THeader>& headers);
+  void deliverResponses();
+
+  std::shared_ptr<spdlog::logger> _pLogger;
+  RequestArchive _archive;
+  Clock::duration _latency;
+  uint64_t _bytesPerSecond;
+
+  std::mutex _mutex;
+  std::condition_variable _responsesScheduled;
+  std::priority_queue<
+      ScheduledResponse,
+      std::vector<ScheduledResponse>,
+      LaterDueTime>
+      _scheduledResponses;
+  uint64_t _nextSequence;
+  // When the simulated link will have finished sending the responses that
+  // have been scheduled so far.
+  Clock::time_point _linkAvailableTime;
+  bool _stopping;
+  std::thread _deliveryThread;
+
+  std::atomic<uint64_t> _replayedRequests;
+  std::atomic<uint64_t> _missingRequests;
+};
+
+} // namespace CesiumForUnityNative
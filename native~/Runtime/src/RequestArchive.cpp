@@ -0,0 +1,137 @@
+#include "RequestArchive.h"
+
+#include "EntrySerialization.h"
+
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <iterator>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+const uint32_t archiveMagic = 0x43465241; // CFRA
+const uint32_t archiveVersion = 1;
+
+} // namespace
+
+std::string
+getRequestArchiveKey(const std::string& method, const std::string& url) {
+  return method + " " + url;
+}
+
+RequestArchive readRequestArchive(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& path) {
+  RequestArchive result;
+
+  std::ifstream file(std::filesystem::u8path(path), std::ios::binary);
+  if (!file) {
+    SPDLOG_LOGGER_ERROR(pLogger, "Could not open request archive {}", path);
+    return result;
+  }
+
+  std::vector<char> contents(
+      (std::istreambuf_iterator<char>(file)),
+      std::istreambuf_iterator<char>());
+  EntryReader reader(gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(contents.data()),
+      contents.size()));
+
+  uint32_t magic;
+  uint32_t version;
+  if (!reader.readUint32(magic) || !reader.readUint32(version) ||
+      magic != archiveMagic || version != archiveVersion) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "{} is not a request archive, or was written by a different version",
+        path);
+    return result;
+  }
+
+  while (true) {
+    auto pResponse = std::make_shared<ArchivedResponse>();
+    if (!reader.readString(pResponse->method) ||
+        !reader.readString(pResponse->url) ||
+        !reader.readUint16(pResponse->statusCode) ||
+        !reader.readHeaders(pResponse->headers) ||
+        !reader.readBytes(pResponse->data)) {
+      // The end of the archive, or of what was written before it was cut
+      // short.
+      break;
+    }
+
+    std::string key =
+        getRequestArchiveKey(pResponse->method, pResponse->url);
+    result[key] = std::move(pResponse);
+  }
+
+  SPDLOG_LOGGER_INFO(
+      pLogger,
+      "Read {} responses from request archive {}",
+      result.size(),
+      path);
+
+  return result;
+}
+
+RequestArchiveWriter::RequestArchiveWriter(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& path)
+    : _pLogger(pLogger),
+      _path(path),
+      _mutex(),
+      _file(
+          std::filesystem::u8path(path),
+          std::ios::binary | std::ios::trunc) {
+  if (!this->_file) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pLogger,
+        "Could not create request archive {}",
+        this->_path);
+    return;
+  }
+
+  EntryWriter writer;
+  writer.writeUint32(archiveMagic);
+  writer.writeUint32(archiveVersion);
+  const std::vector<std::byte>& data = writer.getData();
+  this->_file.write(
+      reinterpret_cast<const char*>(data.data()),
+      std::streamsize(data.size()));
+}
+
+void RequestArchiveWriter::write(
+    const std::string& method,
+    const std::string& url,
+    const IAssetResponse& response) {
+  EntryWriter writer;
+  writer.writeString(method);
+  writer.writeString(url);
+  writer.writeUint16(response.statusCode());
+  writer.writeHeaders(response.headers());
+  writer.writeBytes(response.data());
+  const std::vector<std::byte>& data = writer.getData();
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (!this->_file) {
+    return;
+  }
+
+  this->_file.write(
+      reinterpret_cast<const char*>(data.data()),
+      std::streamsize(data.size()));
+  if (!this->_file) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pLogger,
+        "Could not write to request archive {}, so recording has stopped",
+        this->_path);
+  }
+}
+
+} // namespace CesiumForUnityNative
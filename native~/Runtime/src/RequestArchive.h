@@ -0,0 +1,91 @@
+#pragma once
+
+#include <CesiumAsync/HttpHeaders.h>
+
+#include <spdlog/fwd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumAsync {
+class IAssetResponse;
+}
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A response read from a request archive.
+ */
+struct ArchivedResponse {
+  std::string method;
+  std::string url;
+  uint16_t statusCode;
+  CesiumAsync::HttpHeaders headers;
+  std::vector<std::byte> data;
+};
+
+/**
+ * @brief The responses in a request archive, keyed by
+ * {@link getRequestArchiveKey}.
+ */
+using RequestArchive =
+    std::unordered_map<std::string, std::shared_ptr<const ArchivedResponse>>;
+
+/**
+ * @brief Gets the key that a response is found by in a request archive.
+ * Request headers aren't part of it, so that responses are still found when,
+ * for example, a cache adds revalidation headers to the request.
+ */
+std::string
+getRequestArchiveKey(const std::string& method, const std::string& url);
+
+/**
+ * @brief Reads a request archive written by {@link RequestArchiveWriter}.
+ * When a request was recorded more than once, its last response is used. An
+ * archive that was cut short, such as when the application was killed while
+ * recording, is read up to its last complete response.
+ *
+ * @param pLogger The logger that receives error messages.
+ * @param path The path of the archive.
+ */
+RequestArchive readRequestArchive(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& path);
+
+/**
+ * @brief Appends responses to a request archive file. This is thread-safe.
+ */
+class RequestArchiveWriter {
+public:
+  /**
+   * @brief Creates a new archive, replacing any existing file.
+   *
+   * @param pLogger The logger that receives error messages.
+   * @param path The path of the archive.
+   */
+  RequestArchiveWriter(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& path);
+
+  /**
+   * @brief Appends a response to the archive.
+   */
+  void write(
+      const std::string& method,
+      const std::string& url,
+      const CesiumAsync::IAssetResponse& response);
+
+private:
+  std::shared_ptr<spdlog::logger> _pLogger;
+  std::string _path;
+  std::mutex _mutex;
+  std::ofstream _file;
+};
+
+} // namespace CesiumForUnityNative
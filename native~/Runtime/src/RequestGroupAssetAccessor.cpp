@@ -0,0 +1,53 @@
+#include "RequestGroupAssetAccessor.h"
+
+#include "AssetRequestCancellation.h"
+
+#include <string>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+RequestGroupAssetAccessor::RequestGroupAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAccessor,
+    uint64_t group)
+    : _pAccessor(pAccessor), _group(group) {}
+
+Future<std::shared_ptr<IAssetRequest>> RequestGroupAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->_pAccessor->get(
+      asyncSystem,
+      url,
+      this->addGroupHeader(headers));
+}
+
+Future<std::shared_ptr<IAssetRequest>> RequestGroupAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAccessor->request(
+      asyncSystem,
+      verb,
+      url,
+      this->addGroupHeader(headers),
+      contentPayload);
+}
+
+void RequestGroupAssetAccessor::tick() noexcept { this->_pAccessor->tick(); }
+
+std::vector<IAssetAccessor::THeader> RequestGroupAssetAccessor::addGroupHeader(
+    const std::vector<THeader>& headers) const {
+  std::vector<THeader> result;
+  result.reserve(headers.size() + 1);
+  result.insert(result.end(), headers.begin(), headers.end());
+  result.emplace_back(
+      AssetRequestCancellation::groupHeader,
+      std::to_string(this->_group));
+  return result;
+}
+
+} // namespace CesiumForUnityNative
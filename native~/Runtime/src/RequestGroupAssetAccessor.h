@@ -0,0 +1,50 @@
+#pragma once
+
+#include <CesiumAsync/IAssetAccessor.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief An asset accessor that puts every request it makes in a single
+ * {@link AssetRequestCancellation} group, so that they can all be cancelled
+ * together when the tileset that made them goes away.
+ */
+class RequestGroupAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * @brief Creates a new accessor.
+   *
+   * @param pAccessor The accessor to make the requests with.
+   * @param group The group to put the requests in.
+   */
+  RequestGroupAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAccessor,
+      uint64_t group);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers = {}) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers = std::vector<THeader>(),
+      const gsl::span<const std::byte>& contentPayload = {}) override;
+
+  virtual void tick() noexcept override;
+
+private:
+  std::vector<THeader>
+  addGroupHeader(const std::vector<THeader>& headers) const;
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAccessor;
+  uint64_t _group;
+};
+
+} // namespace CesiumForUnityNative
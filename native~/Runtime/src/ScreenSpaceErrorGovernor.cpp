@@ -0,0 +1,121 @@
+#include "ScreenSpaceErrorGovernor.h"
+
+#include <algorithm>
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// How much of each new frame time goes into the smoothed frame time.
+const double smoothingFactor = 0.1;
+
+// Frames are late when they take this much longer than the target, and have
+// time to spare when they take this much of it. Frame times in between don't
+// change the error.
+const double lateThreshold = 1.1;
+const double headroomThreshold = 0.85;
+
+// The tiles' memory use has room to spare below this fraction of the limit.
+const double memoryHeadroomThreshold = 0.9;
+
+// How many frames to wait after changing the error before judging its
+// effect, which gives tiles time to load or unload.
+const int32_t settleFrames = 30;
+
+// How many frames to stay on target before trying a lower error anyway.
+const int32_t probeFrames = 300;
+
+// How many frames to avoid the error that made frames late.
+const int32_t forgetLateFrames = 1800;
+
+// Raising the error is quicker than lowering it, so that late frames are
+// dealt with before detail is restored.
+const double raiseFactor = 1.25;
+const double lowerFactor = 1.1;
+
+} // namespace
+
+ScreenSpaceErrorGovernor::ScreenSpaceErrorGovernor()
+    : _screenSpaceError(0.0),
+      _smoothedFrameMilliseconds(0.0),
+      _framesSinceChange(0),
+      _lateScreenSpaceError(0.0),
+      _framesSinceLate(0) {}
+
+double ScreenSpaceErrorGovernor::update(
+    double minimumScreenSpaceError,
+    double maximumScreenSpaceError,
+    double frameMilliseconds,
+    double targetFrameMilliseconds,
+    int64_t tileBytes,
+    int64_t maximumTileBytes) {
+  maximumScreenSpaceError =
+      std::max(minimumScreenSpaceError, maximumScreenSpaceError);
+
+  if (this->_screenSpaceError <= 0.0) {
+    this->_screenSpaceError = minimumScreenSpaceError;
+    this->_smoothedFrameMilliseconds = frameMilliseconds;
+  }
+  this->_screenSpaceError = std::clamp(
+      this->_screenSpaceError,
+      minimumScreenSpaceError,
+      maximumScreenSpaceError);
+
+  this->_smoothedFrameMilliseconds +=
+      smoothingFactor * (frameMilliseconds - this->_smoothedFrameMilliseconds);
+
+  if (this->_lateScreenSpaceError > 0.0 &&
+      ++this->_framesSinceLate >= forgetLateFrames) {
+    this->_lateScreenSpaceError = 0.0;
+  }
+
+  if (++this->_framesSinceChange < settleFrames) {
+    return this->_screenSpaceError;
+  }
+
+  const bool useMemory = maximumTileBytes > 0;
+  const bool late =
+      this->_smoothedFrameMilliseconds >
+      lateThreshold * targetFrameMilliseconds;
+  const bool overMemory = useMemory && tileBytes > maximumTileBytes;
+
+  if (late || overMemory) {
+    if (this->_screenSpaceError < maximumScreenSpaceError) {
+      if (late) {
+        this->_lateScreenSpaceError = this->_screenSpaceError;
+        this->_framesSinceLate = 0;
+      }
+      this->_screenSpaceError = std::min(
+          maximumScreenSpaceError,
+          raiseFactor * this->_screenSpaceError);
+      this->_framesSinceChange = 0;
+    }
+    return this->_screenSpaceError;
+  }
+
+  const bool frameHeadroom = this->_smoothedFrameMilliseconds <
+                             headroomThreshold * targetFrameMilliseconds;
+  const bool memoryHeadroom =
+      !useMemory ||
+      double(tileBytes) < memoryHeadroomThreshold * double(maximumTileBytes);
+  if (!memoryHeadroom ||
+      (!frameHeadroom && this->_framesSinceChange < probeFrames)) {
+    return this->_screenSpaceError;
+  }
+
+  const double lower = std::max(
+      minimumScreenSpaceError,
+      this->_screenSpaceError / lowerFactor);
+  if (lower < this->_screenSpaceError &&
+      (this->_lateScreenSpaceError <= 0.0 ||
+       lower > this->_lateScreenSpaceError)) {
+    this->_screenSpaceError = lower;
+    this->_framesSinceChange = 0;
+  }
+
+  return this->_screenSpaceError;
+}
+
+void ScreenSpaceErrorGovernor::reset() { *this = ScreenSpaceErrorGovernor(); }
+
+} // namespace CesiumForUnityNative
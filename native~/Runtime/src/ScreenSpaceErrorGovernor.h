@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Adjusts a tileset's maximum screen-space error to keep the frame rate
+ * on target and the tileset's tiles within its memory limit.
+ *
+ * This is used when the tileset's `adaptScreenSpaceError` property is true.
+ * The frame time is smoothed, and the error is only changed once the previous
+ * change has had time to take effect. The error is raised when frames are
+ * late or tiles use too much memory, and lowered when frames finish with time
+ * to spare. Frames that are paced by vsync never finish early, so after a
+ * while on target, a lower error is tried anyway. It won't be tried again for
+ * a while if it made frames late.
+ */
+class ScreenSpaceErrorGovernor {
+public:
+  ScreenSpaceErrorGovernor();
+
+  /**
+   * @brief Updates the error from the previous frame.
+   *
+   * @param minimumScreenSpaceError The lowest error to use, which is the
+   * tileset's `maximumScreenSpaceError`.
+   * @param maximumScreenSpaceError The highest error to use.
+   * @param frameMilliseconds The time that the previous frame took, in
+   * milliseconds.
+   * @param targetFrameMilliseconds The time that a frame should take, in
+   * milliseconds.
+   * @param tileBytes The memory used by the tileset's tiles, in bytes.
+   * @param maximumTileBytes The memory that the tileset's tiles should use, in
+   * bytes. If this is zero or negative, memory use is ignored.
+   * @return The error to use for the next frame.
+   */
+  double update(
+      double minimumScreenSpaceError,
+      double maximumScreenSpaceError,
+      double frameMilliseconds,
+      double targetFrameMilliseconds,
+      int64_t tileBytes,
+      int64_t maximumTileBytes);
+
+  /**
+   * @brief Forgets everything, so that the next update starts from the
+   * lowest error.
+   */
+  void reset();
+
+  /**
+   * @brief Gets the error from the last update, or zero if there has not been
+   * one since the last reset.
+   */
+  double getScreenSpaceError() const noexcept {
+    return this->_screenSpaceError;
+  }
+
+private:
+  double _screenSpaceError;
+  double _smoothedFrameMilliseconds;
+  int32_t _framesSinceChange;
+
+  // The error that frames were last late with, which isn't tried again until
+  // it's forgotten. Zero if there's none.
+  double _lateScreenSpaceError;
+  int32_t _framesSinceLate;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,154 @@
+#include "StatisticsReport.h"
+
+#include "AssetRequestCancellation.h"
+#include "MainThreadBudget.h"
+#include "MainThreadDispatcher.h"
+#include "TileMemoryBudget.h"
+#include "UnityTilesetExternals.h"
+
+#include <DotNet/CesiumForUnity/CesiumObjectPools.h>
+#include <DotNet/CesiumForUnity/CesiumSizeClassPool1.h>
+#include <DotNet/UnityEngine/Mesh.h>
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <optional>
+
+using namespace DotNet;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The shortest time between two reports.
+const std::chrono::seconds reportInterval(5);
+
+std::optional<std::chrono::steady_clock::time_point> lastReportTime;
+
+double getPercentage(uint64_t part, uint64_t whole) {
+  return whole > 0 ? 100.0 * double(part) / double(whole) : 0.0;
+}
+
+double getMegabytesPerSecond(uint64_t bytes, double seconds) {
+  return seconds > 0.0 ? double(bytes) / (1024.0 * 1024.0 * seconds) : 0.0;
+}
+
+void logRequestStatistics(const std::shared_ptr<spdlog::logger>& pLogger) {
+  AssetRequestCancellation::Statistics cancellationStats =
+      AssetRequestCancellation::getStatistics();
+  CoalescingAssetAccessor::Statistics coalescingStats =
+      getRequestCoalescingStatistics();
+  MemoryCacheAssetAccessor::Statistics memoryCacheStats =
+      getMemoryCacheStatistics();
+  CompressingCacheDatabase::Statistics compressionStats =
+      getCacheCompressionStatistics();
+  double compressionRatio =
+      compressionStats.storedBytes > 0
+          ? double(compressionStats.uncompressedBytes) /
+                double(compressionStats.storedBytes)
+          : 1.0;
+  InflatingAssetAccessor::Statistics gzipStats = getGzipInflateStatistics();
+
+  SPDLOG_LOGGER_INFO(
+      pLogger,
+      "All Tilesets Requests: Requests {0}, Coalesced Requests {1}, Cancelled "
+      "Requests {2}, Cancelled Bytes {3}, Memory Cache Hits {4} of {5} "
+      "({6:.1f}%), Memory Cache Bytes {7}, Cache Compression Ratio {8:.2f}, "
+      "Cache Inflate Rate {9:.1f} MB/s, Gzipped Responses {10}, Gzip Inflate "
+      "Rate {11:.1f} MB/s",
+      coalescingStats.requests,
+      coalescingStats.coalescedRequests,
+      cancellationStats.cancelledRequests,
+      cancellationStats.wastedBytes,
+      memoryCacheStats.hits,
+      memoryCacheStats.requests,
+      getPercentage(memoryCacheStats.hits, memoryCacheStats.requests),
+      memoryCacheStats.bytes,
+      compressionRatio,
+      getMegabytesPerSecond(
+          compressionStats.inflatedBytes,
+          compressionStats.inflateSeconds),
+      gzipStats.responses,
+      getMegabytesPerSecond(gzipStats.inflatedBytes, gzipStats.inflateSeconds));
+}
+
+void logTaskStatistics(const std::shared_ptr<spdlog::logger>& pLogger) {
+  uint64_t workerTasks = 0;
+  uint64_t stolenWorkerTasks = 0;
+  for (const WorkStealingTaskProcessor::QueueStatistics& queueStats :
+       getTaskProcessorStatistics()) {
+    workerTasks += queueStats.executed;
+    stolenWorkerTasks += queueStats.stolen;
+  }
+  WorkStealingTaskProcessor::PriorityStatistics visibleTaskStats =
+      getTaskPriorityStatistics()[size_t(TaskPriority::Visible)];
+  double visibleTaskWaitMilliseconds =
+      visibleTaskStats.executed > 0
+          ? 1000.0 * visibleTaskStats.waitSeconds /
+                double(visibleTaskStats.executed)
+          : 0.0;
+  MainThreadDispatcher::Statistics dispatcherStats =
+      MainThreadDispatcher::getStatistics();
+
+  SPDLOG_LOGGER_INFO(
+      pLogger,
+      "All Tilesets Tasks: Worker Tasks {0}, Stolen Worker Tasks {1}, "
+      "Visible Task Wait {2:.2f} ms, Main Thread Tasks Queued {3} (Max {4}), "
+      "Main Thread Tasks {5}, Main Thread Task ms [{6}], Main Thread Frame ms "
+      "[{7}]",
+      workerTasks,
+      stolenWorkerTasks,
+      visibleTaskWaitMilliseconds,
+      dispatcherStats.queuedTasks,
+      dispatcherStats.maximumQueuedTasks,
+      dispatcherStats.dispatchedTasks,
+      MainThreadDispatcher::formatHistogram(dispatcherStats.taskTimes),
+      MainThreadDispatcher::formatHistogram(dispatcherStats.frameTimes));
+}
+
+void logBudgetStatistics(const std::shared_ptr<spdlog::logger>& pLogger) {
+  MainThreadBudget::Statistics budgetStats = MainThreadBudget::getStatistics();
+  TileMemoryBudget::Statistics memoryStats = TileMemoryBudget::getStatistics();
+  CesiumForUnity::CesiumSizeClassPool1<UnityEngine::Mesh> meshPool =
+      CesiumForUnity::CesiumObjectPools::MeshPool();
+  const int64_t meshPoolGets = meshPool.CountGotten();
+  const int64_t meshPoolHits = meshPool.CountHits();
+
+  SPDLOG_LOGGER_INFO(
+      pLogger,
+      "All Tilesets Budgets: Main Thread Budget {0:.2f} ms, Target Frame "
+      "{1:.1f} ms, Last Frame {2:.1f} ms, Tileset Updates {3:.2f} ms, Tile "
+      "Bytes {4} (Budget {5}, {6} Tilesets), Mesh Pool Hits {7} of {8} "
+      "({9:.1f}%), Pooled Meshes {10} ({11} Bytes)",
+      budgetStats.budgetMilliseconds,
+      budgetStats.targetFrameMilliseconds,
+      budgetStats.frameMilliseconds,
+      budgetStats.updateMilliseconds,
+      memoryStats.totalBytes,
+      memoryStats.budgetBytes,
+      memoryStats.tilesets,
+      meshPoolHits,
+      meshPoolGets,
+      getPercentage(uint64_t(meshPoolHits), uint64_t(meshPoolGets)),
+      meshPool.CountInactive(),
+      meshPool.InactiveBytes());
+}
+
+} // namespace
+
+void StatisticsReport::logIfDue(
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  const std::chrono::steady_clock::time_point now =
+      std::chrono::steady_clock::now();
+  if (lastReportTime && now - *lastReportTime < reportInterval) {
+    return;
+  }
+  lastReportTime = now;
+
+  logRequestStatistics(pLogger);
+  logTaskStatistics(pLogger);
+  logBudgetStatistics(pLogger);
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <spdlog/fwd.h>
+
+#include <memory>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Logs the statistics that are shared by all tilesets, such as those
+ * of the request pipeline, the task processors, the main thread budget, and
+ * the memory budget.
+ *
+ * Each tileset that has `logSelectionStats` enabled calls {@link logIfDue}
+ * in every update, and logs its own statistics separately. The shared ones
+ * are logged at most once every few seconds, however many tilesets call it,
+ * so that they aren't repeated for each tileset in each frame. Only call this
+ * from the main thread.
+ */
+class StatisticsReport {
+public:
+  /**
+   * @brief Logs the shared statistics, if enough time has passed since they
+   * were last logged.
+   *
+   * @param pLogger The logger to log them to.
+   */
+  static void logIfDue(const std::shared_ptr<spdlog::logger>& pLogger);
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,313 @@
+#include "TileColliderManager.h"
+
+#include "CesiumGeoreferenceImpl.h"
+#include "MeshSizeClass.h"
+#include "TaskPriority.h"
+#include "UnityLifetime.h"
+#include "UnityPrepareRendererResources.h"
+#include "UnityTransforms.h"
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <DotNet/CesiumForUnity/Cesium3DTileset.h>
+#include <DotNet/CesiumForUnity/CesiumGeoreference.h>
+#include <DotNet/CesiumForUnity/CesiumObjectPools.h>
+#include <DotNet/CesiumForUnity/CesiumPhysicsInterestPoint.h>
+#include <DotNet/CesiumForUnity/CesiumSizeClassPool1.h>
+#include <DotNet/System/Collections/Generic/List1.h>
+#include <DotNet/UnityEngine/GameObject.h>
+#include <DotNet/UnityEngine/Matrix4x4.h>
+#include <DotNet/UnityEngine/MeshCollider.h>
+#include <DotNet/UnityEngine/Physics.h>
+#include <DotNet/UnityEngine/Transform.h>
+#include <DotNet/UnityEngine/Vector3.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace DotNet;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The maximum number of tiles whose physics meshes may be baked at once.
+const int32_t maximumSimultaneousBakes = 4;
+
+struct InterestPoint {
+  glm::dvec3 positionEcef;
+  double radiusSquared;
+};
+
+std::vector<InterestPoint>
+getInterestPoints(const CesiumForUnity::Cesium3DTileset& tileset) {
+  std::vector<InterestPoint> result;
+
+  using CesiumForUnity::CesiumPhysicsInterestPoint;
+
+  System::Collections::Generic::List1<CesiumPhysicsInterestPoint>
+      interestPoints = CesiumPhysicsInterestPoint::interestPoints();
+  int32_t count = interestPoints.Count();
+  if (count == 0) {
+    return result;
+  }
+
+  const LocalHorizontalCoordinateSystem* pCoordinateSystem = nullptr;
+  CesiumForUnity::CesiumGeoreference georeferenceComponent =
+      tileset.gameObject()
+          .GetComponentInParent<CesiumForUnity::CesiumGeoreference>();
+  if (georeferenceComponent != nullptr) {
+    pCoordinateSystem =
+        &georeferenceComponent.NativeImplementation().getCoordinateSystem(
+            georeferenceComponent);
+  }
+
+  glm::dmat4 unityWorldToTileset = UnityTransforms::fromUnity(
+      tileset.gameObject().transform().worldToLocalMatrix());
+
+  result.reserve(count);
+  for (int32_t i = 0; i < count; ++i) {
+    CesiumPhysicsInterestPoint interestPoint = interestPoints[i];
+    UnityEngine::Vector3 positionUnity = interestPoint.transform().position();
+    glm::dvec3 position = glm::dvec3(
+        unityWorldToTileset *
+        glm::dvec4(positionUnity.x, positionUnity.y, positionUnity.z, 1.0));
+    if (pCoordinateSystem) {
+      position = pCoordinateSystem->localPositionToEcef(position);
+    }
+
+    double radius = interestPoint.radius();
+    result.push_back(InterestPoint{position, radius * radius});
+  }
+
+  return result;
+}
+
+CesiumGltfGameObject* getGltfGameObject(const Tile& tile) {
+  if (tile.getState() != TileLoadState::Done) {
+    return nullptr;
+  }
+
+  const TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  if (!pRenderContent) {
+    return nullptr;
+  }
+
+  CesiumGltfGameObject* pCesiumGameObject =
+      static_cast<CesiumGltfGameObject*>(pRenderContent->getRenderResources());
+  if (!pCesiumGameObject || !pCesiumGameObject->pGameObject ||
+      !pCesiumGameObject->pPhysicsMeshState) {
+    return nullptr;
+  }
+
+  return pCesiumGameObject;
+}
+
+void attachColliders(CesiumGltfGameObject& gameObject) {
+  for (CesiumPrimitiveResources& resources : gameObject.primitiveResources) {
+    if (!resources.canCreateCollider || resources.collider != nullptr ||
+        resources.gameObject == nullptr || resources.mesh == nullptr) {
+      continue;
+    }
+
+    // The mesh was already baked in a worker thread, so this should not
+    // trigger baking in the main thread.
+    resources.collider =
+        resources.gameObject.AddComponent<UnityEngine::MeshCollider>();
+    resources.collider.sharedMesh(resources.getColliderMesh());
+  }
+
+  *gameObject.pPhysicsMeshState = CesiumPhysicsMeshState::Attached;
+}
+
+void detachColliders(CesiumGltfGameObject& gameObject) {
+  for (CesiumPrimitiveResources& resources : gameObject.primitiveResources) {
+    if (resources.collider != nullptr) {
+      UnityLifetime::Destroy(resources.collider);
+    }
+    resources.collider = nullptr;
+  }
+
+  // Unity keeps the baked physics data with the mesh, so the colliders can
+  // be attached again cheaply if the tile comes back into range.
+  *gameObject.pPhysicsMeshState = CesiumPhysicsMeshState::Baked;
+}
+
+} // namespace
+
+TileColliderManager::TileColliderManager()
+    : _pBakesInProgress(std::make_shared<int32_t>(0)), _attachedTiles() {}
+
+void TileColliderManager::update(
+    const CesiumForUnity::Cesium3DTileset& tileset,
+    Tileset& nativeTileset,
+    const ViewUpdateResult& updateResult) {
+  CESIUM_TRACE("Cesium::TileColliderManager::update");
+
+  std::vector<InterestPoint> interestPoints = getInterestPoints(tileset);
+
+  struct BakeCandidate {
+    CesiumGltfGameObject* pGameObject;
+    double distanceSquared;
+  };
+  std::vector<BakeCandidate> candidates;
+  std::unordered_set<const CesiumGltfGameObject*> tilesInRange;
+
+  for (Tile* pTile : updateResult.tilesToRenderThisFrame) {
+    CesiumGltfGameObject* pCesiumGameObject = getGltfGameObject(*pTile);
+    if (!pCesiumGameObject) {
+      continue;
+    }
+
+    double closestDistanceSquared = std::numeric_limits<double>::max();
+    bool inRange = false;
+    if (!interestPoints.empty()) {
+      OrientedBoundingBox box =
+          getOrientedBoundingBoxFromBoundingVolume(pTile->getBoundingVolume());
+      for (const InterestPoint& interestPoint : interestPoints) {
+        double distanceSquared =
+            box.computeDistanceSquaredToPosition(interestPoint.positionEcef);
+        if (distanceSquared <= interestPoint.radiusSquared) {
+          inRange = true;
+          closestDistanceSquared =
+              std::min(closestDistanceSquared, distanceSquared);
+        }
+      }
+    }
+
+    if (!inRange) {
+      continue;
+    }
+
+    tilesInRange.insert(pCesiumGameObject);
+
+    CesiumPhysicsMeshState& state = *pCesiumGameObject->pPhysicsMeshState;
+    if (state == CesiumPhysicsMeshState::None) {
+      candidates.push_back({pCesiumGameObject, closestDistanceSquared});
+    } else if (state == CesiumPhysicsMeshState::Baked) {
+      attachColliders(*pCesiumGameObject);
+      this->_attachedTiles.emplace_back(
+          pCesiumGameObject->pPhysicsMeshState,
+          pCesiumGameObject);
+    }
+  }
+
+  // Remove the colliders of tiles that have left the radius of every interest
+  // point or are no longer rendered. The colliders of freed tiles are
+  // destroyed along with them.
+  auto removeIt = std::remove_if(
+      this->_attachedTiles.begin(),
+      this->_attachedTiles.end(),
+      [&tilesInRange](const AttachedTile& attachedTile) {
+        std::shared_ptr<CesiumPhysicsMeshState> pState =
+            attachedTile.first.lock();
+        if (!pState || *pState != CesiumPhysicsMeshState::Attached) {
+          return true;
+        }
+        if (tilesInRange.find(attachedTile.second) != tilesInRange.end()) {
+          return false;
+        }
+        detachColliders(*attachedTile.second);
+        return true;
+      });
+  this->_attachedTiles.erase(removeIt, this->_attachedTiles.end());
+
+  if (candidates.empty() ||
+      *this->_pBakesInProgress >= maximumSimultaneousBakes) {
+    return;
+  }
+
+  // Bake the tiles closest to an interest point first.
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const BakeCandidate& a, const BakeCandidate& b) {
+        return a.distanceSquared < b.distanceSquared;
+      });
+
+  const CesiumAsync::AsyncSystem& asyncSystem =
+      nativeTileset.getExternals().asyncSystem;
+
+  for (const BakeCandidate& candidate : candidates) {
+    if (*this->_pBakesInProgress >= maximumSimultaneousBakes) {
+      break;
+    }
+
+    CesiumGltfGameObject& gameObject = *candidate.pGameObject;
+
+    std::vector<int32_t> instanceIDs;
+    std::vector<std::pair<UnityEngine::Mesh, int32_t>> bakingMeshes;
+    for (const CesiumPrimitiveResources& resources :
+         gameObject.primitiveResources) {
+      if (resources.canCreateCollider && resources.mesh != nullptr) {
+        instanceIDs.push_back(resources.getColliderMesh().GetInstanceID());
+        bakingMeshes.emplace_back(
+            resources.getColliderMesh(),
+            resources.getColliderMeshSizeClass());
+      }
+    }
+
+    if (instanceIDs.empty()) {
+      // Nothing to collide with, so don't consider this tile again.
+      *gameObject.pPhysicsMeshState = CesiumPhysicsMeshState::Attached;
+      continue;
+    }
+
+    *gameObject.pPhysicsMeshState = CesiumPhysicsMeshState::Baking;
+    ++*this->_pBakesInProgress;
+
+    TaskPriorityScope priorityScope(TaskPriority::PhysicsBake);
+    asyncSystem
+        .runInWorkerThread([instanceIDs = std::move(instanceIDs)]() {
+          for (int32_t instanceID : instanceIDs) {
+            UnityEngine::Physics::BakeMesh(instanceID, false);
+          }
+        })
+        .thenInMainThread(
+            [pBakesInProgress = this->_pBakesInProgress,
+             pWeakState = std::weak_ptr<CesiumPhysicsMeshState>(
+                 gameObject.pPhysicsMeshState),
+             bakingMeshes = std::move(bakingMeshes)]() {
+              --*pBakesInProgress;
+
+              std::shared_ptr<CesiumPhysicsMeshState> pState =
+                  pWeakState.lock();
+              if (pState) {
+                if (*pState == CesiumPhysicsMeshState::Baking) {
+                  *pState = CesiumPhysicsMeshState::Baked;
+                }
+                return;
+              }
+
+              // The tile was freed while its meshes were baking, and left
+              // returning them to the mesh pool to this bake.
+              for (const auto& [mesh, sizeClass] : bakingMeshes) {
+                if (mesh != nullptr) {
+                  CesiumForUnity::CesiumObjectPools::MeshPool().Release(
+                      mesh,
+                      sizeClass,
+                      MeshSizeClass::getPooledBytes(sizeClass));
+                }
+              }
+            });
+  }
+}
+
+void TileColliderManager::reset() {
+  this->_pBakesInProgress = std::make_shared<int32_t>(0);
+  this->_attachedTiles.clear();
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace DotNet::CesiumForUnity {
+class Cesium3DTileset;
+}
+
+namespace Cesium3DTilesSelection {
+class Tileset;
+class ViewUpdateResult;
+} // namespace Cesium3DTilesSelection
+
+namespace CesiumForUnityNative {
+
+enum class CesiumPhysicsMeshState;
+struct CesiumGltfGameObject;
+
+/**
+ * @brief Creates physics colliders only for the rendered tiles near a
+ * `CesiumPhysicsInterestPoint`, and removes them again when the tiles leave
+ * the interest point's radius.
+ *
+ * This is used instead of baking a physics mesh for every tile when the
+ * tileset's `limitPhysicsMeshesToInterestPoints` property is true. Physics
+ * meshes are baked in worker threads, closest tiles first, and a limited
+ * number at a time.
+ */
+class TileColliderManager {
+public:
+  TileColliderManager();
+
+  /**
+   * @brief Bakes and attaches the colliders of the tiles rendered this frame
+   * near an interest point, and removes the colliders of the tiles that are
+   * no longer near one or no longer rendered.
+   */
+  void update(
+      const DotNet::CesiumForUnity::Cesium3DTileset& tileset,
+      Cesium3DTilesSelection::Tileset& nativeTileset,
+      const Cesium3DTilesSelection::ViewUpdateResult& updateResult);
+
+  /**
+   * @brief Forgets about physics mesh bakes in progress for a tileset that is
+   * being destroyed.
+   */
+  void reset();
+
+private:
+  // The number of physics mesh bakes currently running in worker threads. This
+  // is shared with the bakes so that it remains valid if the manager is reset
+  // while they're still running.
+  std::shared_ptr<int32_t> _pBakesInProgress;
+
+  // The tiles whose colliders are attached. A tile's physics mesh state is
+  // released when the tile is freed, after which its game object must not be
+  // used.
+  using AttachedTile =
+      std::pair<std::weak_ptr<CesiumPhysicsMeshState>, CesiumGltfGameObject*>;
+  std::vector<AttachedTile> _attachedTiles;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,102 @@
+#include "TileDestructionQueue.h"
+
+#include "MeshSizeClass.h"
+#include "UnityLifetime.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <DotNet/CesiumForUnity/CesiumObjectPools.h>
+#include <DotNet/CesiumForUnity/CesiumSizeClassPool1.h>
+
+#include <chrono>
+
+using namespace DotNet;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+void destroyPrimitiveResources(CesiumPrimitiveResources& resources) {
+  for (const UnityEngine::Texture& texture : resources.textures) {
+    if (texture != nullptr) {
+      UnityLifetime::Destroy(texture);
+    }
+  }
+
+  if (resources.material != nullptr) {
+    UnityLifetime::Destroy(resources.material);
+  }
+
+  if (resources.mesh != nullptr) {
+    CesiumForUnity::CesiumObjectPools::MeshPool().Release(
+        resources.mesh,
+        resources.meshSizeClass,
+        MeshSizeClass::getPooledBytes(resources.meshSizeClass));
+  }
+
+  if (resources.physicsMesh != nullptr) {
+    CesiumForUnity::CesiumObjectPools::MeshPool().Release(
+        resources.physicsMesh,
+        resources.physicsMeshSizeClass,
+        MeshSizeClass::getPooledBytes(resources.physicsMeshSizeClass));
+  }
+
+  if (resources.gameObject != nullptr) {
+    UnityLifetime::Destroy(resources.gameObject);
+  }
+}
+
+} // namespace
+
+TileDestructionQueue::~TileDestructionQueue() { this->flush(); }
+
+void TileDestructionQueue::enqueue(CesiumGltfGameObject&& gameObject) {
+  if (gameObject.pGameObject && *gameObject.pGameObject != nullptr &&
+      gameObject.pGameObject->activeSelf()) {
+    gameObject.pGameObject->SetActive(false);
+  }
+
+  this->_queue.emplace_back(std::move(gameObject));
+}
+
+void TileDestructionQueue::processQueue(double timeLimitMilliseconds) {
+  CESIUM_TRACE("Cesium::TileDestructionQueue::processQueue");
+
+  if (this->_queue.empty()) {
+    return;
+  }
+
+  const bool unlimited = timeLimitMilliseconds <= 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  const auto limit = std::chrono::duration<double, std::milli>(
+      unlimited ? 0.0 : timeLimitMilliseconds);
+
+  bool destroyedAny = false;
+  while (!this->_queue.empty()) {
+    CesiumGltfGameObject& next = this->_queue.front();
+
+    // Destroy one primitive at a time so that tiles with many primitives can
+    // be spread across frames too.
+    while (!next.primitiveResources.empty()) {
+      if (!unlimited && destroyedAny &&
+          std::chrono::steady_clock::now() - start >= limit) {
+        return;
+      }
+
+      destroyPrimitiveResources(next.primitiveResources.back());
+      next.primitiveResources.pop_back();
+      destroyedAny = true;
+    }
+
+    if (next.pGameObject && *next.pGameObject != nullptr) {
+      UnityLifetime::Destroy(*next.pGameObject);
+    }
+
+    this->_queue.pop_front();
+    destroyedAny = true;
+  }
+}
+
+void TileDestructionQueue::flush() { this->processQueue(0.0); }
+
+} // namespace CesiumForUnityNative
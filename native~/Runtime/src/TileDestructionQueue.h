@@ -0,0 +1,57 @@
+#pragma once
+
+#include "UnityPrepareRendererResources.h"
+
+#include <cstddef>
+#include <deque>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Defers the destruction of the Unity objects created for unloaded
+ * tiles so that the work can be spread over multiple frames.
+ *
+ * When many tiles are evicted from the cache at once, destroying all of their
+ * game objects, materials, and textures synchronously causes visible hitches.
+ * Instead, the game object of a freed tile is deactivated immediately and
+ * queued here, and the queue is drained each frame under a time budget.
+ */
+class TileDestructionQueue {
+public:
+  TileDestructionQueue() = default;
+  ~TileDestructionQueue();
+
+  TileDestructionQueue(const TileDestructionQueue&) = delete;
+  TileDestructionQueue& operator=(const TileDestructionQueue&) = delete;
+
+  /**
+   * @brief Hides the given tile game object and queues it, along with the
+   * resources owned by its primitives, for destruction.
+   */
+  void enqueue(CesiumGltfGameObject&& gameObject);
+
+  /**
+   * @brief Destroys queued objects until the queue is empty or the time limit
+   * is exceeded. At least one primitive is destroyed on each call, so the
+   * queue always makes progress.
+   *
+   * @param timeLimitMilliseconds The maximum time to spend, in milliseconds.
+   * If this is zero or negative, the entire queue is drained.
+   */
+  void processQueue(double timeLimitMilliseconds);
+
+  /**
+   * @brief Immediately destroys all queued objects.
+   */
+  void flush();
+
+  /**
+   * @brief Gets the number of tiles still waiting to be destroyed.
+   */
+  size_t size() const noexcept { return this->_queue.size(); }
+
+private:
+  std::deque<CesiumGltfGameObject> _queue;
+};
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,136 @@
+#include "TileMemoryBudget.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The number of frames after which the priority of a tileset that stopped
+// rendering tiles has halved.
+const double recencyFrames = 60.0;
+
+struct TilesetState {
+  int64_t configuredBytes = 0;
+  int64_t shareBytes = 0;
+  int64_t allowedBytes = 0;
+  int64_t bytes = 0;
+  size_t renderedTiles = 0;
+  int32_t lastRenderedFrame = 0;
+};
+
+int32_t currentFrame = -1;
+int64_t budget = 0;
+int64_t totalBytes = 0;
+std::unordered_map<const void*, TilesetState> tilesets;
+
+double priorityOf(const TilesetState& state, int32_t frame) {
+  const double framesSinceRendered =
+      double(std::max(0, frame - state.lastRenderedFrame));
+  return double(state.renderedTiles + 1) /
+         (1.0 + framesSinceRendered / recencyFrames);
+}
+
+void shareBudget(int32_t frame) {
+  totalBytes = 0;
+  double totalPriority = 0.0;
+
+  std::vector<std::pair<double, TilesetState*>> byPriority;
+  byPriority.reserve(tilesets.size());
+  for (auto& [pTileset, state] : tilesets) {
+    const double priority = priorityOf(state, frame);
+    byPriority.emplace_back(priority, &state);
+    totalBytes += state.bytes;
+    totalPriority += priority;
+    state.shareBytes = 0;
+  }
+
+  // Share the budget in proportion to priority. A tileset can't use more than
+  // its own maximum, so what it can't use is shared among the others.
+  std::sort(
+      byPriority.begin(),
+      byPriority.end(),
+      [](const auto& a, const auto& b) {
+        return double(a.second->configuredBytes) / a.first <
+               double(b.second->configuredBytes) / b.first;
+      });
+  double remainingBytes = double(budget);
+  double remainingPriority = totalPriority;
+  for (auto& [priority, pState] : byPriority) {
+    const double share = remainingBytes * priority / remainingPriority;
+    pState->shareBytes = std::min(pState->configuredBytes, int64_t(share));
+    remainingBytes -= double(pState->shareBytes);
+    remainingPriority -= priority;
+  }
+
+  if (totalBytes <= budget) {
+    // While under budget, tilesets may grow beyond their shares into what the
+    // others aren't using.
+    const double headroom = double(budget - totalBytes);
+    for (auto& [priority, pState] : byPriority) {
+      const int64_t growth = int64_t(headroom * priority / totalPriority);
+      pState->allowedBytes = std::min(
+          pState->configuredBytes,
+          std::max(pState->shareBytes, pState->bytes + growth));
+    }
+  } else {
+    // Once over, every tileset is cut back to its share, so the tilesets that
+    // have grown beyond theirs, which are the least important, unload first.
+    for (auto& [priority, pState] : byPriority) {
+      pState->allowedBytes = pState->shareBytes;
+    }
+  }
+}
+
+} // namespace
+
+int64_t TileMemoryBudget::getAllowedBytes(
+    int32_t frame,
+    const void* pTileset,
+    int64_t budgetBytes,
+    int64_t maximumCachedBytes) {
+  auto [it, added] = tilesets.try_emplace(pTileset);
+  TilesetState& state = it->second;
+  state.configuredBytes = maximumCachedBytes;
+  if (added) {
+    state.allowedBytes = maximumCachedBytes;
+    state.lastRenderedFrame = frame;
+  }
+
+  if (frame != currentFrame || budgetBytes != budget) {
+    currentFrame = frame;
+    budget = budgetBytes;
+    shareBudget(frame);
+  }
+
+  return state.allowedBytes;
+}
+
+void TileMemoryBudget::report(
+    const void* pTileset,
+    int64_t bytes,
+    size_t renderedTiles) {
+  auto it = tilesets.find(pTileset);
+  if (it == tilesets.end()) {
+    return;
+  }
+
+  TilesetState& state = it->second;
+  state.bytes = bytes;
+  state.renderedTiles = renderedTiles;
+  if (renderedTiles > 0) {
+    state.lastRenderedFrame = currentFrame;
+  }
+}
+
+bool TileMemoryBudget::remove(const void* pTileset) {
+  return tilesets.erase(pTileset) > 0;
+}
+
+TileMemoryBudget::Statistics TileMemoryBudget::getStatistics() {
+  return Statistics{budget, totalBytes, tilesets.size()};
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Keeps the tiles and raster overlay tiles of all tilesets within one
+ * memory budget.
+ *
+ * A tileset only unloads the cached tiles that it isn't using once they take
+ * more than its maximum cached bytes, so each tileset's maximum is set from
+ * the budget on every update. Each tileset's share of the budget is in
+ * proportion to its priority, up to its own `maximumCachedBytes`. While the
+ * tilesets together are under budget, they may grow beyond their shares into
+ * what the others aren't using. Once they are over, every tileset is cut back
+ * to its share, so the tilesets that have grown beyond theirs unload tiles
+ * first. A tileset's priority grows with the number of tiles it renders and
+ * shrinks with the time since it last rendered any.
+ */
+class TileMemoryBudget {
+public:
+  struct Statistics {
+    /**
+     * @brief The budget, in bytes.
+     */
+    int64_t budgetBytes;
+
+    /**
+     * @brief The memory used by the tiles of all tilesets, in bytes.
+     */
+    int64_t totalBytes;
+
+    /**
+     * @brief The number of tilesets that share the budget.
+     */
+    size_t tilesets;
+  };
+
+  /**
+   * @brief Gets the most memory that a tileset's tiles may use. The first call
+   * in each frame shares out the budget from what the tilesets reported.
+   *
+   * @param frame The current frame.
+   * @param pTileset The tileset.
+   * @param budgetBytes The budget of all tilesets, in bytes.
+   * @param maximumCachedBytes The most that the tileset is configured to use,
+   * in bytes.
+   */
+  static int64_t getAllowedBytes(
+      int32_t frame,
+      const void* pTileset,
+      int64_t budgetBytes,
+      int64_t maximumCachedBytes);
+
+  /**
+   * @brief Reports the memory that a tileset's tiles use after its update.
+   *
+   * @param pTileset The tileset.
+   * @param bytes The memory used by its tiles and raster overlay tiles, in
+   * bytes.
+   * @param renderedTiles The number of tiles it rendered.
+   */
+  static void report(const void* pTileset, int64_t bytes, size_t renderedTiles);
+
+  /**
+   * @brief Stops sharing the budget with a tileset, such as when it is
+   * destroyed.
+   *
+   * @return Whether the tileset shared the budget.
+   */
+  static bool remove(const void* pTileset);
+
+  /**
+   * @brief Gets the current state of the budget.
+   */
+  static Statistics getStatistics();
+};
+
+} // namespace CesiumForUnityNative
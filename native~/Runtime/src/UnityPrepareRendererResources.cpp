@@ -1,6 +1,14 @@
 #include "UnityPrepareRendererResources.h"
 
+#include "CesiumMetadataImpl.h"
+#include "GltfDataReleaser.h"
+#include "MainThreadDispatcher.h"
+#include "MeshSimplifier.h"
+#include "MeshSizeClass.h"
+#include "RendererResourceMemory.h"
+#include "TaskPriority.h"
 #include "TextureLoader.h"
+#include "TileDestructionQueue.h"
 #include "UnityLifetime.h"
 #include "UnityTransforms.h"
 
@@ -22,11 +30,10 @@
 #include <DotNet/CesiumForUnity/CesiumGeoreference.h>
 #include <DotNet/CesiumForUnity/CesiumGlobeAnchor.h>
 #include <DotNet/CesiumForUnity/CesiumMetadata.h>
-#include <DotNet/CesiumForUnity/CesiumObjectPool1.h>
 #include <DotNet/CesiumForUnity/CesiumObjectPools.h>
+#include <DotNet/CesiumForUnity/CesiumSizeClassPool1.h>
 #include <DotNet/CesiumForUnity/CesiumPointCloudRenderer.h>
 #include <DotNet/System/Array1.h>
-#include <DotNet/System/Collections/Generic/List1.h>
 #include <DotNet/System/Object.h>
 #include <DotNet/Unity/Collections/Allocator.h>
 #include <DotNet/Unity/Collections/LowLevel/Unsafe/NativeArrayUnsafeUtility.h>
@@ -63,6 +70,9 @@
 #include <glm/gtc/quaternion.hpp>
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
 #include <unordered_map>
 #include <variant>
 
@@ -286,6 +296,118 @@ void generateMipMapsForPrimitive(
   }
 }
 
+/**
+ * @brief Where to write a simplified physics mesh for a primitive, and how far
+ * to simplify it.
+ */
+struct PhysicsMeshTarget {
+  UnityEngine::MeshData meshData;
+  MeshSimplificationOptions options;
+};
+
+template <typename TIndex>
+bool loadSimplifiedPhysicsMesh(
+    CesiumPrimitiveInfo& primitiveInfo,
+    const PhysicsMeshTarget& target,
+    const TIndex* indices,
+    int32_t indexCount,
+    const AccessorView<UnityEngine::Vector3>& positionView) {
+  using namespace DotNet::UnityEngine;
+  using namespace DotNet::UnityEngine::Rendering;
+  using namespace DotNet::Unity::Collections;
+  using namespace DotNet::Unity::Collections::LowLevel::Unsafe;
+
+  CESIUM_TRACE("Cesium::loadSimplifiedPhysicsMesh");
+
+  std::vector<glm::vec3> positions(static_cast<size_t>(positionView.size()));
+  for (int64_t i = 0; i < positionView.size(); ++i) {
+    const Vector3& position = positionView[i];
+    positions[i] = glm::vec3(position.x, position.y, position.z);
+  }
+
+  SimplifiedMesh simplified = MeshSimplifier::simplify(
+      positions,
+      std::vector<uint32_t>(indices, indices + indexCount),
+      target.options);
+  if (simplified.indices.empty()) {
+    return false;
+  }
+
+  MeshData meshData = target.meshData;
+
+  // Pad the buffers up to the capacities of the mesh's size class, like
+  // loadPrimitive does.
+  const int32_t simplifiedIndexCount =
+      static_cast<int32_t>(simplified.indices.size());
+  const int32_t indexCapacity =
+      MeshSizeClass::getCapacity(simplifiedIndexCount);
+  meshData.SetIndexBufferParams(indexCapacity, IndexFormat::UInt32);
+  NativeArray1<uint32_t> indexData = meshData.GetIndexData<uint32_t>();
+  uint32_t* pIndices = static_cast<uint32_t*>(
+      NativeArrayUnsafeUtility::GetUnsafeBufferPointerWithoutChecks(indexData));
+  std::memcpy(
+      pIndices,
+      simplified.indices.data(),
+      simplified.indices.size() * sizeof(uint32_t));
+  std::fill(pIndices + simplifiedIndexCount, pIndices + indexCapacity, 0U);
+
+  // Physics only needs positions.
+  System::Array1<VertexAttributeDescriptor> attributes(1);
+  VertexAttributeDescriptor positionDescriptor{};
+  positionDescriptor.attribute = VertexAttribute::Position;
+  positionDescriptor.format = VertexAttributeFormat::Float32;
+  positionDescriptor.dimension = 3;
+  positionDescriptor.stream = 0;
+  attributes.Item(0, positionDescriptor);
+
+  const int32_t simplifiedVertexCount =
+      static_cast<int32_t>(simplified.positions.size());
+  const int32_t vertexCapacity =
+      MeshSizeClass::getCapacity(simplifiedVertexCount);
+  meshData.SetVertexBufferParams(vertexCapacity, attributes);
+  NativeArray1<Vector3> vertexData = meshData.GetVertexData<Vector3>(0);
+  Vector3* pVertices = static_cast<Vector3*>(
+      NativeArrayUnsafeUtility::GetUnsafeBufferPointerWithoutChecks(
+          vertexData));
+  std::memcpy(
+      pVertices,
+      simplified.positions.data(),
+      simplified.positions.size() * sizeof(Vector3));
+  std::fill(
+      pVertices + simplifiedVertexCount,
+      pVertices + vertexCapacity,
+      pVertices[0]);
+
+  meshData.subMeshCount(1);
+
+  SubMeshDescriptor subMeshDescriptor{};
+  subMeshDescriptor.topology = MeshTopology::Triangles;
+  subMeshDescriptor.indexStart = 0;
+  subMeshDescriptor.indexCount = simplifiedIndexCount;
+  subMeshDescriptor.baseVertex = 0;
+  subMeshDescriptor.firstVertex = 0;
+  subMeshDescriptor.vertexCount = 0;
+
+  meshData.SetSubMesh(0, subMeshDescriptor, MeshUpdateFlags::Default);
+
+  primitiveInfo.physicsMeshSizeClass = MeshSizeClass::getSizeClass(
+      vertexCapacity,
+      indexCapacity,
+      MeshSizeClass::getVertexLayout(false, false, 0),
+      true);
+  primitiveInfo.meshBytes += RendererResourceMemory::computeMeshBytes(
+      vertexCapacity,
+      sizeof(Vector3),
+      indexCapacity,
+      sizeof(uint32_t));
+  primitiveInfo.bakedPhysicsMeshBytes =
+      RendererResourceMemory::computeBakedMeshBytes(
+          vertexCapacity,
+          simplifiedIndexCount);
+
+  return true;
+}
+
 template <typename TIndex, class TIndexAccessor>
 void loadPrimitive(
     UnityEngine::MeshData meshData,
@@ -297,7 +419,8 @@ void loadPrimitive(
     const glm::dmat4& transform,
     const TIndexAccessor& indicesView,
     UnityEngine::Rendering::IndexFormat indexFormat,
-    const AccessorView<UnityEngine::Vector3>& positionView) {
+    const AccessorView<UnityEngine::Vector3>& positionView,
+    const PhysicsMeshTarget* pPhysicsMesh) {
   using namespace DotNet::UnityEngine;
   using namespace DotNet::UnityEngine::Rendering;
   using namespace DotNet::Unity::Collections;
@@ -323,12 +446,22 @@ void loadPrimitive(
     return;
   }
 
-  meshData.SetIndexBufferParams(indexCount, indexFormat);
+  // The buffers of triangle meshes are padded up to the capacities of their
+  // size class, so that a pooled mesh of the same size class can be reused
+  // without reallocating them. The padding indices are 0, past the end of the
+  // sub-mesh, and the padding vertices are copies of the first vertex. Point
+  // clouds are drawn from all of their vertices, so they aren't padded.
+  const bool padToSizeClass = primitive.mode != MeshPrimitive::Mode::POINTS;
+  const int32_t indexCapacity =
+      padToSizeClass ? MeshSizeClass::getCapacity(indexCount) : indexCount;
+
+  meshData.SetIndexBufferParams(indexCapacity, indexFormat);
   const Unity::Collections::NativeArray1<TIndex>& dest =
       meshData.GetIndexData<TIndex>();
   TIndex* indices = static_cast<TIndex*>(
       Unity::Collections::LowLevel::Unsafe::NativeArrayUnsafeUtility::
           GetUnsafeBufferPointerWithoutChecks(dest));
+  std::fill(indices + indexCount, indices + indexCapacity, TIndex(0));
 
   if (primitive.mode == MeshPrimitive::Mode::TRIANGLES ||
       primitive.mode == MeshPrimitive::Mode::POINTS) {
@@ -356,6 +489,17 @@ void loadPrimitive(
     }
   }
 
+  // The indices still refer to the glTF vertices at this point, so this is the
+  // time to create a simplified physics mesh from them.
+  if (pPhysicsMesh && primitive.mode != MeshPrimitive::Mode::POINTS) {
+    primitiveInfo.hasSimplifiedPhysicsMesh = loadSimplifiedPhysicsMesh(
+        primitiveInfo,
+        *pPhysicsMesh,
+        indices,
+        indexCount,
+        positionView);
+  }
+
   // Max attribute count supported by Unity, see VertexAttribute.
   const int MAX_ATTRIBUTES = 14;
   VertexAttributeDescriptor descriptor[MAX_ATTRIBUTES];
@@ -506,7 +650,23 @@ void loadPrimitive(
   int32_t vertexCount = computeFlatNormals
                             ? indexCount
                             : static_cast<int32_t>(positionView.size());
-  meshData.SetVertexBufferParams(vertexCount, attributes);
+  int32_t vertexCapacity =
+      padToSizeClass ? MeshSizeClass::getCapacity(vertexCount) : vertexCount;
+  if (padToSizeClass && sizeof(TIndex) == sizeof(uint16_t) &&
+      vertexCapacity > std::numeric_limits<uint16_t>::max()) {
+    // Padding would take the vertices past what 16-bit indices allow.
+    vertexCapacity = vertexCount;
+  } else if (padToSizeClass) {
+    primitiveInfo.meshSizeClass = MeshSizeClass::getSizeClass(
+        vertexCapacity,
+        indexCapacity,
+        MeshSizeClass::getVertexLayout(
+            hasNormals,
+            hasVertexColors,
+            numTexCoords),
+        sizeof(TIndex) == sizeof(uint32_t));
+  }
+  meshData.SetVertexBufferParams(vertexCapacity, attributes);
 
   NativeArray1<uint8_t> nativeVertexBuffer =
       meshData.GetVertexData<uint8_t>(streamIndex);
@@ -535,6 +695,18 @@ void loadPrimitive(
   }
   stride += numTexCoords * sizeof(Vector2);
 
+  primitiveInfo.meshBytes += RendererResourceMemory::computeMeshBytes(
+      vertexCapacity,
+      stride,
+      indexCapacity,
+      sizeof(TIndex));
+  if (!primitiveInfo.hasSimplifiedPhysicsMesh) {
+    primitiveInfo.bakedPhysicsMeshBytes =
+        RendererResourceMemory::computeBakedMeshBytes(
+            vertexCapacity,
+            indexCount);
+  }
+
   if (computeFlatNormals) {
     ::computeFlatNormals(
         pWritePos + normalByteOffset,
@@ -598,6 +770,10 @@ void loadPrimitive(
             indices});
   }
 
+  for (int32_t i = vertexCount; i < vertexCapacity; ++i) {
+    std::memcpy(pBufferStart + i * stride, pBufferStart, stride);
+  }
+
   if (computeFlatNormals) {
     // rewrite indices
     for (TIndex i = 0; i < indexCount; i++) {
@@ -628,6 +804,17 @@ void loadPrimitive(
 
   meshData.SetSubMesh(0, subMeshDescriptor, MeshUpdateFlags::Default);
 }
+
+int64_t computeTextureBytes(const Model& model, int32_t textureIndex) {
+  const Texture* pTexture = Model::getSafe(&model.textures, textureIndex);
+  if (!pTexture) {
+    return 0;
+  }
+  const Image* pImage = Model::getSafe(&model.images, pTexture->source);
+  return pImage ? RendererResourceMemory::computeTextureBytes(pImage->cesium)
+                : 0;
+}
+
 } // namespace
 
 int32_t countPrimitives(const CesiumGltf::Model& model) {
@@ -645,29 +832,47 @@ int32_t countPrimitives(const CesiumGltf::Model& model) {
 
 void populateMeshDataArray(
     MeshDataResult& meshDataResult,
-    TileLoadResult& tileLoadResult) {
+    TileLoadResult& tileLoadResult,
+    const std::optional<MeshSimplificationOptions>& physicsMeshOptions) {
   CesiumGltf::Model* pModel =
       std::get_if<CesiumGltf::Model>(&tileLoadResult.contentKind);
   if (!pModel)
     return;
 
   int32_t meshDataInstance = 0;
+  const int32_t numberOfPrimitives = countPrimitives(*pModel);
 
-  meshDataResult.primitiveInfos.reserve(countPrimitives(*pModel));
+  meshDataResult.primitiveInfos.reserve(numberOfPrimitives);
 
   pModel->forEachPrimitiveInScene(
       -1,
-      [&meshDataResult, &meshDataInstance, pModel](
+      [&meshDataResult,
+       &meshDataInstance,
+       numberOfPrimitives,
+       &physicsMeshOptions,
+       pModel](
           const Model& gltf,
           const Node& node,
           const Mesh& mesh,
           const MeshPrimitive& primitive,
           const glm::dmat4& transform) {
+        const int32_t primitiveIndex = meshDataInstance++;
         UnityEngine::MeshData meshData =
-            meshDataResult.meshDataArray[meshDataInstance++];
+            meshDataResult.meshDataArray[primitiveIndex];
         CesiumPrimitiveInfo& primitiveInfo =
             meshDataResult.primitiveInfos.emplace_back();
 
+        // The MeshData for the simplified physics meshes, if requested,
+        // follow the ones for the render meshes.
+        std::optional<PhysicsMeshTarget> physicsMesh;
+        if (physicsMeshOptions) {
+          physicsMesh = PhysicsMeshTarget{
+              meshDataResult.meshDataArray[numberOfPrimitives + primitiveIndex],
+              *physicsMeshOptions};
+        }
+        const PhysicsMeshTarget* pPhysicsMesh =
+            physicsMesh ? &*physicsMesh : nullptr;
+
         auto positionAccessorIt = primitive.attributes.find("POSITION");
         if (positionAccessorIt == primitive.attributes.end()) {
           // This primitive doesn't have a POSITION semantic, ignore it.
@@ -699,7 +904,8 @@ void populateMeshDataArray(
                 transform,
                 generateIndices<std::uint32_t>(indexCount),
                 UnityEngine::Rendering::IndexFormat::UInt32,
-                positionView);
+                positionView,
+                pPhysicsMesh);
           } else {
             loadPrimitive<std::uint16_t>(
                 meshData,
@@ -711,7 +917,8 @@ void populateMeshDataArray(
                 transform,
                 generateIndices<std::uint16_t>(indexCount),
                 UnityEngine::Rendering::IndexFormat::UInt16,
-                positionView);
+                positionView,
+                pPhysicsMesh);
           }
         } else {
           const Accessor& indexAccessorGltf = gltf.accessors[primitive.indices];
@@ -728,7 +935,8 @@ void populateMeshDataArray(
                 transform,
                 indexAccessor,
                 UnityEngine::Rendering::IndexFormat::UInt16,
-                positionView);
+                positionView,
+                pPhysicsMesh);
             break;
           }
           case Accessor::ComponentType::UNSIGNED_BYTE: {
@@ -743,7 +951,8 @@ void populateMeshDataArray(
                 transform,
                 indexAccessor,
                 UnityEngine::Rendering::IndexFormat::UInt16,
-                positionView);
+                positionView,
+                pPhysicsMesh);
             break;
           }
           case Accessor::ComponentType::SHORT: {
@@ -758,7 +967,8 @@ void populateMeshDataArray(
                 transform,
                 indexAccessor,
                 UnityEngine::Rendering::IndexFormat::UInt16,
-                positionView);
+                positionView,
+                pPhysicsMesh);
             break;
           }
           case Accessor::ComponentType::UNSIGNED_SHORT: {
@@ -773,7 +983,8 @@ void populateMeshDataArray(
                 transform,
                 indexAccessor,
                 UnityEngine::Rendering::IndexFormat::UInt16,
-                positionView);
+                positionView,
+                pPhysicsMesh);
             break;
           }
           case Accessor::ComponentType::UNSIGNED_INT: {
@@ -788,7 +999,8 @@ void populateMeshDataArray(
                 transform,
                 indexAccessor,
                 UnityEngine::Rendering::IndexFormat::UInt32,
-                positionView);
+                positionView,
+                pPhysicsMesh);
             break;
           }
           default:
@@ -822,11 +1034,25 @@ bool isDegenerateTriangleMesh(const UnityEngine::Mesh& mesh) {
 struct LoadThreadResult {
   System::Array1<UnityEngine::Mesh> meshes;
   std::vector<CesiumPrimitiveInfo> primitiveInfos{};
+
+  /**
+   * @brief The simplified physics mesh for each primitive, or null where the
+   * primitive doesn't have one. This is empty if physics meshes are not
+   * simplified.
+   */
+  std::vector<UnityEngine::Mesh> physicsMeshes{};
 };
 
 UnityPrepareRendererResources::UnityPrepareRendererResources(
-    const UnityEngine::GameObject& tileset)
-    : _tileset(tileset), _shaderProperty() {}
+    const UnityEngine::GameObject& tileset,
+    const std::shared_ptr<TileDestructionQueue>& pDestructionQueue,
+    const std::shared_ptr<PrioritizedTaskProcessor>& pTaskProcessor,
+    const std::shared_ptr<RendererResourceMemory>& pResourceMemory)
+    : _tileset(tileset),
+      _shaderProperty(),
+      _pDestructionQueue(pDestructionQueue),
+      _pTaskProcessor(pTaskProcessor),
+      _pResourceMemory(pResourceMemory) {}
 
 CesiumAsync::Future<TileLoadResultAndRenderResources>
 UnityPrepareRendererResources::prepareInLoadThread(
@@ -842,27 +1068,199 @@ UnityPrepareRendererResources::prepareInLoadThread(
 
   int32_t numberOfPrimitives = countPrimitives(*pModel);
 
+  struct MeshDataAllocation {
+    UnityEngine::MeshDataArray meshDataArray;
+    std::optional<MeshSimplificationOptions> physicsMeshOptions;
+  };
+
   struct IntermediateLoadThreadResult {
     MeshDataResult meshDataResult;
     TileLoadResult tileLoadResult;
   };
 
-  return asyncSystem
-      .runInMainThread([numberOfPrimitives]() {
-        // Allocate a MeshDataArray for the primitives.
-        // Unfortunately, this must be done on the main thread.
-        return UnityEngine::Mesh::AllocateWritableMeshData(numberOfPrimitives);
-      })
+  auto allocateMeshData = [numberOfPrimitives, tileset = this->_tileset]() {
+    std::optional<MeshSimplificationOptions> physicsMeshOptions;
+
+    DotNet::CesiumForUnity::Cesium3DTileset tilesetComponent =
+        tileset.GetComponent<DotNet::CesiumForUnity::Cesium3DTileset>();
+    if (tilesetComponent != nullptr && tilesetComponent.createPhysicsMeshes() &&
+        tilesetComponent.simplifyPhysicsMeshes()) {
+      physicsMeshOptions = MeshSimplificationOptions{
+          tilesetComponent.physicsMeshTriangleRatio(),
+          tilesetComponent.physicsMeshMaximumError()};
+    }
+
+    // Allocate a MeshDataArray for the primitives, followed by one for
+    // each primitive's simplified physics mesh if needed.
+    // Unfortunately, this must be done on the main thread.
+    int32_t meshCount =
+        physicsMeshOptions ? 2 * numberOfPrimitives : numberOfPrimitives;
+    return MeshDataAllocation{
+        UnityEngine::Mesh::AllocateWritableMeshData(meshCount),
+        physicsMeshOptions};
+  };
+
+  auto createMeshes = [asyncSystem,
+                       numberOfPrimitives,
+                       tileset = this->_tileset](
+                          IntermediateLoadThreadResult&& workerResult) {
+    bool shouldCreatePhysicsMeshes = false;
+    bool shouldShowTilesInHierarchy = false;
+
+    DotNet::CesiumForUnity::Cesium3DTileset tilesetComponent =
+        tileset.GetComponent<DotNet::CesiumForUnity::Cesium3DTileset>();
+    if (tilesetComponent != nullptr) {
+      // When physics meshes are limited to the vicinity of interest
+      // points, they're baked later on demand instead.
+      shouldCreatePhysicsMeshes =
+          tilesetComponent.createPhysicsMeshes() &&
+          !tilesetComponent.limitPhysicsMeshesToInterestPoints();
+      shouldShowTilesInHierarchy = tilesetComponent.showTilesInHierarchy();
+    }
+
+    const UnityEngine::MeshDataArray& meshDataArray =
+        workerResult.meshDataResult.meshDataArray;
+    const std::vector<CesiumPrimitiveInfo>& primitiveInfos =
+        workerResult.meshDataResult.primitiveInfos;
+
+    // Create meshes and populate them from the MeshData created in
+    // the worker thread. Sadly, this must be done in the main
+    // thread, too.
+    System::Array1<UnityEngine::Mesh> meshes(meshDataArray.Length());
+    for (int32_t i = 0, len = meshes.Length(); i < len; ++i) {
+      // Reuse a pooled mesh of the size class that the MeshData was padded
+      // to, if there is one, so that its buffers aren't reallocated.
+      const int32_t sizeClass =
+          i < numberOfPrimitives
+              ? primitiveInfos[i].meshSizeClass
+              : primitiveInfos[i - numberOfPrimitives].physicsMeshSizeClass;
+
+      UnityEngine::Mesh unityMesh =
+          CesiumForUnity::CesiumObjectPools::MeshPool().Get(sizeClass);
+      // Don't let Unity unload this mesh during the time in between
+      // when we create it and when we attach it to a GameObject.
+      if (shouldShowTilesInHierarchy) {
+        unityMesh.hideFlags(UnityEngine::HideFlags::HideAndDontSave);
+      } else {
+        unityMesh.hideFlags(
+            UnityEngine::HideFlags::HideAndDontSave |
+            UnityEngine::HideFlags::HideInHierarchy);
+      }
+
+      meshes.Item(i, unityMesh);
+    }
+
+    // TODO: Validate indices in the worker thread, and then ask Unity
+    // not to do it here by setting
+    // MeshUpdateFlags::DontValidateIndices.
+    UnityEngine::Mesh::ApplyAndDisposeWritableMeshData(
+        meshDataArray,
+        meshes,
+        UnityEngine::Rendering::MeshUpdateFlags::Default);
+
+    // TODO: we should be able to do this in the worker thread, even if
+    // we have to do it manually.
+    for (int32_t i = 0, len = meshes.Length(); i < len; ++i) {
+      meshes[i].RecalculateBounds();
+    }
+
+    // Separate the simplified physics meshes, if any, from the render
+    // meshes that precede them.
+    std::vector<UnityEngine::Mesh> physicsMeshes;
+    if (meshes.Length() > numberOfPrimitives) {
+      System::Array1<UnityEngine::Mesh> renderMeshes(numberOfPrimitives);
+      physicsMeshes.reserve(numberOfPrimitives);
+      for (int32_t i = 0; i < numberOfPrimitives; ++i) {
+        renderMeshes.Item(i, meshes[i]);
+
+        UnityEngine::Mesh physicsMesh = meshes[numberOfPrimitives + i];
+        if (primitiveInfos[i].hasSimplifiedPhysicsMesh) {
+          physicsMeshes.emplace_back(physicsMesh);
+        } else {
+          const int32_t sizeClass = primitiveInfos[i].physicsMeshSizeClass;
+          CesiumForUnity::CesiumObjectPools::MeshPool().Release(
+              physicsMesh,
+              sizeClass,
+              MeshSizeClass::getPooledBytes(sizeClass));
+          physicsMeshes.emplace_back(nullptr);
+        }
+      }
+      meshes = renderMeshes;
+    }
+
+    if (shouldCreatePhysicsMeshes) {
+      // Baking physics meshes takes awhile, so do that in a
+      // worker thread.
+      const std::int32_t len = meshes.Length();
+      std::vector<std::int32_t> instanceIDs;
+      for (int32_t i = 0; i < len; ++i) {
+        // Don't attempt to bake a physics mesh from a point cloud or
+        // from an invalid triangle mesh.
+        UnityEngine::Mesh colliderMesh =
+            !physicsMeshes.empty() && physicsMeshes[i] != nullptr
+                ? physicsMeshes[i]
+                : meshes[i];
+        if (primitiveInfos[i].containsPoints ||
+            isDegenerateTriangleMesh(colliderMesh)) {
+          continue;
+        }
+
+        instanceIDs.push_back(colliderMesh.GetInstanceID());
+      }
+
+      if (instanceIDs.size() > 0) {
+        return asyncSystem.runInWorkerThread(
+            [workerResult = std::move(workerResult),
+             instanceIDs = std::move(instanceIDs),
+             meshes = std::move(meshes),
+             physicsMeshes = std::move(physicsMeshes)]() mutable {
+              for (std::int32_t instanceID : instanceIDs) {
+                UnityEngine::Physics::BakeMesh(instanceID, false);
+              }
+
+              LoadThreadResult* pResult = new LoadThreadResult{
+                  std::move(meshes),
+                  std::move(workerResult.meshDataResult.primitiveInfos),
+                  std::move(physicsMeshes)};
+              return TileLoadResultAndRenderResources{
+                  std::move(workerResult.tileLoadResult),
+                  pResult};
+            });
+      }
+    }
+
+    LoadThreadResult* pResult = new LoadThreadResult{
+        std::move(meshes),
+        std::move(workerResult.meshDataResult.primitiveInfos),
+        std::move(physicsMeshes)};
+    return asyncSystem.createResolvedFuture(
+        TileLoadResultAndRenderResources{
+            std::move(workerResult.tileLoadResult),
+            pResult});
+  };
+
+  // The main thread parts go through the dispatcher, which spreads them over
+  // frames along with those of other tilesets, most urgent first.
+  return MainThreadDispatcher::run(
+             asyncSystem,
+             this->_pTaskProcessor.get(),
+             this->_pTaskProcessor->getPriority(),
+             std::move(allocateMeshData))
       .thenInWorkerThread(
           [tileLoadResult = std::move(tileLoadResult)](
-              UnityEngine::MeshDataArray&& meshDataArray) mutable {
-            MeshDataResult meshDataResult{std::move(meshDataArray), {}};
+              MeshDataAllocation&& allocation) mutable {
+            MeshDataResult meshDataResult{
+                std::move(allocation.meshDataArray),
+                {}};
             // Free the MeshDataArray if something goes wrong.
             ScopeGuard sg([&meshDataResult]() {
               meshDataResult.meshDataArray.Dispose();
             });
 
-            populateMeshDataArray(meshDataResult, tileLoadResult);
+            populateMeshDataArray(
+                meshDataResult,
+                tileLoadResult,
+                allocation.physicsMeshOptions);
 
             // We're returning the MeshDataArray, so don't free it.
             sg.release();
@@ -870,103 +1268,19 @@ UnityPrepareRendererResources::prepareInLoadThread(
                 std::move(meshDataResult),
                 std::move(tileLoadResult)};
           })
-      .thenInMainThread(
-          [asyncSystem, tileset = this->_tileset](
+      .thenImmediately(
+          [asyncSystem,
+           pTaskProcessor = this->_pTaskProcessor,
+           createMeshes = std::move(createMeshes)](
               IntermediateLoadThreadResult&& workerResult) mutable {
-            bool shouldCreatePhysicsMeshes = false;
-            bool shouldShowTilesInHierarchy = false;
-
-            DotNet::CesiumForUnity::Cesium3DTileset tilesetComponent =
-                tileset.GetComponent<DotNet::CesiumForUnity::Cesium3DTileset>();
-            if (tilesetComponent != nullptr) {
-              shouldCreatePhysicsMeshes =
-                  tilesetComponent.createPhysicsMeshes();
-              shouldShowTilesInHierarchy =
-                  tilesetComponent.showTilesInHierarchy();
-            }
-
-            const UnityEngine::MeshDataArray& meshDataArray =
-                workerResult.meshDataResult.meshDataArray;
-            const std::vector<CesiumPrimitiveInfo>& primitiveInfos =
-                workerResult.meshDataResult.primitiveInfos;
-
-            // Create meshes and populate them from the MeshData created in
-            // the worker thread. Sadly, this must be done in the main
-            // thread, too.
-            System::Array1<UnityEngine::Mesh> meshes(meshDataArray.Length());
-            for (int32_t i = 0, len = meshes.Length(); i < len; ++i) {
-              UnityEngine::Mesh unityMesh =
-                  CesiumForUnity::CesiumObjectPools::MeshPool().Get();
-              // Don't let Unity unload this mesh during the time in between
-              // when we create it and when we attach it to a GameObject.
-              if (shouldShowTilesInHierarchy) {
-                unityMesh.hideFlags(UnityEngine::HideFlags::HideAndDontSave);
-              } else {
-                unityMesh.hideFlags(
-                    UnityEngine::HideFlags::HideAndDontSave |
-                    UnityEngine::HideFlags::HideInHierarchy);
-              }
-
-              meshes.Item(i, unityMesh);
-            }
-
-            // TODO: Validate indices in the worker thread, and then ask Unity
-            // not to do it here by setting
-            // MeshUpdateFlags::DontValidateIndices.
-            UnityEngine::Mesh::ApplyAndDisposeWritableMeshData(
-                meshDataArray,
-                meshes,
-                UnityEngine::Rendering::MeshUpdateFlags::Default);
-
-            // TODO: we should be able to do this in the worker thread, even if
-            // we have to do it manually.
-            for (int32_t i = 0, len = meshes.Length(); i < len; ++i) {
-              meshes[i].RecalculateBounds();
-            }
-
-            if (shouldCreatePhysicsMeshes) {
-              // Baking physics meshes takes awhile, so do that in a
-              // worker thread.
-              const std::int32_t len = meshes.Length();
-              std::vector<std::int32_t> instanceIDs;
-              for (int32_t i = 0; i < len; ++i) {
-                // Don't attempt to bake a physics mesh from a point cloud or
-                // from an invalid triangle mesh.
-                if (primitiveInfos[i].containsPoints ||
-                    isDegenerateTriangleMesh(meshes[i])) {
-                  continue;
-                }
-
-                instanceIDs.push_back(meshes[i].GetInstanceID());
-              }
-
-              if (instanceIDs.size() > 0) {
-                return asyncSystem.runInWorkerThread(
-                    [workerResult = std::move(workerResult),
-                     instanceIDs = std::move(instanceIDs),
-                     meshes = std::move(meshes)]() mutable {
-                      for (std::int32_t instanceID : instanceIDs) {
-                        UnityEngine::Physics::BakeMesh(instanceID, false);
-                      }
-
-                      LoadThreadResult* pResult = new LoadThreadResult{
-                          std::move(meshes),
-                          std::move(
-                              workerResult.meshDataResult.primitiveInfos)};
-                      return TileLoadResultAndRenderResources{
-                          std::move(workerResult.tileLoadResult),
-                          pResult};
-                    });
-              }
-            }
-
-            LoadThreadResult* pResult = new LoadThreadResult{
-                std::move(meshes),
-                std::move(workerResult.meshDataResult.primitiveInfos)};
-            return asyncSystem.createResolvedFuture(
-                TileLoadResultAndRenderResources{
-                    std::move(workerResult.tileLoadResult),
-                    pResult});
+            return MainThreadDispatcher::run(
+                asyncSystem,
+                pTaskProcessor.get(),
+                pTaskProcessor->getPriority(),
+                [createMeshes = std::move(createMeshes),
+                 workerResult = std::move(workerResult)]() mutable {
+                  return createMeshes(std::move(workerResult));
+                });
           });
 }
 
@@ -979,6 +1293,8 @@ void* UnityPrepareRendererResources::prepareInMainThread(
   const System::Array1<UnityEngine::Mesh>& meshes = pLoadThreadResult->meshes;
   const std::vector<CesiumPrimitiveInfo>& primitiveInfos =
       pLoadThreadResult->primitiveInfos;
+  const std::vector<UnityEngine::Mesh>& physicsMeshes =
+      pLoadThreadResult->physicsMeshes;
 
   const Cesium3DTilesSelection::TileContent& content = tile.getContent();
   const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
@@ -1036,6 +1352,8 @@ void* UnityPrepareRendererResources::prepareInMainThread(
   }
 
   const bool createPhysicsMeshes = tilesetComponent.createPhysicsMeshes();
+  const bool createCollidersLazily =
+      tilesetComponent.limitPhysicsMeshesToInterestPoints();
   const bool showTilesInHierarchy = tilesetComponent.showTilesInHierarchy();
 
   int32_t meshIndex = 0;
@@ -1051,16 +1369,24 @@ void* UnityPrepareRendererResources::prepareInMainThread(
     }
   }
 
+  std::vector<CesiumPrimitiveResources> primitiveResources;
+  primitiveResources.reserve(primitiveInfos.size());
+  int64_t resourceBytes = 0;
+
   model.forEachPrimitiveInScene(
       -1,
       [&meshes,
        &primitiveInfos,
+       &physicsMeshes,
+       &primitiveResources,
+       &resourceBytes,
        &pModelGameObject,
        &tileTransform,
        &meshIndex,
        &tilesetComponent,
        pCoordinateSystem,
        createPhysicsMeshes,
+       createCollidersLazily,
        showTilesInHierarchy,
        currentOverlayCount,
        &pMetadataComponent,
@@ -1073,6 +1399,9 @@ void* UnityPrepareRendererResources::prepareInMainThread(
           const MeshPrimitive& primitive,
           const glm::dmat4& transform) {
         const CesiumPrimitiveInfo& primitiveInfo = primitiveInfos[meshIndex];
+        UnityEngine::Mesh physicsMesh = physicsMeshes.empty()
+                                            ? UnityEngine::Mesh(nullptr)
+                                            : physicsMeshes[meshIndex];
         UnityEngine::Mesh unityMesh = meshes[meshIndex++];
         if (unityMesh == nullptr) {
           // This indicates Unity destroyed the mesh already, which really
@@ -1149,6 +1478,29 @@ void* UnityPrepareRendererResources::prepareInMainThread(
         material.hideFlags(UnityEngine::HideFlags::HideAndDontSave);
         meshRenderer.material(material);
 
+        CesiumPrimitiveResources& resources =
+            primitiveResources.emplace_back();
+        resources.gameObject = primitiveGameObject;
+        resources.mesh = unityMesh;
+        resources.physicsMesh = physicsMesh;
+        resources.meshSizeClass = primitiveInfo.meshSizeClass;
+        resources.physicsMeshSizeClass = primitiveInfo.physicsMeshSizeClass;
+        resources.material = material;
+        resourceBytes += primitiveInfo.meshBytes +
+                         RendererResourceMemory::computeMaterialBytes();
+
+        // The textures loaded for the material are owned by the primitive.
+        auto loadTexture = [&gltf, &resources, &resourceBytes](
+                               int32_t textureIndex) {
+          UnityEngine::Texture texture =
+              TextureLoader::loadTexture(gltf, textureIndex);
+          if (texture != nullptr) {
+            resources.textures.push_back(texture);
+            resourceBytes += computeTextureBytes(gltf, textureIndex);
+          }
+          return texture;
+        };
+
         bool isTranslucent = primitiveInfo.isTranslucent;
         if (pMaterial) {
           CESIUM_TRACE("Cesium::CreateMaterials");
@@ -1190,7 +1542,7 @@ void* UnityPrepareRendererResources::prepareInMainThread(
                   primitiveInfo.uvIndexMap.find(baseColorTexture->texCoord);
               if (texCoordIndexIt != primitiveInfo.uvIndexMap.end()) {
                 UnityEngine::Texture texture =
-                    TextureLoader::loadTexture(gltf, baseColorTexture->index);
+                    loadTexture(baseColorTexture->index);
                 if (texture != nullptr) {
                   material.SetTexture(
                       shaderProperty.getBaseColorTextureID(),
@@ -1209,7 +1561,7 @@ void* UnityPrepareRendererResources::prepareInMainThread(
                   primitiveInfo.uvIndexMap.find(metallicRoughness->texCoord);
               if (texCoordIndexIt != primitiveInfo.uvIndexMap.end()) {
                 UnityEngine::Texture texture =
-                    TextureLoader::loadTexture(gltf, metallicRoughness->index);
+                    loadTexture(metallicRoughness->index);
                 if (texture != nullptr) {
                   material.SetTexture(
                       shaderProperty.getMetallicRoughnessTextureID(),
@@ -1227,9 +1579,8 @@ void* UnityPrepareRendererResources::prepareInMainThread(
             auto texCoordIndexIt = primitiveInfo.uvIndexMap.find(
                 pMaterial->normalTexture->texCoord);
             if (texCoordIndexIt != primitiveInfo.uvIndexMap.end()) {
-              UnityEngine::Texture texture = TextureLoader::loadTexture(
-                  gltf,
-                  pMaterial->normalTexture->index);
+              UnityEngine::Texture texture =
+                  loadTexture(pMaterial->normalTexture->index);
               if (texture != nullptr) {
                 material.SetTexture(
                     shaderProperty.getNormalMapTextureID(),
@@ -1248,9 +1599,8 @@ void* UnityPrepareRendererResources::prepareInMainThread(
             auto texCoordIndexIt = primitiveInfo.uvIndexMap.find(
                 pMaterial->occlusionTexture->texCoord);
             if (texCoordIndexIt != primitiveInfo.uvIndexMap.end()) {
-              UnityEngine::Texture texture = TextureLoader::loadTexture(
-                  gltf,
-                  pMaterial->occlusionTexture->index);
+              UnityEngine::Texture texture =
+                  loadTexture(pMaterial->occlusionTexture->index);
               if (texture != nullptr) {
                 material.SetTexture(
                     shaderProperty.getOcclusionTextureID(),
@@ -1284,9 +1634,8 @@ void* UnityPrepareRendererResources::prepareInMainThread(
             auto texCoordIndexIt = primitiveInfo.uvIndexMap.find(
                 pMaterial->emissiveTexture->texCoord);
             if (texCoordIndexIt != primitiveInfo.uvIndexMap.end()) {
-              UnityEngine::Texture texture = TextureLoader::loadTexture(
-                  gltf,
-                  pMaterial->emissiveTexture->index);
+              UnityEngine::Texture texture =
+                  loadTexture(pMaterial->emissiveTexture->index);
               if (texture != nullptr) {
                 material.SetTexture(
                     shaderProperty.getEmissiveTextureID(),
@@ -1338,13 +1687,17 @@ void* UnityPrepareRendererResources::prepareInMainThread(
         }
 
         if (createPhysicsMeshes) {
-          if (!primitiveInfo.containsPoints &&
-              !isDegenerateTriangleMesh(unityMesh)) {
+          resources.canCreateCollider =
+              !primitiveInfo.containsPoints &&
+              !isDegenerateTriangleMesh(resources.getColliderMesh());
+          if (resources.canCreateCollider && !createCollidersLazily) {
             // This should not trigger mesh baking for physics, because the
             // meshes were already baked in the worker thread.
             UnityEngine::MeshCollider meshCollider =
                 primitiveGameObject.AddComponent<UnityEngine::MeshCollider>();
-            meshCollider.sharedMesh(unityMesh);
+            meshCollider.sharedMesh(resources.getColliderMesh());
+            resources.collider = meshCollider;
+            resourceBytes += primitiveInfo.bakedPhysicsMeshBytes;
           }
         }
 
@@ -1362,51 +1715,22 @@ void* UnityPrepareRendererResources::prepareInMainThread(
 
   CesiumGltfGameObject* pCesiumGameObject = new CesiumGltfGameObject{
       std::move(pModelGameObject),
-      std::move(pLoadThreadResult->primitiveInfos)};
-
-  return pCesiumGameObject;
-}
-
-namespace {
-
-void freePrimitiveGameObject(
-    const DotNet::UnityEngine::GameObject& primitiveGameObject,
-    const DotNet::CesiumForUnity::CesiumMetadata& maybeMetadata) {
-  if (maybeMetadata != nullptr) {
-    maybeMetadata.NativeImplementation().removeMetadata(
-        primitiveGameObject.transform().GetInstanceID());
+      std::move(pLoadThreadResult->primitiveInfos),
+      std::move(primitiveResources)};
+  pCesiumGameObject->resourceBytes = resourceBytes;
+  this->_pResourceMemory->add(resourceBytes);
+
+  // Raster overlays are draped over tiles by upsampling their geometry, so
+  // it's only released from tilesets without them.
+  if (tilesetComponent.releaseGltfData() && currentOverlayCount == 0) {
+    Model& loadedModel = tile.getContent().getRenderContent()->getModel();
+    this->_pResourceMemory->addReleasedGltfBytes(
+        GltfDataReleaser::release(loadedModel));
   }
 
-  UnityEngine::MeshRenderer meshRenderer =
-      primitiveGameObject.GetComponent<UnityEngine::MeshRenderer>();
-  if (meshRenderer != nullptr) {
-    UnityEngine::Material material = meshRenderer.sharedMaterial();
-
-    System::Collections::Generic::List1<int> textureIDs;
-    material.GetTexturePropertyNameIDs(textureIDs);
-    for (int32_t i = 0, len = textureIDs.Count(); i < len; ++i) {
-      int32_t textureID = textureIDs[i];
-      UnityEngine::Texture texture = material.GetTexture(textureID);
-      if (texture != nullptr)
-        UnityLifetime::Destroy(texture);
-    }
-
-    UnityLifetime::Destroy(material);
-  }
-
-  UnityEngine::MeshFilter meshFilter =
-      primitiveGameObject.GetComponent<UnityEngine::MeshFilter>();
-  if (meshFilter != nullptr) {
-    CesiumForUnity::CesiumObjectPools::MeshPool().Release(
-        meshFilter.sharedMesh());
-  }
-
-  // The MeshCollider shares a mesh with the MeshFilter, so no need to
-  // destroy it explicitly.
+  return pCesiumGameObject;
 }
 
-} // namespace
-
 void UnityPrepareRendererResources::free(
     Cesium3DTilesSelection::Tile& tile,
     void* pLoadThreadResult,
@@ -1414,8 +1738,23 @@ void UnityPrepareRendererResources::free(
   if (pLoadThreadResult) {
     LoadThreadResult* pTyped =
         static_cast<LoadThreadResult*>(pLoadThreadResult);
+    const std::vector<CesiumPrimitiveInfo>& primitiveInfos =
+        pTyped->primitiveInfos;
     for (int32_t i = 0, len = pTyped->meshes.Length(); i < len; ++i) {
-      CesiumForUnity::CesiumObjectPools::MeshPool().Release(pTyped->meshes[i]);
+      CesiumForUnity::CesiumObjectPools::MeshPool().Release(
+          pTyped->meshes[i],
+          primitiveInfos[i].meshSizeClass,
+          MeshSizeClass::getPooledBytes(primitiveInfos[i].meshSizeClass));
+    }
+    for (size_t i = 0; i < pTyped->physicsMeshes.size(); ++i) {
+      const UnityEngine::Mesh& physicsMesh = pTyped->physicsMeshes[i];
+      if (physicsMesh != nullptr) {
+        const int32_t sizeClass = primitiveInfos[i].physicsMeshSizeClass;
+        CesiumForUnity::CesiumObjectPools::MeshPool().Release(
+            physicsMesh,
+            sizeClass,
+            MeshSizeClass::getPooledBytes(sizeClass));
+      }
     }
     delete pTyped;
   }
@@ -1427,24 +1766,46 @@ void UnityPrepareRendererResources::free(
     // It's possible that the game object has already been destroyed. In which
     // case Unity will throw a MissingReferenceException if we try to use it. So
     // don't do that.
+    this->_pResourceMemory->remove(pCesiumGameObject->resourceBytes);
+
     if (*pCesiumGameObject->pGameObject != nullptr) {
+      // The metadata component holds pointers into the glTF, which is about to
+      // be freed, so this can't be deferred.
       auto metadataComponent =
           pCesiumGameObject->pGameObject
               ->GetComponentInParent<DotNet::CesiumForUnity::CesiumMetadata>();
+      if (metadataComponent != nullptr) {
+        CesiumMetadataImpl& metadata = metadataComponent.NativeImplementation();
+        for (const CesiumPrimitiveResources& resources :
+             pCesiumGameObject->primitiveResources) {
+          if (resources.gameObject != nullptr) {
+            metadata.removeMetadata(
+                resources.gameObject.transform().GetInstanceID());
+          }
+        }
+      }
 
-      UnityEngine::Transform parentTransform =
-          pCesiumGameObject->pGameObject->transform();
-
-      // Destroying primitives will remove them from the child list, so
-      // work backwards.
-      for (int32_t i = parentTransform.childCount() - 1; i >= 0; --i) {
-        UnityEngine::GameObject primitiveGameObject =
-            parentTransform.GetChild(i).gameObject();
-        freePrimitiveGameObject(primitiveGameObject, metadataComponent);
-        UnityLifetime::Destroy(primitiveGameObject);
+      // A physics mesh bake that is still in progress reads the collider
+      // meshes until it finishes, so they mustn't go back to the mesh pool,
+      // where another tile could overwrite them, before then. The bake returns
+      // them to the pool instead.
+      if (*pCesiumGameObject->pPhysicsMeshState ==
+          CesiumPhysicsMeshState::Baking) {
+        for (CesiumPrimitiveResources& resources :
+             pCesiumGameObject->primitiveResources) {
+          if (resources.canCreateCollider && resources.mesh != nullptr) {
+            resources.forgetColliderMesh();
+          }
+        }
       }
 
-      UnityLifetime::Destroy(*pCesiumGameObject->pGameObject);
+      // Let any physics mesh bake that is still in progress know that this
+      // tile is gone.
+      pCesiumGameObject->pPhysicsMeshState.reset();
+
+      // Destroying the Unity objects is expensive, so hand them off to be
+      // destroyed over the next few frames.
+      this->_pDestructionQueue->enqueue(std::move(*pCesiumGameObject));
     }
   }
 }
@@ -1464,6 +1825,8 @@ void* UnityPrepareRendererResources::prepareRasterInMainThread(
   pTexture->wrapMode(UnityEngine::TextureWrapMode::Clamp);
   pTexture->filterMode(UnityEngine::FilterMode::Trilinear);
   pTexture->anisoLevel(16);
+  this->_pResourceMemory->add(
+      RendererResourceMemory::computeTextureBytes(rasterTile.getImage()));
   return pTexture.release();
 }
 
@@ -1474,6 +1837,8 @@ void UnityPrepareRendererResources::freeRaster(
   if (pMainThreadResult) {
     std::unique_ptr<UnityEngine::Texture> pTexture(
         static_cast<UnityEngine::Texture*>(pMainThreadResult));
+    this->_pResourceMemory->remove(
+        RendererResourceMemory::computeTextureBytes(rasterTile.getImage()));
     if (*pTexture != nullptr) {
       UnityLifetime::Destroy(*pTexture);
     }
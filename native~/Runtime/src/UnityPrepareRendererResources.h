@@ -4,9 +4,20 @@
 #include <CesiumShaderProperties.h>
 
 #include <DotNet/UnityEngine/GameObject.h>
+#include <DotNet/UnityEngine/Material.h>
+#include <DotNet/UnityEngine/Mesh.h>
+#include <DotNet/UnityEngine/MeshCollider.h>
+#include <DotNet/UnityEngine/Texture.h>
+
+#include <memory>
+#include <vector>
 
 namespace CesiumForUnityNative {
 
+class PrioritizedTaskProcessor;
+class RendererResourceMemory;
+class TileDestructionQueue;
+
 /**
  * @brief Information about how a given glTF primitive was converted into
  * Unity MeshData.
@@ -30,6 +41,36 @@ struct CesiumPrimitiveInfo {
    */
   bool isUnlit = false;
 
+  /**
+   * @brief Whether or not a simplified copy of the primitive's mesh was
+   * created for physics.
+   */
+  bool hasSimplifiedPhysicsMesh = false;
+
+  /**
+   * @brief The memory used by the primitive's mesh, and by its simplified
+   * physics mesh if it has one, in bytes.
+   */
+  int64_t meshBytes = 0;
+
+  /**
+   * @brief The memory used by the physics mesh that is baked for the
+   * primitive, in bytes, if one is baked.
+   */
+  int64_t bakedPhysicsMeshBytes = 0;
+
+  /**
+   * @brief The size class of the primitive's mesh in the mesh pool, from
+   * {@link MeshSizeClass}.
+   */
+  int32_t meshSizeClass = 0;
+
+  /**
+   * @brief The size class of the primitive's simplified physics mesh in the
+   * mesh pool, if it has one.
+   */
+  int32_t physicsMeshSizeClass = 0;
+
   /**
    * @brief Maps a texture coordinate index i (TEXCOORD_<i>) to the
    * corresponding Unity texture coordinate index.
@@ -43,6 +84,114 @@ struct CesiumPrimitiveInfo {
   std::unordered_map<uint32_t, uint32_t> rasterOverlayUvIndexMap{};
 };
 
+/**
+ * @brief The Unity objects created for a single glTF primitive and owned by
+ * it. These are tracked natively so that they can be destroyed without
+ * querying the material for its texture properties.
+ */
+struct CesiumPrimitiveResources {
+  /**
+   * @brief The game object holding the primitive's renderer components.
+   */
+  ::DotNet::UnityEngine::GameObject gameObject{nullptr};
+
+  /**
+   * @brief The mesh, which is returned to the mesh pool when freed.
+   */
+  ::DotNet::UnityEngine::Mesh mesh{nullptr};
+
+  /**
+   * @brief The material instance created for this primitive.
+   */
+  ::DotNet::UnityEngine::Material material{nullptr};
+
+  /**
+   * @brief The textures loaded from the glTF for this primitive's material.
+   * Raster overlay textures are not included because they are owned by the
+   * raster overlay tiles.
+   */
+  std::vector<::DotNet::UnityEngine::Texture> textures{};
+
+  /**
+   * @brief The simplified copy of the mesh that is used for physics instead of
+   * the mesh itself, if any. This is returned to the mesh pool when freed.
+   */
+  ::DotNet::UnityEngine::Mesh physicsMesh{nullptr};
+
+  /**
+   * @brief The size classes that the mesh and the physics mesh are returned to
+   * the mesh pool with.
+   */
+  int32_t meshSizeClass = 0;
+  int32_t physicsMeshSizeClass = 0;
+
+  /**
+   * @brief Whether a physics collider may be created for this primitive. This
+   * is false for points and degenerate triangle meshes.
+   */
+  bool canCreateCollider = false;
+
+  /**
+   * @brief The collider using the mesh, if one is currently attached.
+   */
+  ::DotNet::UnityEngine::MeshCollider collider{nullptr};
+
+  /**
+   * @brief Gets the mesh that should be baked for physics and used by the
+   * collider.
+   */
+  const ::DotNet::UnityEngine::Mesh& getColliderMesh() const noexcept {
+    return this->physicsMesh != nullptr ? this->physicsMesh : this->mesh;
+  }
+
+  /**
+   * @brief Gets the size class that the collider mesh is returned to the mesh
+   * pool with.
+   */
+  int32_t getColliderMeshSizeClass() const noexcept {
+    return this->physicsMesh != nullptr ? this->physicsMeshSizeClass
+                                        : this->meshSizeClass;
+  }
+
+  /**
+   * @brief Forgets the collider mesh, so that it isn't returned to the mesh
+   * pool when these resources are destroyed.
+   */
+  void forgetColliderMesh() noexcept {
+    if (this->physicsMesh != nullptr) {
+      this->physicsMesh = nullptr;
+    } else {
+      this->mesh = nullptr;
+    }
+  }
+};
+
+/**
+ * @brief The progress of creating physics colliders for a tile when they are
+ * only created near physics interest points.
+ */
+enum class CesiumPhysicsMeshState {
+  /**
+   * @brief The tile's physics meshes have not been baked.
+   */
+  None,
+
+  /**
+   * @brief The tile's physics meshes are being baked in a worker thread.
+   */
+  Baking,
+
+  /**
+   * @brief The tile's physics meshes are baked, but no colliders are attached.
+   */
+  Baked,
+
+  /**
+   * @brief The tile's colliders are attached.
+   */
+  Attached
+};
+
 /**
  * @brief The fully loaded game object for this glTF and associated information.
  */
@@ -57,13 +206,47 @@ struct CesiumGltfGameObject {
    * meshes.
    */
   std::vector<CesiumPrimitiveInfo> primitiveInfos{};
+
+  /**
+   * @brief The Unity objects owned by each primitive game object, in the same
+   * order as the children of the game object.
+   */
+  std::vector<CesiumPrimitiveResources> primitiveResources{};
+
+  /**
+   * @brief The state of this tile's physics colliders. This is shared with
+   * in-progress physics mesh bakes, and released when the tile is freed so
+   * that those bakes can tell the tile is gone.
+   */
+  std::shared_ptr<CesiumPhysicsMeshState> pPhysicsMeshState =
+      std::make_shared<CesiumPhysicsMeshState>(CesiumPhysicsMeshState::None);
+
+  /**
+   * @brief The memory used by the Unity objects created for this glTF, in
+   * bytes, as counted by the tileset's {@link RendererResourceMemory}.
+   */
+  int64_t resourceBytes = 0;
 };
 
 class UnityPrepareRendererResources
     : public Cesium3DTilesSelection::IPrepareRendererResources {
 public:
+  /**
+   * @brief Creates a new instance.
+   *
+   * @param tileset The game object of the tileset.
+   * @param pDestructionQueue The queue that destroys the tileset's unloaded
+   * tiles.
+   * @param pTaskProcessor The tileset's task processor, whose priority is
+   * also the priority of the main thread part of loading each tile.
+   * @param pResourceMemory Counts the memory used by the Unity objects that
+   * are created for the tileset's tiles and raster overlay tiles.
+   */
   UnityPrepareRendererResources(
-      const ::DotNet::UnityEngine::GameObject& tileset);
+      const ::DotNet::UnityEngine::GameObject& tileset,
+      const std::shared_ptr<TileDestructionQueue>& pDestructionQueue,
+      const std::shared_ptr<PrioritizedTaskProcessor>& pTaskProcessor,
+      const std::shared_ptr<RendererResourceMemory>& pResourceMemory);
 
   virtual CesiumAsync::Future<
       Cesium3DTilesSelection::TileLoadResultAndRenderResources>
@@ -112,6 +295,9 @@ public:
 private:
   ::DotNet::UnityEngine::GameObject _tileset;
   CesiumShaderProperties _shaderProperty;
+  std::shared_ptr<TileDestructionQueue> _pDestructionQueue;
+  std::shared_ptr<PrioritizedTaskProcessor> _pTaskProcessor;
+  std::shared_ptr<RendererResourceMemory> _pResourceMemory;
 };
 
 } // namespace CesiumForUnityNative
@@ -1,19 +1,33 @@
 #include "UnityTilesetExternals.h"
 
+#include "CacheModeAssetAccessor.h"
+#include "CompressingCacheDatabase.h"
+#include "FileCacheDatabase.h"
+#include "HttpAssetAccessor.h"
+#include "InflatingAssetAccessor.h"
+#include "MemoryCacheAssetAccessor.h"
+#include "RecordingAssetAccessor.h"
+#include "ReplayAssetAccessor.h"
+#include "RequestGroupAssetAccessor.h"
 #include "UnityAssetAccessor.h"
 #include "UnityPrepareRendererResources.h"
 #include "UnityTaskProcessor.h"
+#include "WorkStealingTaskProcessor.h"
+#include "WriteBehindCacheDatabase.h"
 
 #include <Cesium3DTilesSelection/CreditSystem.h>
 #include <CesiumAsync/CachingAssetAccessor.h>
-#include <CesiumAsync/GunzipAssetAccessor.h>
 #include <CesiumAsync/SqliteCache.h>
 
+#include <DotNet/CesiumForUnity/CesiumCacheBackend.h>
+#include <DotNet/CesiumForUnity/CesiumCacheMode.h>
 #include <DotNet/CesiumForUnity/CesiumCreditSystem.h>
+#include <DotNet/CesiumForUnity/CesiumRequestArchiveMode.h>
 #include <DotNet/CesiumForUnity/CesiumRuntimeSettings.h>
 #include <DotNet/System/String.h>
 #include <DotNet/UnityEngine/Application.h>
 
+#include <algorithm>
 #include <memory>
 
 using namespace Cesium3DTilesSelection;
@@ -24,36 +38,168 @@ namespace CesiumForUnityNative {
 
 namespace {
 
-std::shared_ptr<GunzipAssetAccessor> pAccessor = nullptr;
-std::shared_ptr<UnityTaskProcessor> pTaskProcessor = nullptr;
+std::shared_ptr<InflatingAssetAccessor> pAccessor = nullptr;
+std::shared_ptr<CacheModeAssetAccessor> pCacheModeAccessor = nullptr;
+std::shared_ptr<CoalescingAssetAccessor> pCoalescingAccessor = nullptr;
+std::shared_ptr<MemoryCacheAssetAccessor> pMemoryCacheAccessor = nullptr;
+std::shared_ptr<CompressingCacheDatabase> pCompressingDatabase = nullptr;
+std::shared_ptr<WriteBehindCacheDatabase> pWriteBehindDatabase = nullptr;
+std::shared_ptr<FileCacheDatabase> pFileCacheDatabase = nullptr;
+std::shared_ptr<HttpAssetAccessor> pHttpAccessor = nullptr;
+std::shared_ptr<ReplayAssetAccessor> pReplayAccessor = nullptr;
+std::shared_ptr<ITaskProcessor> pTaskProcessor = nullptr;
+std::shared_ptr<WorkStealingTaskProcessor> pWorkStealingTaskProcessor =
+    nullptr;
 std::shared_ptr<CreditSystem> pCreditSystem = nullptr;
 
-const std::shared_ptr<GunzipAssetAccessor>& getAssetAccessor() {
-  if (!pAccessor) {
-    std::string tempPath =
-        UnityEngine::Application::temporaryCachePath().ToStlString();
-    std::string cacheDBPath = tempPath + "/cesium-request-cache.sqlite";
+std::string getRequestArchivePath() {
+  std::string path =
+      CesiumForUnity::CesiumRuntimeSettings::requestArchivePath().ToStlString();
+  if (!path.empty()) {
+    return path;
+  }
+  return UnityEngine::Application::temporaryCachePath().ToStlString() +
+         "/cesium-request-archive.bin";
+}
+
+std::shared_ptr<IAssetAccessor> createNetworkAssetAccessor() {
+  if (CesiumForUnity::CesiumRuntimeSettings::requestArchiveMode() ==
+      CesiumForUnity::CesiumRequestArchiveMode::Replay) {
+    int32_t latency =
+        CesiumForUnity::CesiumRuntimeSettings::replayLatencyMilliseconds();
+    int64_t bytesPerSecond =
+        CesiumForUnity::CesiumRuntimeSettings::replayBytesPerSecond();
+    pReplayAccessor = std::make_shared<ReplayAssetAccessor>(
+        spdlog::default_logger(),
+        getRequestArchivePath(),
+        std::chrono::milliseconds(std::max(latency, int32_t(0))),
+        uint64_t(std::max(bytesPerSecond, int64_t(0))));
+    return pReplayAccessor;
+  }
+
+  auto pUnityAccessor = std::make_shared<UnityAssetAccessor>();
+  if (!CesiumForUnity::CesiumRuntimeSettings::useNativeHttpClient()) {
+    return pUnityAccessor;
+  }
+
+  pHttpAccessor = std::make_shared<HttpAssetAccessor>(
+      pUnityAccessor,
+      pUnityAccessor->getCesiumRequestHeaders(),
+      CesiumForUnity::CesiumRuntimeSettings::maximumConnectionsPerHost());
+  return pHttpAccessor;
+}
 
+std::shared_ptr<ICacheDatabase> createCacheDatabase() {
+  std::string tempPath =
+      UnityEngine::Application::temporaryCachePath().ToStlString();
+
+  // Replays use an empty cache of their own, so that every run makes the same
+  // requests, without disturbing the normal cache.
+  bool replaying =
+      CesiumForUnity::CesiumRuntimeSettings::requestArchiveMode() ==
+      CesiumForUnity::CesiumRequestArchiveMode::Replay;
+  std::string cacheName =
+      replaying ? "/cesium-replay-cache" : "/cesium-request-cache";
+
+  std::shared_ptr<ICacheDatabase> pDatabase;
+  if (CesiumForUnity::CesiumRuntimeSettings::cacheBackend() ==
+      CesiumForUnity::CesiumCacheBackend::Files) {
+    int64_t maximumBytes =
+        CesiumForUnity::CesiumRuntimeSettings::fileCacheMaximumBytes();
+    pFileCacheDatabase = std::make_shared<FileCacheDatabase>(
+        spdlog::default_logger(),
+        tempPath + cacheName,
+        uint64_t(std::max(maximumBytes, int64_t(0))));
+    pDatabase = pFileCacheDatabase;
+  } else {
+    std::string cacheDBPath = tempPath + cacheName + ".sqlite";
+    uint64_t maxItems = CesiumForUnity::CesiumRuntimeSettings::maxItems();
+    pDatabase = std::make_shared<SqliteCache>(
+        spdlog::default_logger(),
+        cacheDBPath,
+        maxItems);
+  }
+
+  if (replaying) {
+    pDatabase->clearAll();
+  }
+
+  if (CesiumForUnity::CesiumRuntimeSettings::compressCacheEntries()) {
+    pCompressingDatabase =
+        std::make_shared<CompressingCacheDatabase>(pDatabase);
+    pDatabase = pCompressingDatabase;
+  }
+
+  // Keep writes, compression, and pruning off of the request path.
+  pWriteBehindDatabase = std::make_shared<WriteBehindCacheDatabase>(pDatabase);
+  return pWriteBehindDatabase;
+}
+
+CacheMode getInitialCacheMode() {
+  switch (CesiumForUnity::CesiumRuntimeSettings::cacheMode()) {
+  case CesiumForUnity::CesiumCacheMode::StaleWhileRevalidate:
+    return CacheMode::StaleWhileRevalidate;
+  case CesiumForUnity::CesiumCacheMode::CacheOnly:
+    return CacheMode::CacheOnly;
+  case CesiumForUnity::CesiumCacheMode::NetworkFirst:
+  default:
+    return CacheMode::NetworkFirst;
+  }
+}
+
+const std::shared_ptr<InflatingAssetAccessor>& getAssetAccessor() {
+  if (!pAccessor) {
     int32_t requestsPerCachePrune =
         CesiumForUnity::CesiumRuntimeSettings::requestsPerCachePrune();
-    uint64_t maxItems = CesiumForUnity::CesiumRuntimeSettings::maxItems();
 
-    pAccessor = std::make_shared<GunzipAssetAccessor>(
+    std::shared_ptr<ICacheDatabase> pCacheDatabase = createCacheDatabase();
+    pCacheModeAccessor = std::make_shared<CacheModeAssetAccessor>(
         std::make_shared<CachingAssetAccessor>(
             spdlog::default_logger(),
-            std::make_shared<UnityAssetAccessor>(),
-            std::make_shared<SqliteCache>(
-                spdlog::default_logger(),
-                cacheDBPath,
-                maxItems),
-            requestsPerCachePrune));
+            createNetworkAssetAccessor(),
+            pCacheDatabase,
+            requestsPerCachePrune),
+        pCacheDatabase,
+        getInitialCacheMode());
+
+    // Share identical requests before the cache, so that they're written to
+    // it only once.
+    pCoalescingAccessor =
+        std::make_shared<CoalescingAssetAccessor>(pCacheModeAccessor);
+    int64_t memoryCacheBytes =
+        CesiumForUnity::CesiumRuntimeSettings::memoryCacheMaximumBytes();
+    pMemoryCacheAccessor = std::make_shared<MemoryCacheAssetAccessor>(
+        pCoalescingAccessor,
+        uint64_t(std::max(memoryCacheBytes, int64_t(0))));
+
+    std::shared_ptr<IAssetAccessor> pRecordedAccessor = pMemoryCacheAccessor;
+    if (CesiumForUnity::CesiumRuntimeSettings::requestArchiveMode() ==
+        CesiumForUnity::CesiumRequestArchiveMode::Record) {
+      // Record what the tilesets receive, whether it came from the network or
+      // a cache, so that the archive is complete whatever was cached.
+      pRecordedAccessor = std::make_shared<RecordingAssetAccessor>(
+          pMemoryCacheAccessor,
+          spdlog::default_logger(),
+          getRequestArchivePath());
+    }
+
+    pAccessor = std::make_shared<InflatingAssetAccessor>(pRecordedAccessor);
   }
   return pAccessor;
 }
 
-const std::shared_ptr<UnityTaskProcessor>& getTaskProcessor() {
+const std::shared_ptr<ITaskProcessor>& getTaskProcessor() {
   if (!pTaskProcessor) {
-    pTaskProcessor = std::make_shared<UnityTaskProcessor>();
+    if (CesiumForUnity::CesiumRuntimeSettings::useNativeTaskProcessor()) {
+      int32_t threadCount =
+          CesiumForUnity::CesiumRuntimeSettings::workerThreadCount();
+      pWorkStealingTaskProcessor = std::make_shared<WorkStealingTaskProcessor>(
+          uint32_t(std::max(threadCount, int32_t(0))),
+          CesiumForUnity::CesiumRuntimeSettings::pinWorkerThreads());
+      pTaskProcessor = pWorkStealingTaskProcessor;
+    } else {
+      pTaskProcessor = std::make_shared<UnityTaskProcessor>();
+    }
   }
   return pTaskProcessor;
 }
@@ -84,11 +230,130 @@ getCreditSystem(const CesiumForUnity::Cesium3DTileset& tileset) {
 Cesium3DTilesSelection::TilesetExternals
 createTilesetExternals(const CesiumForUnity::Cesium3DTileset& tileset) {
   return TilesetExternals{
-      getAssetAccessor(),
-      std::make_shared<UnityPrepareRendererResources>(tileset.gameObject()),
-      AsyncSystem(getTaskProcessor()),
+      std::make_shared<RequestGroupAssetAccessor>(
+          getAssetAccessor(),
+          tileset.NativeImplementation().getRequestGroup()),
+      std::make_shared<UnityPrepareRendererResources>(
+          tileset.gameObject(),
+          tileset.NativeImplementation().getDestructionQueue(),
+          tileset.NativeImplementation().getTaskProcessor(),
+          tileset.NativeImplementation().getResourceMemory()),
+      AsyncSystem(tileset.NativeImplementation().getTaskProcessor()),
       getCreditSystem(tileset),
       spdlog::default_logger()};
 }
 
+std::shared_ptr<PrioritizedTaskProcessor>
+createTaskProcessor(TaskPriority priority) {
+  return std::make_shared<PrioritizedTaskProcessor>(
+      getTaskProcessor(),
+      priority);
+}
+
+TilesetExternals createStandaloneTilesetExternals(
+    const std::shared_ptr<IPrepareRendererResources>& pPrepareRendererResources,
+    uint64_t requestGroup,
+    TaskPriority priority) {
+  return TilesetExternals{
+      std::make_shared<RequestGroupAssetAccessor>(
+          getAssetAccessor(),
+          requestGroup),
+      pPrepareRendererResources,
+      AsyncSystem(createTaskProcessor(priority)),
+      std::make_shared<CreditSystem>(),
+      spdlog::default_logger()};
+}
+
+CacheMode getCacheMode() {
+  getAssetAccessor();
+  return pCacheModeAccessor->getMode();
+}
+
+void setCacheMode(CacheMode mode) {
+  getAssetAccessor();
+  pCacheModeAccessor->setMode(mode);
+}
+
+CoalescingAssetAccessor::Statistics getRequestCoalescingStatistics() {
+  if (!pCoalescingAccessor) {
+    return CoalescingAssetAccessor::Statistics{0, 0};
+  }
+  return pCoalescingAccessor->getStatistics();
+}
+
+MemoryCacheAssetAccessor::Statistics getMemoryCacheStatistics() {
+  if (!pMemoryCacheAccessor) {
+    return MemoryCacheAssetAccessor::Statistics{0, 0, 0};
+  }
+  return pMemoryCacheAccessor->getStatistics();
+}
+
+CompressingCacheDatabase::Statistics getCacheCompressionStatistics() {
+  if (!pCompressingDatabase) {
+    return CompressingCacheDatabase::Statistics{0, 0, 0, 0.0};
+  }
+  return pCompressingDatabase->getStatistics();
+}
+
+InflatingAssetAccessor::Statistics getGzipInflateStatistics() {
+  if (!pAccessor) {
+    return InflatingAssetAccessor::Statistics{0, 0, 0, 0.0};
+  }
+  return pAccessor->getStatistics();
+}
+
+void shutdownTilesetExternals() {
+  // Stop the downloads first, so that no more responses arrive to be cached.
+  // Their continuations are run by the task processor, which runs everything
+  // that's still queued before its threads stop, and then the cache finishes
+  // writing what it was given.
+  if (pHttpAccessor) {
+    pHttpAccessor->shutdown();
+  }
+  if (pReplayAccessor) {
+    pReplayAccessor->shutdown();
+  }
+  if (pWorkStealingTaskProcessor) {
+    pWorkStealingTaskProcessor->shutdown();
+  }
+  if (pWriteBehindDatabase) {
+    pWriteBehindDatabase->shutdown();
+  }
+  if (pFileCacheDatabase) {
+    pFileCacheDatabase->shutdown();
+  }
+
+  // Tilesets that are still alive keep what they were given, which works
+  // without the threads. Anything created from now on gets new externals.
+  pAccessor = nullptr;
+  pCacheModeAccessor = nullptr;
+  pCoalescingAccessor = nullptr;
+  pMemoryCacheAccessor = nullptr;
+  pCompressingDatabase = nullptr;
+  pWriteBehindDatabase = nullptr;
+  pFileCacheDatabase = nullptr;
+  pHttpAccessor = nullptr;
+  pReplayAccessor = nullptr;
+  pTaskProcessor = nullptr;
+  pWorkStealingTaskProcessor = nullptr;
+}
+
+std::vector<WorkStealingTaskProcessor::QueueStatistics>
+getTaskProcessorStatistics() {
+  if (!pWorkStealingTaskProcessor) {
+    return std::vector<WorkStealingTaskProcessor::QueueStatistics>();
+  }
+  return pWorkStealingTaskProcessor->getStatistics();
+}
+
+std::array<WorkStealingTaskProcessor::PriorityStatistics, taskPriorityCount>
+getTaskPriorityStatistics() {
+  if (!pWorkStealingTaskProcessor) {
+    return std::array<
+        WorkStealingTaskProcessor::PriorityStatistics,
+        taskPriorityCount>();
+  }
+  return pWorkStealingTaskProcessor->getPriorityStatistics();
+}
+
 } // namespace CesiumForUnityNative
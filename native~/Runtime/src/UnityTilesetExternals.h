@@ -1,12 +1,21 @@
 #pragma once
 
+#include "CacheModeAssetAccessor.h"
+#include "CoalescingAssetAccessor.h"
+#include "CompressingCacheDatabase.h"
+#include "InflatingAssetAccessor.h"
+#include "MemoryCacheAssetAccessor.h"
+#include "TaskPriority.h"
+#include "WorkStealingTaskProcessor.h"
+
 #include <Cesium3DTilesSelection/TilesetExternals.h>
 
 #include <DotNet/CesiumForUnity/Cesium3DTileset.h>
 
 namespace Cesium3DTilesSelection {
+class IPrepareRendererResources;
 class TilesetExternals;
-}
+} // namespace Cesium3DTilesSelection
 
 namespace DotNet::CesiumForUnity {
 class Cesium3DTileset;
@@ -17,4 +26,93 @@ namespace CesiumForUnityNative {
 Cesium3DTilesSelection::TilesetExternals
 createTilesetExternals(const DotNet::CesiumForUnity::Cesium3DTileset& tileset);
 
+/**
+ * @brief Creates a task processor for a single tileset, which runs its tasks
+ * on the worker threads shared by all tilesets with a priority of its own.
+ *
+ * @param priority The priority to start with.
+ */
+std::shared_ptr<PrioritizedTaskProcessor>
+createTaskProcessor(TaskPriority priority);
+
+/**
+ * @brief Creates the externals for a tileset that has no component, such as
+ * one that only downloads tiles into the cache. Its requests go through the
+ * same accessors and cache as every other tileset's, and its credits aren't
+ * shown.
+ *
+ * @param pPrepareRendererResources Prepares the tileset's tiles for rendering.
+ * @param requestGroup The group of the tileset's requests, from
+ * {@link AssetRequestCancellation::createGroup}.
+ * @param priority The priority of the tileset's worker thread tasks.
+ */
+Cesium3DTilesSelection::TilesetExternals createStandaloneTilesetExternals(
+    const std::shared_ptr<Cesium3DTilesSelection::IPrepareRendererResources>&
+        pPrepareRendererResources,
+    uint64_t requestGroup,
+    TaskPriority priority);
+
+/**
+ * @brief Gets how all tilesets' requests currently use the disk cache and the
+ * network.
+ */
+CacheMode getCacheMode();
+
+/**
+ * @brief Sets how all tilesets' requests use the disk cache and the network,
+ * starting with the next request.
+ */
+void setCacheMode(CacheMode mode);
+
+/**
+ * @brief Gets how many of the GET requests made by all tilesets so far were
+ * shared with an identical request that was already in progress.
+ */
+CoalescingAssetAccessor::Statistics getRequestCoalescingStatistics();
+
+/**
+ * @brief Gets how many of the GET requests made by all tilesets so far were
+ * served from the in-memory response cache.
+ */
+MemoryCacheAssetAccessor::Statistics getMemoryCacheStatistics();
+
+/**
+ * @brief Gets how much the disk cache's entries have been compressed so far,
+ * and how long it took to inflate them again.
+ */
+CompressingCacheDatabase::Statistics getCacheCompressionStatistics();
+
+/**
+ * @brief Gets how much gzipped response data has been inflated so far, and how
+ * long it took.
+ */
+InflatingAssetAccessor::Statistics getGzipInflateStatistics();
+
+/**
+ * @brief Stops the native threads shared by all tilesets: those of the native
+ * HTTP client, the replayed network, the native task processor, and the disk
+ * cache. The work that they already have is finished first, except for
+ * downloads, which are abandoned.
+ *
+ * This must be called before the .NET domain is unloaded, because those
+ * threads call into it. Tilesets that already exist keep working, without
+ * the threads, and tilesets created afterwards start new ones.
+ */
+void shutdownTilesetExternals();
+
+/**
+ * @brief Gets the statistics of each queue of the native task processor, or an
+ * empty vector if tasks are run on the .NET thread pool instead.
+ */
+std::vector<WorkStealingTaskProcessor::QueueStatistics>
+getTaskProcessorStatistics();
+
+/**
+ * @brief Gets the statistics of each priority class of the native task
+ * processor, which are all zero if tasks are run on the .NET thread pool
+ * instead.
+ */
+std::array<WorkStealingTaskProcessor::PriorityStatistics, taskPriorityCount>
+getTaskPriorityStatistics();
+
 }
@@ -0,0 +1,310 @@
+#include "WriteBehindCacheDatabase.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <iterator>
+#include <optional>
+
+using namespace CesiumAsync;
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Entries are dropped, rather than queued, while more than this many bytes are
+// waiting to be written, so that a slow database can't use unbounded memory.
+const uint64_t maximumPendingBytes = 64 * 1024 * 1024;
+
+// How long the cache must go unused before a prune is started.
+const Clock::duration idleDelay = std::chrono::seconds(1);
+
+// How long a prune may be put off waiting for the cache to become idle.
+const Clock::duration maximumPruneDelay = std::chrono::seconds(30);
+
+// How often to prune while entries are being written, even if the caching
+// accessor hasn't asked for it.
+const Clock::duration periodicPruneInterval = std::chrono::seconds(60);
+
+} // namespace
+
+WriteBehindCacheDatabase::WriteBehindCacheDatabase(
+    const std::shared_ptr<ICacheDatabase>& pDatabase)
+    : _pDatabase(pDatabase),
+      _mutex(),
+      _workAvailable(),
+      _queue(),
+      _pendingEntries(),
+      _pendingBytes(0),
+      _pruneRequested(false),
+      _writesSincePrune(0),
+      _lastPrune(Clock::now()),
+      _stopping(false),
+      _writing(false),
+      _clearing(false),
+      _writeFinished(),
+      _lastActivity(Clock::now().time_since_epoch().count()),
+      _writeThread() {
+  this->_writeThread = std::thread([this]() { this->processWrites(); });
+}
+
+WriteBehindCacheDatabase::~WriteBehindCacheDatabase() noexcept {
+  this->shutdown();
+}
+
+void WriteBehindCacheDatabase::shutdown() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_stopping) {
+      return;
+    }
+    this->_stopping = true;
+  }
+
+  // Let the write thread finish the writes that are already queued.
+  this->_workAvailable.notify_all();
+  this->_writeThread.join();
+}
+
+std::optional<CacheItem>
+WriteBehindCacheDatabase::getEntry(const std::string& key) const {
+  this->recordActivity();
+
+  std::shared_ptr<const PendingEntry> pEntry;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_pendingEntries.find(key);
+    if (it != this->_pendingEntries.end()) {
+      pEntry = it->second;
+    }
+  }
+
+  if (!pEntry) {
+    return this->_pDatabase->getEntry(key);
+  }
+
+  // The entry hasn't been written yet, so serve it from the queue.
+  return CacheItem{
+      pEntry->expiryTime,
+      CacheRequest{
+          HttpHeaders(pEntry->requestHeaders),
+          std::string(pEntry->requestMethod),
+          std::string(pEntry->url)},
+      CacheResponse{
+          pEntry->statusCode,
+          HttpHeaders(pEntry->responseHeaders),
+          std::vector<std::byte>(pEntry->responseData)}};
+}
+
+bool WriteBehindCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  CESIUM_TRACE("WriteBehindCacheDatabase::storeEntry");
+
+  this->recordActivity();
+
+  uint64_t size = uint64_t(responseData.size());
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_pendingBytes + size > maximumPendingBytes) {
+      return false;
+    }
+  }
+
+  auto pEntry = std::make_shared<const PendingEntry>(PendingEntry{
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      std::vector<std::byte>(responseData.begin(), responseData.end())});
+
+  bool queued = false;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (!this->_stopping) {
+      auto it = this->_pendingEntries.find(key);
+      if (it != this->_pendingEntries.end()) {
+        this->_pendingBytes -= uint64_t(it->second->responseData.size());
+        it->second = pEntry;
+      } else {
+        this->_pendingEntries.emplace(key, pEntry);
+      }
+
+      this->_pendingBytes += size;
+      this->_queue.emplace_back(std::move(pEntry));
+      queued = true;
+    }
+  }
+
+  if (!queued) {
+    // The write thread has been shut down, so write the entry here.
+    return this->_pDatabase->storeEntry(
+        key,
+        expiryTime,
+        url,
+        requestMethod,
+        requestHeaders,
+        statusCode,
+        responseHeaders,
+        responseData);
+  }
+
+  this->_workAvailable.notify_one();
+  return true;
+}
+
+bool WriteBehindCacheDatabase::prune() {
+  bool stopping;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    stopping = this->_stopping;
+    if (!stopping) {
+      this->_pruneRequested = true;
+    }
+  }
+
+  if (stopping) {
+    return this->_pDatabase->prune();
+  }
+
+  this->_workAvailable.notify_one();
+  return true;
+}
+
+bool WriteBehindCacheDatabase::clearAll() {
+  {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_queue.clear();
+    this->_pendingEntries.clear();
+    this->_pendingBytes = 0;
+
+    // A batch that the write thread has already taken from the queue would
+    // otherwise be written after the database is cleared.
+    this->_writeFinished.wait(lock, [this]() {
+      return !this->_writing && !this->_clearing;
+    });
+    this->_clearing = true;
+  }
+
+  bool result = this->_pDatabase->clearAll();
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_clearing = false;
+  }
+  this->_writeFinished.notify_all();
+  this->_workAvailable.notify_one();
+
+  return result;
+}
+
+void WriteBehindCacheDatabase::recordActivity() const noexcept {
+  this->_lastActivity = Clock::now().time_since_epoch().count();
+}
+
+void WriteBehindCacheDatabase::processWrites() {
+  std::unique_lock<std::mutex> lock(this->_mutex);
+
+  std::optional<Clock::time_point> pruneDueSince;
+
+  while (true) {
+    if (this->_clearing) {
+      this->_workAvailable.wait(lock);
+      continue;
+    }
+
+    if (!this->_queue.empty()) {
+      // Write everything that has been queued so far as one batch.
+      std::vector<std::shared_ptr<const PendingEntry>> batch(
+          std::make_move_iterator(this->_queue.begin()),
+          std::make_move_iterator(this->_queue.end()));
+      this->_queue.clear();
+      this->_writing = true;
+
+      lock.unlock();
+      {
+        CESIUM_TRACE("WriteBehindCacheDatabase::writeBatch");
+        for (const std::shared_ptr<const PendingEntry>& pEntry : batch) {
+          this->_pDatabase->storeEntry(
+              pEntry->key,
+              pEntry->expiryTime,
+              pEntry->url,
+              pEntry->requestMethod,
+              pEntry->requestHeaders,
+              pEntry->statusCode,
+              pEntry->responseHeaders,
+              pEntry->responseData);
+        }
+      }
+      lock.lock();
+      this->_writing = false;
+      this->_writeFinished.notify_all();
+
+      for (const std::shared_ptr<const PendingEntry>& pEntry : batch) {
+        // A newer version of the entry may have been queued in the meantime.
+        auto it = this->_pendingEntries.find(pEntry->key);
+        if (it != this->_pendingEntries.end() && it->second == pEntry) {
+          this->_pendingBytes -= uint64_t(pEntry->responseData.size());
+          this->_pendingEntries.erase(it);
+        }
+      }
+
+      this->_writesSincePrune += batch.size();
+      continue;
+    }
+
+    if (this->_stopping) {
+      return;
+    }
+
+    Clock::time_point now = Clock::now();
+    bool pruneDue = this->_pruneRequested ||
+                    (this->_writesSincePrune > 0 &&
+                     now - this->_lastPrune >= periodicPruneInterval);
+    if (!pruneDue) {
+      pruneDueSince.reset();
+      this->_workAvailable.wait_for(lock, periodicPruneInterval);
+      continue;
+    }
+
+    if (!pruneDueSince) {
+      pruneDueSince = now;
+    }
+
+    Clock::time_point lastActivity =
+        Clock::time_point(Clock::duration(this->_lastActivity.load()));
+    Clock::duration idleFor = now - lastActivity;
+    if (idleFor < idleDelay && now - *pruneDueSince < maximumPruneDelay) {
+      this->_workAvailable.wait_for(lock, idleDelay - idleFor);
+      continue;
+    }
+
+    this->_pruneRequested = false;
+    this->_writesSincePrune = 0;
+    this->_lastPrune = now;
+    pruneDueSince.reset();
+    this->_writing = true;
+
+    lock.unlock();
+    {
+      CESIUM_TRACE("WriteBehindCacheDatabase::prune");
+      this->_pDatabase->prune();
+    }
+    lock.lock();
+    this->_writing = false;
+    this->_writeFinished.notify_all();
+  }
+}
+
+} // namespace CesiumForUnityNative
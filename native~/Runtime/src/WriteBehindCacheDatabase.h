@@ -0,0 +1,109 @@
+#pragma once
+
+#include <CesiumAsync/ICacheDatabase.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A cache database that takes writes and pruning off of the request
+ * path by handing them to a background thread.
+ *
+ * Stored entries are queued and written to the underlying database in batches,
+ * and are served from the queue until they have been written. Pruning, which
+ * {@link CesiumAsync::CachingAssetAccessor} would otherwise do in the middle of
+ * a request, only happens once the cache has been idle for a while. It also
+ * happens periodically while entries are being written, so that a database
+ * with a byte budget doesn't grow far past it between the accessor's prunes.
+ */
+class WriteBehindCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  /**
+   * @brief Creates a new database.
+   *
+   * @param pDatabase The database to write to and prune.
+   */
+  WriteBehindCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase);
+  virtual ~WriteBehindCacheDatabase() noexcept;
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+  /**
+   * @brief Writes the entries that are still queued and stops the background
+   * thread.
+   *
+   * Entries stored afterwards are written, and pruning is done, on the thread
+   * that asks for it. This is called by the destructor, and may be called
+   * earlier so that the thread is gone before the native code is unloaded or
+   * the .NET domain is reloaded.
+   */
+  void shutdown() noexcept;
+
+private:
+  struct PendingEntry {
+    std::string key;
+    std::time_t expiryTime;
+    std::string url;
+    std::string requestMethod;
+    CesiumAsync::HttpHeaders requestHeaders;
+    uint16_t statusCode;
+    CesiumAsync::HttpHeaders responseHeaders;
+    std::vector<std::byte> responseData;
+  };
+
+  void recordActivity() const noexcept;
+  void processWrites();
+
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pDatabase;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _workAvailable;
+  std::deque<std::shared_ptr<const PendingEntry>> _queue;
+  std::unordered_map<std::string, std::shared_ptr<const PendingEntry>>
+      _pendingEntries;
+  uint64_t _pendingBytes;
+  bool _pruneRequested;
+  uint64_t _writesSincePrune;
+  std::chrono::steady_clock::time_point _lastPrune;
+  bool _stopping;
+
+  // Whether the write thread is writing a batch or pruning without holding
+  // the mutex, and whether clearAll is waiting for it to finish or clearing
+  // the database, which the write thread mustn't touch in the meantime.
+  bool _writing;
+  bool _clearing;
+  std::condition_variable _writeFinished;
+
+  mutable std::atomic<std::chrono::steady_clock::rep> _lastActivity;
+
+  std::thread _writeThread;
+};
+
+} // namespace CesiumForUnityNative
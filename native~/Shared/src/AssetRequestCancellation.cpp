@@ -0,0 +1,120 @@
+#include "AssetRequestCancellation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+std::mutex cancellationMutex;
+uint64_t nextGroup = 1;
+std::unordered_set<uint64_t> activeGroups;
+int32_t nextListenerID = 1;
+std::vector<std::pair<int32_t, AssetRequestCancellation::Listener>> listeners;
+
+std::atomic<uint64_t> cancelledRequests{0};
+std::atomic<uint64_t> wastedBytes{0};
+
+} // namespace
+
+const char* const AssetRequestCancellation::groupHeader =
+    "X-Cesium-Unity-Request-Group";
+
+uint64_t AssetRequestCancellation::createGroup() {
+  std::lock_guard<std::mutex> lock(cancellationMutex);
+  uint64_t group = nextGroup++;
+  activeGroups.insert(group);
+  return group;
+}
+
+void AssetRequestCancellation::cancelGroup(uint64_t group) {
+  std::vector<Listener> listenersToNotify;
+
+  {
+    std::lock_guard<std::mutex> lock(cancellationMutex);
+    if (activeGroups.erase(group) == 0) {
+      return;
+    }
+
+    // Call the listeners without the lock held, so that they're free to check
+    // whether other groups are cancelled.
+    listenersToNotify.reserve(listeners.size());
+    for (const auto& listener : listeners) {
+      listenersToNotify.emplace_back(listener.second);
+    }
+  }
+
+  for (const Listener& listener : listenersToNotify) {
+    listener(group);
+  }
+}
+
+void AssetRequestCancellation::releaseGroup(uint64_t group) {
+  std::lock_guard<std::mutex> lock(cancellationMutex);
+  activeGroups.erase(group);
+}
+
+bool AssetRequestCancellation::isCancelled(uint64_t group) {
+  if (group == 0) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(cancellationMutex);
+  return activeGroups.find(group) == activeGroups.end();
+}
+
+uint64_t
+AssetRequestCancellation::takeGroup(CesiumAsync::HttpHeaders& headers) {
+  auto it = headers.find(groupHeader);
+  if (it == headers.end()) {
+    return 0;
+  }
+
+  uint64_t group = 0;
+  try {
+    group = std::stoull(it->second);
+  } catch (...) {
+  }
+
+  headers.erase(it);
+  return group;
+}
+
+int32_t AssetRequestCancellation::addListener(Listener&& listener) {
+  std::lock_guard<std::mutex> lock(cancellationMutex);
+  int32_t listenerID = nextListenerID++;
+  listeners.emplace_back(listenerID, std::move(listener));
+  return listenerID;
+}
+
+void AssetRequestCancellation::removeListener(int32_t listenerID) {
+  std::lock_guard<std::mutex> lock(cancellationMutex);
+  auto it = std::find_if(
+      listeners.begin(),
+      listeners.end(),
+      [listenerID](const auto& listener) {
+        return listener.first == listenerID;
+      });
+  if (it != listeners.end()) {
+    listeners.erase(it);
+  }
+}
+
+void AssetRequestCancellation::recordCancelledRequest(
+    uint64_t bytes) noexcept {
+  ++cancelledRequests;
+  wastedBytes += bytes;
+}
+
+AssetRequestCancellation::Statistics
+AssetRequestCancellation::getStatistics() noexcept {
+  return Statistics{cancelledRequests.load(), wastedBytes.load()};
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <CesiumAsync/HttpHeaders.h>
+
+#include <cstdint>
+#include <functional>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief Tracks groups of asset requests, such as all of the requests made for
+ * one tileset, that can be cancelled together.
+ *
+ * A request is put in a group by adding the group header to it. The network
+ * asset accessors remove the header before the request is sent, and abort the
+ * requests in a group when it is cancelled. Requests that are made for a group
+ * after it is cancelled fail immediately.
+ */
+class AssetRequestCancellation {
+public:
+  /**
+   * @brief The name of the header that identifies a request's group.
+   */
+  static const char* const groupHeader;
+
+  /**
+   * @brief Called with the group being cancelled.
+   */
+  using Listener = std::function<void(uint64_t group)>;
+
+  struct Statistics {
+    /**
+     * @brief The number of requests that were cancelled.
+     */
+    uint64_t cancelledRequests;
+
+    /**
+     * @brief The number of bytes that cancelled requests had already
+     * downloaded, and that were thrown away.
+     */
+    uint64_t wastedBytes;
+  };
+
+  /**
+   * @brief Creates a new group. Group IDs are never reused, and are never
+   * zero.
+   */
+  static uint64_t createGroup();
+
+  /**
+   * @brief Cancels the requests in a group and notifies the listeners. This
+   * must be called from the main thread, because Unity's requests can only be
+   * aborted from there.
+   */
+  static void cancelGroup(uint64_t group);
+
+  /**
+   * @brief Forgets a group whose requests have all finished, without
+   * cancelling anything.
+   */
+  static void releaseGroup(uint64_t group);
+
+  /**
+   * @brief Determines if a group has been cancelled. Requests that aren't in a
+   * group, which have a group ID of zero, are never cancelled.
+   */
+  static bool isCancelled(uint64_t group);
+
+  /**
+   * @brief Removes the group header from a request's headers, and returns the
+   * group ID in it, or zero if it doesn't have one.
+   */
+  static uint64_t takeGroup(CesiumAsync::HttpHeaders& headers);
+
+  /**
+   * @brief Adds a listener that aborts the requests of cancelled groups.
+   *
+   * @return An ID to pass to {@link removeListener}.
+   */
+  static int32_t addListener(Listener&& listener);
+
+  /**
+   * @brief Removes a listener added with {@link addListener}.
+   */
+  static void removeListener(int32_t listenerID);
+
+  /**
+   * @brief Records that a request was cancelled after it had downloaded
+   * `wastedBytes` bytes.
+   */
+  static void recordCancelledRequest(uint64_t wastedBytes) noexcept;
+
+  /**
+   * @brief Gets the totals of the cancelled requests so far.
+   */
+  static Statistics getStatistics() noexcept;
+};
+
+} // namespace CesiumForUnityNative
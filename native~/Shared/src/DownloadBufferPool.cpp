@@ -0,0 +1,85 @@
+#include "DownloadBufferPool.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The most memory the pool may hold on to between downloads.
+const size_t maximumPooledBytes = 64 * 1024 * 1024;
+
+// The most buffers the pool may hold on to between downloads.
+const size_t maximumPooledBuffers = 32;
+
+std::mutex poolMutex;
+std::vector<std::vector<std::byte>> pooledBuffers;
+size_t pooledBytes = 0;
+
+} // namespace
+
+std::vector<std::byte> DownloadBufferPool::acquire(size_t minimumCapacity) {
+  std::vector<std::byte> result;
+
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (!pooledBuffers.empty()) {
+      // Use the smallest buffer that is large enough, or failing that, the
+      // largest one, which needs to grow the least.
+      auto it = std::min_element(
+          pooledBuffers.begin(),
+          pooledBuffers.end(),
+          [minimumCapacity](
+              const std::vector<std::byte>& a,
+              const std::vector<std::byte>& b) {
+            bool aFits = a.capacity() >= minimumCapacity;
+            bool bFits = b.capacity() >= minimumCapacity;
+            if (aFits != bFits) {
+              return aFits;
+            }
+            return aFits ? a.capacity() < b.capacity()
+                         : a.capacity() > b.capacity();
+          });
+
+      pooledBytes -= it->capacity();
+      std::swap(*it, pooledBuffers.back());
+      result = std::move(pooledBuffers.back());
+      pooledBuffers.pop_back();
+    }
+  }
+
+  result.reserve(minimumCapacity);
+  return result;
+}
+
+void DownloadBufferPool::release(std::vector<std::byte>&& buffer) noexcept {
+  size_t capacity = buffer.capacity();
+  if (capacity == 0) {
+    return;
+  }
+
+  buffer.clear();
+
+  std::lock_guard<std::mutex> lock(poolMutex);
+  if (pooledBuffers.size() >= maximumPooledBuffers ||
+      pooledBytes + capacity > maximumPooledBytes) {
+    // Let the buffer be freed.
+    return;
+  }
+
+  // Make room for every buffer the pool may hold the first time one is
+  // released, so that adding buffers never allocates and can't throw.
+  if (pooledBuffers.capacity() < maximumPooledBuffers) {
+    try {
+      pooledBuffers.reserve(maximumPooledBuffers);
+    } catch (...) {
+      return;
+    }
+  }
+
+  pooledBytes += capacity;
+  pooledBuffers.emplace_back(std::move(buffer));
+}
+
+} // namespace CesiumForUnityNative
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A thread-safe pool of buffers for downloaded response bodies.
+ *
+ * Tile responses are often several megabytes, so growing a fresh buffer for
+ * each one means repeated large allocations and copies. Buffers are instead
+ * returned here when the response that owns them is destroyed, and handed out
+ * again, with their capacity intact, for later downloads.
+ */
+class DownloadBufferPool {
+public:
+  /**
+   * @brief Gets an empty buffer, preferring a pooled one that can hold at
+   * least `minimumCapacity` bytes without reallocating.
+   */
+  static std::vector<std::byte> acquire(size_t minimumCapacity = 0);
+
+  /**
+   * @brief Returns a buffer to the pool so that its memory can be reused. The
+   * buffer is freed instead if the pool is already holding as much memory as
+   * it is allowed to.
+   */
+  static void release(std::vector<std::byte>&& buffer) noexcept;
+};
+
+} // namespace CesiumForUnityNative
@@ -1,5 +1,9 @@
 #include "NativeDownloadHandlerImpl.h"
 
+#include "DownloadBufferPool.h"
+
+#include <limits>
+
 using namespace DotNet::CesiumForUnity;
 
 namespace CesiumForUnityNative {
@@ -7,15 +11,41 @@ namespace CesiumForUnityNative {
 NativeDownloadHandlerImpl::NativeDownloadHandlerImpl(
     const NativeDownloadHandler& handler) {}
 
+NativeDownloadHandlerImpl::~NativeDownloadHandlerImpl() {
+  // This is empty if the data was moved into a response.
+  DownloadBufferPool::release(std::move(this->_data));
+}
+
 bool NativeDownloadHandlerImpl::ReceiveDataNative(
     const NativeDownloadHandler& handler,
     void* data,
     std::int32_t dataLength) {
+  if (this->_data.capacity() == 0) {
+    this->_data = DownloadBufferPool::acquire(size_t(dataLength));
+  }
+
   std::byte* p = static_cast<std::byte*>(data);
   this->_data.insert(this->_data.end(), p, p + dataLength);
   return true;
 }
 
+void NativeDownloadHandlerImpl::ReceiveContentLengthHeaderNative(
+    const NativeDownloadHandler& handler,
+    std::uint64_t contentLength) {
+  if (contentLength > std::numeric_limits<size_t>::max()) {
+    return;
+  }
+
+  // Size the buffer for the whole response up front, so that it doesn't need
+  // to be reallocated and copied as the data arrives.
+  size_t capacity = size_t(contentLength);
+  if (this->_data.capacity() == 0) {
+    this->_data = DownloadBufferPool::acquire(capacity);
+  } else {
+    this->_data.reserve(capacity);
+  }
+}
+
 const std::vector<std::byte>&
 NativeDownloadHandlerImpl::getData() const noexcept {
   return this->_data;
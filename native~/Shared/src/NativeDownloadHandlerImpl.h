@@ -16,10 +16,15 @@ class NativeDownloadHandlerImpl {
 public:
   NativeDownloadHandlerImpl(
       const ::DotNet::CesiumForUnity::NativeDownloadHandler& handler);
+  ~NativeDownloadHandlerImpl();
+
   bool ReceiveDataNative(
       const ::DotNet::CesiumForUnity::NativeDownloadHandler& handler,
       void* data,
       std::int32_t dataLength);
+  void ReceiveContentLengthHeaderNative(
+      const ::DotNet::CesiumForUnity::NativeDownloadHandler& handler,
+      std::uint64_t contentLength);
 
   const std::vector<std::byte>& getData() const noexcept;
   std::vector<std::byte>& getData() noexcept;
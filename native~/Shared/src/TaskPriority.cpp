@@ -0,0 +1,47 @@
+#include "TaskPriority.h"
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+thread_local std::optional<TaskPriority> currentPriority;
+
+} // namespace
+
+TaskPriorityScope::TaskPriorityScope(TaskPriority priority) noexcept
+    : _previous(currentPriority) {
+  currentPriority = priority;
+}
+
+TaskPriorityScope::~TaskPriorityScope() noexcept {
+  currentPriority = this->_previous;
+}
+
+std::optional<TaskPriority> TaskPriorityScope::getCurrent() noexcept {
+  return currentPriority;
+}
+
+PrioritizedTaskProcessor::PrioritizedTaskProcessor(
+    const std::shared_ptr<CesiumAsync::ITaskProcessor>& pProcessor,
+    TaskPriority priority)
+    : _pProcessor(pProcessor), _priority(priority) {}
+
+void PrioritizedTaskProcessor::startTask(std::function<void()> f) {
+  if (currentPriority) {
+    this->_pProcessor->startTask(std::move(f));
+    return;
+  }
+
+  TaskPriorityScope scope(this->_priority.load(std::memory_order_relaxed));
+  this->_pProcessor->startTask(std::move(f));
+}
+
+TaskPriority PrioritizedTaskProcessor::getPriority() const noexcept {
+  return this->_priority.load(std::memory_order_relaxed);
+}
+
+void PrioritizedTaskProcessor::setPriority(TaskPriority priority) noexcept {
+  this->_priority.store(priority, std::memory_order_relaxed);
+}
+
+} // namespace CesiumForUnityNative
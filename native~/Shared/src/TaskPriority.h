@@ -0,0 +1,109 @@
+#pragma once
+
+#include <CesiumAsync/ITaskProcessor.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief The classes of worker thread tasks, from the most to the least
+ * urgent. When there are more tasks than threads, tasks of a more urgent
+ * class run first.
+ */
+enum class TaskPriority : uint8_t {
+  /**
+   * @brief Loading tiles that are needed for what the cameras currently see.
+   */
+  Visible,
+
+  /**
+   * @brief Baking physics meshes for tiles that are already shown, which
+   * colliders near interest points are waiting on.
+   */
+  PhysicsBake,
+
+  /**
+   * @brief Loading tiles that aren't in view yet, but may be soon.
+   */
+  Prefetch,
+
+  /**
+   * @brief Filling the cache, such as when seeding it for later use.
+   */
+  Background
+};
+
+/**
+ * @brief The number of {@link TaskPriority} classes.
+ */
+constexpr size_t taskPriorityCount = 4;
+
+/**
+ * @brief Sets the priority of the tasks that are started by the current
+ * thread while this is in scope. Scopes can be nested.
+ *
+ * Task processors that don't support priorities ignore this.
+ */
+class TaskPriorityScope {
+public:
+  explicit TaskPriorityScope(TaskPriority priority) noexcept;
+  ~TaskPriorityScope() noexcept;
+
+  TaskPriorityScope(const TaskPriorityScope&) = delete;
+  TaskPriorityScope& operator=(const TaskPriorityScope&) = delete;
+
+  /**
+   * @brief Gets the priority set by the innermost scope on the current
+   * thread, if any.
+   */
+  static std::optional<TaskPriority> getCurrent() noexcept;
+
+private:
+  std::optional<TaskPriority> _previous;
+};
+
+/**
+ * @brief A task processor that starts every task on another processor with a
+ * priority that can be changed at any time.
+ *
+ * An {@link CesiumAsync::AsyncSystem} created with one of these starts all of
+ * its worker thread continuations with the same priority, even when they
+ * follow something that completed on another thread, such as a download. A
+ * {@link TaskPriorityScope} on the starting thread takes precedence.
+ */
+class PrioritizedTaskProcessor : public CesiumAsync::ITaskProcessor {
+public:
+  /**
+   * @brief Creates a new processor.
+   *
+   * @param pProcessor The processor to start tasks on.
+   * @param priority The priority to start tasks with.
+   */
+  PrioritizedTaskProcessor(
+      const std::shared_ptr<CesiumAsync::ITaskProcessor>& pProcessor,
+      TaskPriority priority);
+
+  virtual void startTask(std::function<void()> f) override;
+
+  /**
+   * @brief Gets the priority that tasks are started with.
+   */
+  TaskPriority getPriority() const noexcept;
+
+  /**
+   * @brief Sets the priority that tasks are started with from now on.
+   */
+  void setPriority(TaskPriority priority) noexcept;
+
+private:
+  std::shared_ptr<CesiumAsync::ITaskProcessor> _pProcessor;
+  std::atomic<TaskPriority> _priority;
+};
+
+} // namespace CesiumForUnityNative
@@ -1,6 +1,8 @@
 #include "UnityAssetAccessor.h"
 
+#include "AssetRequestCancellation.h"
 #include "Cesium.h"
+#include "DownloadBufferPool.h"
 
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumUtility/ScopeGuard.h>
@@ -59,6 +61,10 @@ public:
     }
   }
 
+  virtual ~UnityAssetResponse() {
+    DownloadBufferPool::release(std::move(this->_data));
+  }
+
   virtual uint16_t statusCode() const override { return _statusCode; }
 
   virtual std::string contentType() const override { return _contentType; }
@@ -102,6 +108,17 @@ private:
   UnityAssetResponse _response;
 };
 
+Future<std::shared_ptr<IAssetRequest>> createCancelledRequestFuture(
+    const AsyncSystem& asyncSystem,
+    const std::string& url) {
+  AssetRequestCancellation::recordCancelledRequest(0);
+  return asyncSystem.createFuture<std::shared_ptr<IAssetRequest>>(
+      [&url](const auto& promise) {
+        promise.reject(std::runtime_error(
+            "Request for " + url + " was cancelled before it was sent."));
+      });
+}
+
 std::string replaceInvalidChars(const std::string& input) {
   std::string result(input.size(), '?');
   std::transform(
@@ -116,7 +133,10 @@ std::string replaceInvalidChars(const std::string& input) {
 
 namespace CesiumForUnityNative {
 
-UnityAssetAccessor::UnityAssetAccessor() : _cesiumRequestHeaders() {
+UnityAssetAccessor::UnityAssetAccessor()
+    : _cesiumRequestHeaders(),
+      _pInFlightRequests(std::make_shared<InFlightRequests>()),
+      _cancellationListenerID(0) {
   std::string version = CesiumForUnityNative::Cesium::version + " " +
                         CesiumForUnityNative::Cesium::commit;
   std::string projectName = replaceInvalidChars(
@@ -133,6 +153,15 @@ UnityAssetAccessor::UnityAssetAccessor() : _cesiumRequestHeaders() {
   this->_cesiumRequestHeaders.insert({"X-Cesium-Client-Project", projectName});
   this->_cesiumRequestHeaders.insert({"X-Cesium-Client-Engine", engine});
   this->_cesiumRequestHeaders.insert({"X-Cesium-Client-OS", osVersion});
+
+  this->_cancellationListenerID = AssetRequestCancellation::addListener(
+      [pInFlightRequests = this->_pInFlightRequests](uint64_t group) {
+        pInFlightRequests->cancelGroup(group);
+      });
+}
+
+UnityAssetAccessor::~UnityAssetAccessor() noexcept {
+  AssetRequestCancellation::removeListener(this->_cancellationListenerID);
 }
 
 CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
@@ -140,23 +169,29 @@ UnityAssetAccessor::get(
     const CesiumAsync::AsyncSystem& asyncSystem,
     const std::string& url,
     const std::vector<THeader>& headers) {
+  HttpHeaders requestHeaders = this->_cesiumRequestHeaders;
+  for (const auto& header : headers) {
+    requestHeaders.insert(header);
+  }
 
   // Sadly, Unity requires us to call this from the main thread.
   return asyncSystem.runInMainThread([asyncSystem,
                                       url,
-                                      headers,
-                                      &cesiumRequestHeaders =
-                                          this->_cesiumRequestHeaders]() {
+                                      requestHeaders =
+                                          std::move(requestHeaders),
+                                      pInFlightRequests =
+                                          this->_pInFlightRequests]() mutable {
+    uint64_t group = AssetRequestCancellation::takeGroup(requestHeaders);
+    if (AssetRequestCancellation::isCancelled(group)) {
+      return createCancelledRequestFuture(asyncSystem, url);
+    }
+
     UnityEngine::Networking::UnityWebRequest request =
         UnityEngine::Networking::UnityWebRequest::Get(System::String(url));
 
     DotNet::CesiumForUnity::NativeDownloadHandler handler{};
     request.downloadHandler(handler);
 
-    HttpHeaders requestHeaders = cesiumRequestHeaders;
-    for (const auto& header : headers) {
-      requestHeaders.insert(header);
-    }
     for (const auto& header : requestHeaders) {
       request.SetRequestHeader(
           System::String(header.first),
@@ -171,13 +206,17 @@ UnityAssetAccessor::get(
 
     UnityEngine::Networking::UnityWebRequestAsyncOperation op =
         request.SendWebRequest();
+    uint64_t requestID = pInFlightRequests->track(group, request);
     op.add_completed(System::Action1<UnityEngine::AsyncOperation>(
         [request,
+         pInFlightRequests,
+         requestID,
          headers = std::move(requestHeaders),
          promise = std::move(promise),
          handler = std::move(handler)](
             const UnityEngine::AsyncOperation& operation) mutable {
           ScopeGuard disposeHandler{[&handler]() { handler.Dispose(); }};
+          pInFlightRequests->untrack(requestID);
           if (request.isDone() &&
               request.result() !=
                   UnityEngine::Networking::Result::ConnectionError) {
@@ -209,6 +248,16 @@ UnityAssetAccessor::request(
             nullptr);
   }
 
+  HttpHeaders requestHeaders = this->_cesiumRequestHeaders;
+  for (const auto& header : headers) {
+    requestHeaders.insert(header);
+  }
+
+  uint64_t group = AssetRequestCancellation::takeGroup(requestHeaders);
+  if (AssetRequestCancellation::isCancelled(group)) {
+    return createCancelledRequestFuture(asyncSystem, url);
+  }
+
   Unity::Collections::NativeArray1<std::uint8_t> payloadBytes(
       std::int32_t(contentPayload.size()),
       Unity::Collections::Allocator::Persistent,
@@ -222,10 +271,12 @@ UnityAssetAccessor::request(
   return asyncSystem.runInMainThread([asyncSystem,
                                       url,
                                       verb,
-                                      headers,
+                                      requestHeaders =
+                                          std::move(requestHeaders),
+                                      group,
                                       payloadBytes,
-                                      &cesiumRequestHeaders =
-                                          this->_cesiumRequestHeaders]() {
+                                      pInFlightRequests =
+                                          this->_pInFlightRequests]() mutable {
     DotNet::CesiumForUnity::NativeDownloadHandler downloadHandler{};
     UnityEngine::Networking::UploadHandlerRaw uploadHandler(payloadBytes, true);
     UnityEngine::Networking::UnityWebRequest request(
@@ -234,11 +285,6 @@ UnityAssetAccessor::request(
         downloadHandler,
         uploadHandler);
 
-    HttpHeaders requestHeaders = cesiumRequestHeaders;
-    for (const auto& header : headers) {
-      requestHeaders.insert(header);
-    }
-
     for (const auto& header : requestHeaders) {
       request.SetRequestHeader(
           System::String(header.first),
@@ -253,13 +299,17 @@ UnityAssetAccessor::request(
 
     UnityEngine::Networking::UnityWebRequestAsyncOperation op =
         request.SendWebRequest();
+    uint64_t requestID = pInFlightRequests->track(group, request);
     op.add_completed(System::Action1<UnityEngine::AsyncOperation>(
         [request,
+         pInFlightRequests,
+         requestID,
          headers = std::move(requestHeaders),
          promise = std::move(promise),
          handler = std::move(downloadHandler)](
             const UnityEngine::AsyncOperation& operation) mutable {
           ScopeGuard disposeHandler{[&handler]() { handler.Dispose(); }};
+          pInFlightRequests->untrack(requestID);
           if (request.isDone() &&
               request.result() !=
                   UnityEngine::Networking::Result::ConnectionError) {
@@ -277,4 +327,42 @@ UnityAssetAccessor::request(
 
 void UnityAssetAccessor::tick() noexcept {}
 
+uint64_t UnityAssetAccessor::InFlightRequests::track(
+    uint64_t group,
+    const UnityEngine::Networking::UnityWebRequest& request) {
+  if (group == 0) {
+    return 0;
+  }
+
+  uint64_t requestID = this->_nextRequestID++;
+  this->_requests.emplace(requestID, InFlightRequest{group, request});
+  return requestID;
+}
+
+void UnityAssetAccessor::InFlightRequests::untrack(uint64_t requestID) {
+  if (requestID != 0) {
+    this->_requests.erase(requestID);
+  }
+}
+
+void UnityAssetAccessor::InFlightRequests::cancelGroup(uint64_t group) {
+  // Collect the requests first, because aborting one may complete it, and
+  // untrack it, immediately.
+  std::vector<UnityEngine::Networking::UnityWebRequest> requestsToAbort;
+  for (auto it = this->_requests.begin(); it != this->_requests.end();) {
+    if (it->second.group == group) {
+      requestsToAbort.emplace_back(std::move(it->second.request));
+      it = this->_requests.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  for (UnityEngine::Networking::UnityWebRequest& request : requestsToAbort) {
+    AssetRequestCancellation::recordCancelledRequest(
+        request.downloadedBytes());
+    request.Abort();
+  }
+}
+
 } // namespace CesiumForUnityNative
@@ -2,11 +2,18 @@
 
 #include <CesiumAsync/IAssetAccessor.h>
 
+#include <DotNet/UnityEngine/Networking/UnityWebRequest.h>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
 namespace CesiumForUnityNative {
 
 class UnityAssetAccessor : public CesiumAsync::IAssetAccessor {
 public:
   UnityAssetAccessor();
+  virtual ~UnityAssetAccessor() noexcept;
 
   virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
   get(const CesiumAsync::AsyncSystem& asyncSystem,
@@ -23,8 +30,44 @@ public:
 
   virtual void tick() noexcept override;
 
+  /**
+   * @brief Gets the headers that identify Cesium for Unity, which are added to
+   * every request.
+   */
+  const CesiumAsync::HttpHeaders& getCesiumRequestHeaders() const noexcept {
+    return this->_cesiumRequestHeaders;
+  }
+
 private:
+  /**
+   * @brief The requests that are in flight, so that they can be aborted when
+   * their group is cancelled. Only accessed from the main thread.
+   *
+   * This is shared with the requests' completion callbacks, rather than being
+   * part of the accessor, because a request may complete after the accessor
+   * that sent it is destroyed.
+   */
+  class InFlightRequests {
+  public:
+    uint64_t track(
+        uint64_t group,
+        const DotNet::UnityEngine::Networking::UnityWebRequest& request);
+    void untrack(uint64_t requestID);
+    void cancelGroup(uint64_t group);
+
+  private:
+    struct InFlightRequest {
+      uint64_t group;
+      DotNet::UnityEngine::Networking::UnityWebRequest request;
+    };
+
+    std::unordered_map<uint64_t, InFlightRequest> _requests;
+    uint64_t _nextRequestID = 1;
+  };
+
   CesiumAsync::HttpHeaders _cesiumRequestHeaders;
+  std::shared_ptr<InFlightRequests> _pInFlightRequests;
+  int32_t _cancellationListenerID;
 };
 
 } // namespace CesiumForUnityNative
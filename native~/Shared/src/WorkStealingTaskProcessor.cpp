@@ -0,0 +1,308 @@
+#include "WorkStealingTaskProcessor.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace CesiumForUnityNative {
+
+namespace {
+
+// The processor that the current thread works for, if any, the index of its
+// queue, and the priority of the task it is running.
+thread_local const WorkStealingTaskProcessor* pCurrentProcessor = nullptr;
+thread_local uint32_t currentQueue = 0;
+thread_local TaskPriority runningPriority = TaskPriority::Visible;
+
+void pinCurrentThread(uint32_t core) {
+#ifdef _WIN32
+  if (core < 64) {
+    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core);
+  }
+#elif defined(__linux__)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(core, &cpus);
+  sched_setaffinity(0, sizeof(cpus), &cpus);
+#else
+  (void)core;
+#endif
+}
+
+void runTask(const std::function<void()>& f) {
+  try {
+    f();
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(
+        spdlog::default_logger(),
+        "Unhandled exception in a worker thread task: {}",
+        e.what());
+  } catch (...) {
+    SPDLOG_LOGGER_ERROR(
+        spdlog::default_logger(),
+        "Unhandled exception in a worker thread task");
+  }
+}
+
+} // namespace
+
+WorkStealingTaskProcessor::WorkStealingTaskProcessor(
+    uint32_t threadCount,
+    bool pinThreads)
+    : _queues(),
+      _priorityCounters(),
+      _nextQueue(0),
+      _sleepMutex(),
+      _tasksAvailable(),
+      _queuedTasks(0),
+      _sleepingThreads(0),
+      _stopping(false),
+      _stopped(false),
+      _threads() {
+  if (threadCount == 0) {
+    uint32_t hardwareThreads = std::thread::hardware_concurrency();
+    threadCount = std::max(hardwareThreads, uint32_t(2)) - 1;
+  }
+
+  this->_queues.reserve(threadCount);
+  for (uint32_t i = 0; i < threadCount; ++i) {
+    this->_queues.emplace_back(std::make_unique<Queue>());
+  }
+
+  this->_threads.reserve(threadCount);
+  for (uint32_t i = 0; i < threadCount; ++i) {
+    this->_threads.emplace_back(
+        [this, i, pinThreads]() { this->runTasks(i, pinThreads); });
+  }
+}
+
+WorkStealingTaskProcessor::~WorkStealingTaskProcessor() noexcept {
+  this->shutdown();
+}
+
+void WorkStealingTaskProcessor::shutdown() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(this->_sleepMutex);
+    if (this->_stopping) {
+      return;
+    }
+    this->_stopping = true;
+  }
+
+  // The threads finish the tasks that are already queued before they stop.
+  this->_tasksAvailable.notify_all();
+  for (std::thread& thread : this->_threads) {
+    thread.join();
+  }
+
+  this->_stopped = true;
+
+  // Run any tasks that were queued by other threads while the last worker
+  // thread was stopping. Tasks started from here on are run where they're
+  // started.
+  std::vector<QueuedTask> leftovers;
+  for (const std::unique_ptr<Queue>& pQueue : this->_queues) {
+    {
+      std::lock_guard<std::mutex> lock(pQueue->mutex);
+      for (std::deque<QueuedTask>& tasks : pQueue->tasks) {
+        std::move(tasks.begin(), tasks.end(), std::back_inserter(leftovers));
+        tasks.clear();
+      }
+    }
+
+    for (QueuedTask& task : leftovers) {
+      runTask(task.f);
+    }
+    leftovers.clear();
+  }
+}
+
+void WorkStealingTaskProcessor::startTask(std::function<void()> f) {
+  uint32_t index;
+  TaskPriority priority;
+  if (pCurrentProcessor == this) {
+    index = currentQueue;
+    priority = runningPriority;
+  } else {
+    index = this->_nextQueue.fetch_add(1, std::memory_order_relaxed) %
+            uint32_t(this->_queues.size());
+    priority = TaskPriority::Visible;
+  }
+  priority = TaskPriorityScope::getCurrent().value_or(priority);
+
+  Queue& queue = *this->_queues[index];
+  bool queued = false;
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!this->_stopped) {
+      queue.tasks[size_t(priority)].emplace_back(
+          QueuedTask{std::move(f), Clock::now()});
+      queued = true;
+    }
+  }
+
+  if (!queued) {
+    // The processor has been shut down, so there's no thread to run it.
+    runTask(f);
+    return;
+  }
+
+  queue.submitted.fetch_add(1, std::memory_order_relaxed);
+
+  // A thread that is going to sleep either sees the new count before it does,
+  // or is seen here and woken up. Taking the lock makes sure that it's already
+  // waiting for the notification.
+  this->_queuedTasks.fetch_add(1, std::memory_order_seq_cst);
+  if (this->_sleepingThreads.load(std::memory_order_seq_cst) > 0) {
+    {
+      std::lock_guard<std::mutex> lock(this->_sleepMutex);
+    }
+    this->_tasksAvailable.notify_one();
+  }
+}
+
+uint32_t WorkStealingTaskProcessor::getThreadCount() const noexcept {
+  return uint32_t(this->_threads.size());
+}
+
+std::vector<WorkStealingTaskProcessor::QueueStatistics>
+WorkStealingTaskProcessor::getStatistics() const {
+  std::vector<QueueStatistics> result;
+  result.reserve(this->_queues.size());
+  for (const std::unique_ptr<Queue>& pQueue : this->_queues) {
+    result.emplace_back(QueueStatistics{
+        pQueue->submitted.load(std::memory_order_relaxed),
+        pQueue->executed.load(std::memory_order_relaxed),
+        pQueue->stolen.load(std::memory_order_relaxed)});
+  }
+  return result;
+}
+
+std::array<WorkStealingTaskProcessor::PriorityStatistics, taskPriorityCount>
+WorkStealingTaskProcessor::getPriorityStatistics() const {
+  std::array<PriorityStatistics, taskPriorityCount> result;
+  for (size_t i = 0; i < taskPriorityCount; ++i) {
+    const PriorityCounters& counters = this->_priorityCounters[i];
+    Clock::duration wait(counters.waitTicks.load(std::memory_order_relaxed));
+    result[i] = PriorityStatistics{
+        counters.executed.load(std::memory_order_relaxed),
+        std::chrono::duration<double>(wait).count()};
+  }
+  return result;
+}
+
+void WorkStealingTaskProcessor::runTasks(uint32_t index, bool pinThread) {
+  pCurrentProcessor = this;
+  currentQueue = index;
+
+  if (pinThread) {
+    uint32_t cores = std::max(std::thread::hardware_concurrency(), 1U);
+    // Leave the first core to the main thread where there are enough.
+    uint32_t firstCore = cores > this->_queues.size() ? 1 : 0;
+    pinCurrentThread((firstCore + index) % cores);
+  }
+
+  Queue& queue = *this->_queues[index];
+  QueuedTask task;
+
+  while (true) {
+    // Run the most urgent task, wherever it is.
+    bool found = false;
+    size_t priority = 0;
+    for (; priority < taskPriorityCount; ++priority) {
+      if (this->popTask(index, priority, task) ||
+          this->stealTask(index, priority, task)) {
+        found = true;
+        break;
+      }
+    }
+
+    if (found) {
+      queue.executed.fetch_add(1, std::memory_order_relaxed);
+      PriorityCounters& counters = this->_priorityCounters[priority];
+      counters.executed.fetch_add(1, std::memory_order_relaxed);
+      counters.waitTicks.fetch_add(
+          (Clock::now() - task.queued).count(),
+          std::memory_order_relaxed);
+
+      runningPriority = TaskPriority(priority);
+      runTask(task.f);
+      task.f = nullptr;
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(this->_sleepMutex);
+    this->_sleepingThreads.fetch_add(1, std::memory_order_seq_cst);
+    this->_tasksAvailable.wait(lock, [this]() {
+      return this->_stopping || this->_queuedTasks.load() > 0;
+    });
+    this->_sleepingThreads.fetch_sub(1, std::memory_order_seq_cst);
+    if (this->_stopping && this->_queuedTasks.load() <= 0) {
+      return;
+    }
+  }
+}
+
+bool WorkStealingTaskProcessor::popTask(
+    uint32_t index,
+    size_t priority,
+    QueuedTask& task) {
+  Queue& queue = *this->_queues[index];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    std::deque<QueuedTask>& tasks = queue.tasks[priority];
+    if (tasks.empty()) {
+      return false;
+    }
+
+    // The newest task is the most likely to find its data still in the cache.
+    task = std::move(tasks.back());
+    tasks.pop_back();
+  }
+
+  this->_queuedTasks.fetch_sub(1, std::memory_order_seq_cst);
+  return true;
+}
+
+bool WorkStealingTaskProcessor::stealTask(
+    uint32_t thief,
+    size_t priority,
+    QueuedTask& task) {
+  uint32_t count = uint32_t(this->_queues.size());
+  for (uint32_t i = 1; i < count; ++i) {
+    Queue& victim = *this->_queues[(thief + i) % count];
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      std::deque<QueuedTask>& tasks = victim.tasks[priority];
+      if (tasks.empty()) {
+        continue;
+      }
+
+      // Take the oldest task, which its owner would get to last.
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    victim.stolen.fetch_add(1, std::memory_order_relaxed);
+
+    this->_queuedTasks.fetch_sub(1, std::memory_order_seq_cst);
+    return true;
+  }
+
+  return false;
+}
+
+} // namespace CesiumForUnityNative
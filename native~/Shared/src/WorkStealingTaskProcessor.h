@@ -0,0 +1,169 @@
+#pragma once
+
+#include "TaskPriority.h"
+
+#include <CesiumAsync/ITaskProcessor.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CesiumForUnityNative {
+
+/**
+ * @brief A task processor that runs tasks on its own pool of native threads,
+ * rather than on the .NET thread pool.
+ *
+ * Each thread has its own queue. Tasks started by a worker thread, such as the
+ * continuations of the task it is running, go on that thread's queue and are
+ * run most recent first, while their data is still in its cache. Tasks started
+ * by any other thread are spread across the queues in turn. A thread whose
+ * queue is empty steals the oldest task from another thread's queue before it
+ * goes to sleep.
+ *
+ * Each queue holds tasks of every {@link TaskPriority} class separately. A
+ * thread looks for a task of the most urgent class on its own queue and then
+ * on the others, before looking for one of the next class. A task's class is
+ * set by a {@link TaskPriorityScope} on the thread that starts it, and
+ * otherwise is the class of the task that the thread is running, or
+ * {@link TaskPriority::Visible}.
+ *
+ * This is experimental, and is only used when `useNativeTaskProcessor` is
+ * enabled in the runtime settings. It hasn't yet been measured against the
+ * .NET thread pool that is used otherwise.
+ */
+class WorkStealingTaskProcessor : public CesiumAsync::ITaskProcessor {
+public:
+  /**
+   * @brief Counts of the tasks that went through one thread's queue.
+   */
+  struct QueueStatistics {
+    /**
+     * @brief The number of tasks that were put on the queue.
+     */
+    uint64_t submitted;
+
+    /**
+     * @brief The number of tasks that the queue's own thread ran, including
+     * ones it stole from other queues.
+     */
+    uint64_t executed;
+
+    /**
+     * @brief The number of tasks on the queue that other threads stole.
+     */
+    uint64_t stolen;
+  };
+
+  /**
+   * @brief Counts of the tasks of one priority class.
+   */
+  struct PriorityStatistics {
+    /**
+     * @brief The number of tasks that have been run.
+     */
+    uint64_t executed;
+
+    /**
+     * @brief The total time that those tasks spent queued before they ran, in
+     * seconds.
+     */
+    double waitSeconds;
+  };
+
+  /**
+   * @brief Creates a new processor and starts its threads.
+   *
+   * @param threadCount The number of threads. If 0, one fewer than the number
+   * of hardware threads is used, leaving one for the main thread.
+   * @param pinThreads Whether to pin each thread to its own core, which keeps
+   * the operating system from moving it and losing its cache. This is only
+   * supported on Windows, Linux and Android, and is ignored elsewhere.
+   */
+  WorkStealingTaskProcessor(uint32_t threadCount, bool pinThreads);
+  virtual ~WorkStealingTaskProcessor() noexcept;
+
+  virtual void startTask(std::function<void()> f) override;
+
+  /**
+   * @brief Runs the tasks that are already queued and stops the threads.
+   *
+   * Tasks that are started afterwards are run immediately on the thread that
+   * starts them. This is called by the destructor, and may be called earlier
+   * so that the threads are gone before the native code is unloaded or the
+   * .NET domain is reloaded.
+   */
+  void shutdown() noexcept;
+
+  /**
+   * @brief Gets the number of threads that run tasks.
+   */
+  uint32_t getThreadCount() const noexcept;
+
+  /**
+   * @brief Gets the statistics of each thread's queue, in thread order.
+   */
+  std::vector<QueueStatistics> getStatistics() const;
+
+  /**
+   * @brief Gets the statistics of each priority class, indexed by
+   * {@link TaskPriority}.
+   */
+  std::array<PriorityStatistics, taskPriorityCount>
+  getPriorityStatistics() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct QueuedTask {
+    std::function<void()> f;
+    Clock::time_point queued;
+  };
+
+  struct Queue {
+    std::mutex mutex;
+    std::array<std::deque<QueuedTask>, taskPriorityCount> tasks;
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> executed{0};
+    std::atomic<uint64_t> stolen{0};
+  };
+
+  struct PriorityCounters {
+    std::atomic<uint64_t> executed{0};
+    // In steady clock ticks.
+    std::atomic<int64_t> waitTicks{0};
+  };
+
+  void runTasks(uint32_t index, bool pinThread);
+  bool popTask(uint32_t index, size_t priority, QueuedTask& task);
+  bool stealTask(uint32_t thief, size_t priority, QueuedTask& task);
+
+  std::vector<std::unique_ptr<Queue>> _queues;
+  std::array<PriorityCounters, taskPriorityCount> _priorityCounters;
+  std::atomic<uint32_t> _nextQueue;
+
+  std::mutex _sleepMutex;
+  std::condition_variable _tasksAvailable;
+  // The number of tasks that have been queued but not yet taken off a queue.
+  // It can briefly be negative when a task is taken before it is counted.
+  std::atomic<int64_t> _queuedTasks;
+  // The number of threads waiting for tasks, which only need to be notified
+  // of new tasks if there are any.
+  std::atomic<uint32_t> _sleepingThreads;
+  bool _stopping;
+  // Set once the threads have stopped. It's read with a queue's mutex held,
+  // so that no task is queued after the queue has been emptied for good.
+  std::atomic<bool> _stopped;
+
+  std::vector<std::thread> _threads;
+};
+
+} // namespace CesiumForUnityNative